@@ -240,7 +240,7 @@ for arg in sys.argv[1:]:
         VERIFY = True
         continue
     print('Checking ' + arg + '...')
-    data = cppcheckdata.parsedump(arg)
+    data = cppcheckdata.parsedump(arg, streaming=True)
 
     if VERIFY:
         VERIFY_ACTUAL = []
@@ -251,8 +251,10 @@ for arg in sys.argv[1:]:
                     if re.match(r'cert-[A-Z][A-Z][A-Z][0-9][0-9].*',word):
                         VERIFY_EXPECTED.append(str(tok.linenr) + ':' + word)
 
-    for cfg in data.configurations:
-        if len(data.configurations) > 1:
+    cfgNumber = 0
+    for cfg in data.iterconfigurations():
+        cfgNumber = cfgNumber + 1
+        if cfgNumber > 1 or cfg.name:
             print('Checking ' + arg + ', config "' + cfg.name + '"...')
         exp05(cfg)
         exp42(cfg)
@@ -8,9 +8,98 @@ License: No restrictions, use this as you need.
 
 import xml.etree.ElementTree as ET
 import argparse
+import struct
+import sys
 from fnmatch import fnmatch
 
 
+BINARY_DUMP_MAGIC = b'CPPCHECK-DUMP 1\n'
+
+
+def isbinarydump(filename):
+    """
+    Is the file a binary dump (cppcheck --dump-format=binary)?
+    """
+    with open(filename, 'rb') as f:
+        return f.read(len(BINARY_DUMP_MAGIC)) == BINARY_DUMP_MAGIC
+
+
+def iterbinarydump(source, chunkSize=1 << 20):
+    """
+    Read a binary dump incrementally, like ElementTree.iterparse().
+    The source is a file name or a binary file object.
+    Yields ('start', element) when an element and its attributes have
+    been read and ('end', element) when its children have been read.
+    The elements are ElementTree elements, they are added to their
+    parent element when they are read. Call clear() on elements that
+    are no longer needed to free them.
+
+    The file is a sequence of records, each one is a 32-bit little
+    endian length followed by the fields of the record, separated by
+    '\\0'. See BinaryDumpWriter in lib/dumpwriter.h.
+    """
+    header = struct.Struct('<I')
+    shapes = []
+    stack = []
+    if hasattr(source, 'read'):
+        f = source
+        filename = getattr(source, 'name', '<dump>')
+    else:
+        f = open(source, 'rb')
+        filename = source
+    try:
+        if f.read(len(BINARY_DUMP_MAGIC)) != BINARY_DUMP_MAGIC:
+            raise ValueError(filename + ': not a binary cppcheck dump')
+        buf = b''
+        pos = 0
+        while True:
+            chunk = f.read(chunkSize)
+            if not chunk:
+                break
+            buf = buf[pos:] + chunk
+            pos = 0
+            end = len(buf)
+            while pos + 4 <= end:
+                length = header.unpack_from(buf, pos)[0]
+                if pos + 4 + length > end:
+                    break
+                fields = buf[pos + 4:pos + 4 + length].decode('ascii', 'replace').split('\0')
+                pos += 4 + length
+                kind = fields[0]
+                if kind == 'X':
+                    yield 'end', stack.pop()
+                    continue
+                if kind[0] == 'T':
+                    shapes.append((fields[1], fields[2:]))
+                    continue
+                tag, names = shapes[int(kind[1:])]
+                if stack:
+                    element = ET.SubElement(stack[-1], tag, dict(zip(names, fields[1:])))
+                else:
+                    element = ET.Element(tag, dict(zip(names, fields[1:])))
+                yield 'start', element
+                if kind[0] == 'E':
+                    stack.append(element)
+                else:
+                    yield 'end', element
+        if pos != len(buf) or stack:
+            raise ValueError(filename + ': truncated binary cppcheck dump')
+    finally:
+        if f is not source:
+            f.close()
+
+
+def parsebinarydump(source):
+    """
+    Read a binary dump and return its root element
+    """
+    root = None
+    for event, element in iterbinarydump(source):
+        if root is None:
+            root = element
+    return root
+
+
 class Directive:
     """
     Directive class. Contains information about each preprocessor directive in the source code.
@@ -656,7 +745,7 @@ class CppcheckData:
     Contains a list of Configuration instances
 
     Attributes:
-        configurations    List of Configurations
+        configurations    List of Configurations, empty in streaming mode
 
     To iterate through all configurations use such code:
     @code
@@ -684,6 +773,14 @@ class CppcheckData:
         for scope in cfg.scopes:
             print('    type:' + scope.type + ' name:' + scope.className)
     @endcode
+
+    In streaming mode the configurations are read one at a time, only
+    one of them is in memory at once:
+    @code
+    data = cppcheckdata.parsedump(..., streaming=True)
+    for cfg in data.iterconfigurations():
+        print('cfg: ' + cfg.name)
+    @endcode
     """
 
     rawTokens = []
@@ -691,48 +788,90 @@ class CppcheckData:
     configurations = []
     suppressions = []
 
-    def __init__(self, filename):
+    def __init__(self, filename, streaming=False):
+        self.rawTokens = []
         self.configurations = []
-
-        data = ET.parse(filename)
-
-        for platformNode in data.getroot():
-            if platformNode.tag == 'platform':
-                self.platform = Platform(platformNode)
-
-        for rawTokensNode in data.getroot():
-            if rawTokensNode.tag != 'rawtokens':
-                continue
-            files = []
-            for node in rawTokensNode:
-                if node.tag == 'file':
-                    files.append(node.get('name'))
-                elif node.tag == 'tok':
-                    tok = Token(node)
-                    tok.file = files[int(node.get('fileIndex'))]
-                    self.rawTokens.append(tok)
-            for i in range(len(self.rawTokens) - 1):
-                self.rawTokens[i + 1].previous = self.rawTokens[i]
-                self.rawTokens[i].next = self.rawTokens[i + 1]
-
-
-        for suppressionsNode in data.getroot():
-            if suppressionsNode.tag == "suppressions":
-                for suppression in suppressionsNode:
+        self.suppressions = []
+
+        # The dump is read in one pass. The platform, raw tokens and
+        # suppressions come before the configurations.
+        if filename == '-':
+            # cppcheck --addon passes a binary dump through stdin
+            self._events = iterbinarydump(getattr(sys.stdin, 'buffer', sys.stdin))
+        elif isbinarydump(filename):
+            self._events = iterbinarydump(filename)
+        else:
+            self._events = ET.iterparse(filename, events=('start', 'end'))
+        self._root = None
+        self._depth = 0
+        self._nextConfiguration = None
+        for node in self._toplevel():
+            if node.tag == 'platform':
+                self.platform = Platform(node)
+            elif node.tag == 'rawtokens':
+                files = []
+                for child in node:
+                    if child.tag == 'file':
+                        files.append(child.get('name'))
+                    elif child.tag == 'tok':
+                        tok = Token(child)
+                        tok.file = files[int(child.get('fileIndex'))]
+                        self.rawTokens.append(tok)
+                for i in range(len(self.rawTokens) - 1):
+                    self.rawTokens[i + 1].previous = self.rawTokens[i]
+                    self.rawTokens[i].next = self.rawTokens[i + 1]
+            elif node.tag == 'suppressions':
+                for suppression in node:
                     self.suppressions.append(Suppression(suppression))
+            elif node.tag == 'dump':
+                self._nextConfiguration = node
+                break
+            self._root.clear()
 
+        if not streaming:
+            self.configurations = list(self.iterconfigurations())
 
-        # root is 'dumps' node, each config has its own 'dump' subnode.
-        for cfgnode in data.getroot():
-            if cfgnode.tag == 'dump':
-                self.configurations.append(Configuration(cfgnode))
-
-
-def parsedump(filename):
-    """
-    parse a cppcheck dump file
-    """
-    return CppcheckData(filename)
+    def _toplevel(self):
+        """
+        Yield the child elements of the root element when they have been read
+        """
+        for event, element in self._events:
+            if event == 'start':
+                if self._root is None:
+                    self._root = element
+                self._depth += 1
+            else:
+                self._depth -= 1
+                if self._depth == 1:
+                    yield element
+
+    def iterconfigurations(self):
+        """
+        Yield the configurations, they are read from the dump one at a time.
+        This can only be done once.
+        """
+        node = self._nextConfiguration
+        self._nextConfiguration = None
+        while node is not None:
+            cfg = Configuration(node)
+            # root is 'dumps' node, each config has its own 'dump' subnode.
+            # Free the elements, only the Configuration is kept.
+            self._root.clear()
+            yield cfg
+            node = None
+            for element in self._toplevel():
+                if element.tag == 'dump':
+                    node = element
+                    break
+                self._root.clear()
+
+
+def parsedump(filename, streaming=False):
+    """
+    parse a cppcheck dump file, "-" reads the dump from stdin (cppcheck --addon)
+    In streaming mode, use iterconfigurations() to read the configurations.
+    """
+    return CppcheckData(filename, streaming)
 
 
 def astIsFloat(token):
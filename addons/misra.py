@@ -1978,7 +1978,7 @@ class MisraChecker:
 
     def parseDump(self, dumpfile):
 
-        data = cppcheckdata.parsedump(dumpfile)
+        data = cppcheckdata.parsedump(dumpfile, streaming=True)
 
         self.dumpfileSuppressions = data.suppressions
         self.parseSuppressions()
@@ -2002,9 +2002,9 @@ class MisraChecker:
 
         cfgNumber = 0
 
-        for cfg in data.configurations:
+        for cfg in data.iterconfigurations():
             cfgNumber = cfgNumber + 1
-            if len(data.configurations) > 1:
+            if cfgNumber > 1 or cfg.name:
                 printStatus('Checking ' + dumpfile + ', config "' + cfg.name + '"...')
 
             if cfgNumber == 1:
@@ -32,7 +32,7 @@ def reportError(token, severity, msg):
         '[' + token.file + ':' + str(token.linenr) + '] (' + severity + ') naming.py: ' + msg + '\n')
 
 for arg in sys.argv[1:]:
-    if not arg[-5:] == '.dump':
+    if not arg[-5:] == '.dump' and arg != '-':
         continue
     print('Checking ' + arg + '...')
     data = cppcheckdata.parsedump(arg)
@@ -39,6 +39,11 @@
 #include <list>
 #include <set>
 
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
 #ifdef HAVE_RULES
 // xml is used for rules
 #include <tinyxml2.h>
@@ -115,11 +120,57 @@ void CmdLineParser::printMessage(const char* message)
     std::cout << message << std::endl;
 }
 
+/** Default directory for the .cfg cache, it is created if needed. Empty if there is no suitable directory. */
+static std::string getDefaultCfgCacheDirectory()
+{
+#ifdef _WIN32
+    const char *base = std::getenv("LOCALAPPDATA");
+    if (!base || !*base)
+        return "";
+    std::string dir = Path::fromNativeSeparators(base) + "/cppcheck";
+#else
+    std::string dir;
+    const char *xdg = std::getenv("XDG_CACHE_HOME");
+    const char *home = std::getenv("HOME");
+    if (xdg && *xdg)
+        dir = std::string(xdg) + "/cppcheck";
+    else if (home && *home)
+        dir = std::string(home) + "/.cache/cppcheck";
+    else
+        return "";
+#endif
+
+    // create all missing parent directories
+    for (std::string::size_type pos = dir.find('/', 1); ; pos = dir.find('/', pos + 1)) {
+        const std::string parent = dir.substr(0, pos);
+#ifdef _WIN32
+        _mkdir(parent.c_str());
+#else
+        mkdir(parent.c_str(), 0755);
+#endif
+        if (pos == std::string::npos)
+            break;
+    }
+
+    struct stat st;
+    if (stat(dir.c_str(), &st) != 0 || (st.st_mode & S_IFDIR) == 0)
+        return "";
+    return dir;
+}
+
 bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
 {
     bool def = false;
     bool maxconfigs = false;
 
+    // the cache directory must be known before any --library is loaded
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--cfg-cache") == 0)
+            mSettings->library.setCacheDirectory(getDefaultCfgCacheDirectory());
+        else if (std::strncmp(argv[i], "--cfg-cache-dir=", 16) == 0)
+            mSettings->library.setCacheDirectory(Path::fromNativeSeparators(argv[i] + 16));
+    }
+
     for (int i = 1; i < argc; i++) {
         if (argv[i][0] == '-') {
             if (std::strcmp(argv[i], "--version") == 0) {
@@ -128,6 +179,10 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
                 return true;
             }
 
+            else if (std::strcmp(argv[i], "--cfg-cache") == 0 || std::strncmp(argv[i], "--cfg-cache-dir=", 16) == 0) {
+                // handled before the other options
+            }
+
             else if (std::strncmp(argv[i], "--cppcheck-build-dir=", 21) == 0) {
                 mSettings->buildDir = Path::fromNativeSeparators(argv[i] + 21);
                 if (endsWith(mSettings->buildDir, '/'))
@@ -147,9 +202,37 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
             else if (std::strcmp(argv[i], "--debug-warnings") == 0)
                 mSettings->debugwarnings = true;
 
+            // execute addon for each file
+            else if (std::strncmp(argv[i], "--addon=", 8) == 0) {
+                const std::string addon = argv[i] + 8;
+                if (!FileLister::fileExists(addon)) {
+                    printMessage("cppcheck: error: addon not found: '" + addon + "'.");
+                    return false;
+                }
+                mSettings->addons.push_back(addon);
+            }
+
+            else if (std::strncmp(argv[i], "--addon-python=", 15) == 0)
+                mSettings->addonPython = argv[i] + 15;
+
             // dump cppcheck data
             else if (std::strcmp(argv[i], "--dump") == 0)
                 mSettings->dump = true;
+            else if (std::strncmp(argv[i], "--dump-format=", 14) == 0) {
+                const std::string format = argv[i] + 14;
+                if (format == "xml")
+                    mSettings->dumpFormat = Settings::DUMP_XML;
+                else if (format == "binary")
+                    mSettings->dumpFormat = Settings::DUMP_BINARY;
+                else {
+                    std::string message("cppcheck: error: unrecognized dump format: \"");
+                    message += format;
+                    message += "\". Supported formats: xml, binary.";
+                    printMessage(message);
+                    return false;
+                }
+                mSettings->dump = true;
+            }
 
             // (Experimental) exception handling inside cppcheck client
             else if (std::strcmp(argv[i], "--exception-handling") == 0)
@@ -677,6 +760,24 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
                 return true;
             }
 
+            // engine used to find leaks in function variables..
+            else if (std::strncmp(argv[i], "--memleak-engine=", 17) == 0) {
+                const std::string engine = argv[i] + 17;
+                if (engine == "simplify")
+                    mSettings->memleakEngine = Settings::MEMLEAK_SIMPLIFY;
+                else if (engine == "cfg")
+                    mSettings->memleakEngine = Settings::MEMLEAK_CFG;
+                else if (engine == "compare")
+                    mSettings->memleakEngine = Settings::MEMLEAK_COMPARE;
+                else {
+                    std::string message("cppcheck: error: unrecognized memleak engine: \"");
+                    message += engine;
+                    message += "\". Supported engines: simplify, cfg, compare.";
+                    printMessage(message);
+                    return false;
+                }
+            }
+
             // show timing information..
             else if (std::strncmp(argv[i], "--showtime=", 11) == 0) {
                 const std::string showtimeMode = argv[i] + 11;
@@ -792,6 +893,55 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
                 maxconfigs = true;
             }
 
+            // Time budget for checking one file
+            else if (std::strncmp(argv[i], "--max-time-per-file=", 20) == 0) {
+                std::istringstream iss(20+argv[i]);
+                if (!(iss >> mSettings->maxTimePerFile)) {
+                    printMessage("cppcheck: argument to '--max-time-per-file=' is not a number.");
+                    return false;
+                }
+            }
+
+            // Memory budget for checking one file
+            else if (std::strncmp(argv[i], "--max-memory-per-file=", 22) == 0) {
+                std::istringstream iss(22+argv[i]);
+                unsigned int megabytes = 0;
+                if (!(iss >> megabytes)) {
+                    printMessage("cppcheck: argument to '--max-memory-per-file=' is not a number.");
+                    return false;
+                }
+                mSettings->maxMemoryPerFile = static_cast<std::size_t>(megabytes) * 1024U * 1024U;
+            }
+
+            // Memory budget for the files that are checked at the same time
+            else if (std::strncmp(argv[i], "--max-memory=", 13) == 0) {
+                std::istringstream iss(13+argv[i]);
+                unsigned int megabytes = 0;
+                if (!(iss >> megabytes)) {
+                    printMessage("cppcheck: argument to '--max-memory=' is not a number.");
+                    return false;
+                }
+                mSettings->maxMemory = static_cast<std::size_t>(megabytes) * 1024U * 1024U;
+            }
+
+            // Tokens the ValueFlow analysis of one variable may visit
+            else if (std::strncmp(argv[i], "--max-valueflow-tokens=", 23) == 0) {
+                std::istringstream iss(23+argv[i]);
+                if (!(iss >> mSettings->maxValueFlowTokens)) {
+                    printMessage("cppcheck: argument to '--max-valueflow-tokens=' is not a number.");
+                    return false;
+                }
+            }
+
+            // Nested branches the ValueFlow analysis of one variable follows
+            else if (std::strncmp(argv[i], "--max-valueflow-depth=", 22) == 0) {
+                std::istringstream iss(22+argv[i]);
+                if (!(iss >> mSettings->maxValueFlowDepth)) {
+                    printMessage("cppcheck: argument to '--max-valueflow-depth=' is not a number.");
+                    return false;
+                }
+            }
+
             // Print help
             else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
                 mPathNames.clear();
@@ -803,6 +953,7 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
             else if (std::strncmp(argv[i], "--conf=", 7) == 0) {
                 try {
                     mSettings->userRuleConfigure = YAML::LoadFile(7+argv[i]);
+                    Check::loadConfigs(mSettings);
                 } catch (...) {
                     std::string message("cppcheck: error: argument to --conf is not a valid yaml file");
                     printMessage(message);
@@ -838,6 +989,12 @@ bool CmdLineParser::parseFromArgs(int argc, const char* const argv[])
         printMessage("cppcheck: unusedFunction check can't be used with '-j' option. Disabling unusedFunction check.");
     }
 
+#ifdef HAVE_RULES
+    // compile the rule patterns once, all files and configurations share them
+    if (!mSettings->rules.empty())
+        mSettings->compileRules();
+#endif
+
     if (argc <= 1) {
         mShowHelp = true;
         mExitAfterPrint = true;
@@ -871,10 +1028,23 @@ void CmdLineParser::printHelp()
               "If a directory is given instead of a filename, *.cpp, *.cxx, *.cc, *.c++, *.c,\n"
               "*.tpp, and *.txx files are checked recursively from the given directory.\n\n"
               "Options:\n"
+              "    --addon=<script>     Execute an addon script, e.g. addons/misra.py, for each\n"
+              "                         checked file. The dump is passed to the addon through\n"
+              "                         a pipe, no dump files are written unless --dump is\n"
+              "                         given. Can be given several times.\n"
+              "    --addon-python=<exe> Python interpreter for the addons, default is 'python'.\n"
               "    --cppcheck-build-dir=<dir>\n"
               "                         Analysis output directory. Useful for various data.\n"
               "                         Some possible usages are; whole program analysis,\n"
               "                         incremental analysis, distributed analysis.\n"
+              "    --cfg-cache          Cache loaded library (.cfg) files in a binary format.\n"
+              "                         Loading cached files is faster than parsing the xml.\n"
+              "                         The cache is written to $XDG_CACHE_HOME/cppcheck or\n"
+              "                         ~/.cache/cppcheck (%LOCALAPPDATA%\\cppcheck on\n"
+              "                         Windows). The cache is not used by default.\n"
+              "    --cfg-cache-dir=<dir>\n"
+              "                         Same as --cfg-cache, but the cache is written to\n"
+              "                         <dir>. An empty <dir> disables the cache.\n"
               "    --check-config       Check cppcheck configuration. The normal code\n"
               "                         analysis is disabled by this flag.\n"
               "    --check-library      Show information messages when library files have\n"
@@ -892,6 +1062,10 @@ void CmdLineParser::printHelp()
               "    --dump               Dump xml data for each translation unit. The dump\n"
               "                         files have the extension .dump and contain ast,\n"
               "                         tokenlist, symboldatabase, valueflow.\n"
+              "    --dump-format=<format>\n"
+              "                         Format of the dump files, implies --dump. 'xml'\n"
+              "                         (default) or 'binary'. Binary dumps are smaller and\n"
+              "                         faster to load, cppcheckdata.py reads both formats.\n"
               "    -D<ID>               Define preprocessor symbol. Unless --max-configs or\n"
               "                         --force is used, Cppcheck will only check the given\n"
               "                         configuration when -D is used.\n"
@@ -1000,6 +1174,40 @@ void CmdLineParser::printHelp()
               "                         before skipping it. Default is '12'. If used together\n"
               "                         with '--force', the last option is the one that is\n"
               "                         effective.\n"
+              "    --max-memory=<MB>    Memory budget in megabytes for the files that are\n"
+              "                         checked at the same time. When the checked files use\n"
+              "                         more memory, no new files are started even if there\n"
+              "                         are less than -j jobs. Default is '0', no budget.\n"
+              "    --max-memory-per-file=<MB>\n"
+              "                         Memory budget in megabytes for checking one file.\n"
+              "                         When it is exceeded, the ValueFlow analysis is\n"
+              "                         stopped, the checks of the simplified code are\n"
+              "                         skipped and configurations that instantiate too many\n"
+              "                         templates are aborted. The degraded stages are\n"
+              "                         reported with --enable=information. Default is '0',\n"
+              "                         no budget.\n"
+              "    --max-time-per-file=<seconds>\n"
+              "                         Time budget for checking one file. When it is\n"
+              "                         exceeded, the ValueFlow analysis is stopped, the\n"
+              "                         checks of the simplified code are skipped and no\n"
+              "                         more configurations are checked. The degraded stages\n"
+              "                         are reported with --enable=information. Default is\n"
+              "                         '0', no budget.\n"
+              "    --max-valueflow-depth=<N>\n"
+              "                         Maximum depth of nested branches that the ValueFlow\n"
+              "                         analysis follows for one variable. Default is '64',\n"
+              "                         '0' means no limit.\n"
+              "    --max-valueflow-tokens=<N>\n"
+              "                         Maximum number of tokens that the ValueFlow analysis\n"
+              "                         visits for one variable. When it is reached the\n"
+              "                         analysis of the variable is stopped. Default is\n"
+              "                         '100000', '0' means no limit. The number of visited\n"
+              "                         tokens is shown by '--showtime'.\n"
+              "    --memleak-engine=<engine>\n"
+              "                         Engine that finds memory leaks of function variables.\n"
+              "                         'simplify' (default) rewrites the code until nothing\n"
+              "                         changes, 'cfg' uses a control flow graph and\n"
+              "                         'compare' writes a debug message when they disagree.\n"
               "    --platform=<type>, --platform=<file>\n"
               "                         Specifies platform specific types and sizes. The\n"
               "                         available builtin platforms are:\n"
@@ -28,6 +28,7 @@
 #include "path.h"
 #include "pathmatch.h"
 #include "preprocessor.h"
+#include "resultwriter.h"
 #include "settings.h"
 #include "standards.h"
 #include "suppressions.h"
@@ -44,6 +45,15 @@
 #include <utility>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 #if !defined(NO_UNIX_SIGNAL_HANDLING) && defined(__GNUC__) && !defined(__MINGW32__) && !defined(__OS2__)
 #define USE_UNIX_SIGNAL_HANDLING
 #include <unistd.h>
@@ -79,13 +89,57 @@
 /*static*/ FILE* CppCheckExecutor::exceptionOutput = stdout;
 
 CppCheckExecutor::CppCheckExecutor()
-    : _settings(nullptr), latestProgressOutputTime(0), errorOutput(nullptr), errorlist(false)
+    : _settings(nullptr), latestProgressOutputTime(0), errorOutput(nullptr), errorOutputFd(-1), resultWriter(std::cerr, 2), errorlist(false)
 {
 }
 
 CppCheckExecutor::~CppCheckExecutor()
 {
+    resultWriter.flush();
     delete errorOutput;
+    if (errorOutputFd >= 0) {
+#ifdef _WIN32
+        _close(errorOutputFd);
+#else
+        close(errorOutputFd);
+#endif
+    }
+}
+
+/** Results that are written when cppcheck is terminated by a signal */
+static ResultWriter *signalResultWriter = nullptr;
+#ifndef _WIN32
+/** Forked processes inherit the signal handlers but must not write the results of their parent */
+static pid_t signalResultWriterProcess = 0;
+#endif
+
+static void flushResultsAfterSignal()
+{
+#ifndef _WIN32
+    if (getpid() != signalResultWriterProcess)
+        return;
+#endif
+    if (signalResultWriter)
+        signalResultWriter->flushAfterSignal();
+}
+
+/** Write the buffered results and terminate, only async-signal-safe calls are made */
+static void terminationSignalHandler(int signo)
+{
+    flushResultsAfterSignal();
+    std::signal(signo, SIG_DFL);
+    std::raise(signo);
+}
+
+typedef void (*SignalHandler)(int);
+
+/** Install terminationSignalHandler unless the signal is ignored, return the previous handler */
+static SignalHandler installTerminationSignalHandler(int signo)
+{
+    const SignalHandler previous = std::signal(signo, terminationSignalHandler);
+    if (previous == SIG_IGN)
+        std::signal(signo, SIG_IGN);
+    return previous;
 }
 
 bool CppCheckExecutor::parseFromArgs(CppCheck *cppcheck, int argc, const char* const argv[])
@@ -194,10 +248,26 @@ int CppCheckExecutor::check(int argc, const char* const argv[])
     if (settings.terminated()) {
         return EXIT_SUCCESS;
     }
+
+    signalResultWriter = &resultWriter;
+#ifndef _WIN32
+    signalResultWriterProcess = getpid();
+#endif
+    const SignalHandler previousIntHandler = installTerminationSignalHandler(SIGINT);
+    const SignalHandler previousTermHandler = installTerminationSignalHandler(SIGTERM);
+
+    int result;
     if (cppCheck.settings().exceptionHandling) {
-        return check_wrapper(cppCheck, argc, argv);
+        result = check_wrapper(cppCheck, argc, argv);
+    } else {
+        result = check_internal(cppCheck, argc, argv);
     }
-    return check_internal(cppCheck, argc, argv);
+
+    std::signal(SIGINT, previousIntHandler);
+    std::signal(SIGTERM, previousTermHandler);
+    signalResultWriter = nullptr;
+    resultWriter.flush();
+    return result;
 }
 
 void CppCheckExecutor::setSettings(const Settings &settings)
@@ -524,6 +594,7 @@ static void CppcheckSignalHandler(int signo, siginfo_t * info, void * context)
         fputs("\nPlease report this to the cppcheck developers!\n", output);
     }
     fflush(output);
+    flushResultsAfterSignal();
 
     if (terminate) {
         // now let things proceed, shutdown and hopefully dump core for post-mortem analysis
@@ -774,6 +845,7 @@ int CppCheckExecutor::check_wrapper(CppCheck& cppcheck, int argc, const char* co
     } __except (filterException(GetExceptionCode(), GetExceptionInformation())) {
         // reporting to stdout may not be helpful within a GUI application...
         fputs("Please report this to the cppcheck developers!\n", outputFile);
+        flushResultsAfterSignal();
         return -1;
     }
 #elif defined(USE_UNIX_SIGNAL_HANDLING)
@@ -842,6 +914,13 @@ int CppCheckExecutor::check_internal(CppCheck& cppcheck, int /*argc*/, const cha
 
     if (!settings.outputFile.empty()) {
         errorOutput = new std::ofstream(settings.outputFile);
+        // second descriptor for the file, the results are written with it in signal handlers
+#ifdef _WIN32
+        errorOutputFd = _open(settings.outputFile.c_str(), _O_WRONLY | _O_APPEND);
+#else
+        errorOutputFd = open(settings.outputFile.c_str(), O_WRONLY | O_APPEND);
+#endif
+        resultWriter.setStream(*errorOutput, errorOutputFd);
     }
 
     if (settings.xml) {
@@ -871,6 +950,7 @@ int CppCheckExecutor::check_internal(CppCheck& cppcheck, int /*argc*/, const cha
             if (!_settings->library.markupFile(i->first)
                 || !_settings->library.processMarkupAfterCode(i->first)) {
                 returnValue += cppcheck.check(i->first);
+                resultWriter.flush();
                 processedsize += i->second;
                 if (!settings.quiet)
                     reportStatus(c + 1, _files.size(), processedsize, totalfilesize);
@@ -882,6 +962,7 @@ int CppCheckExecutor::check_internal(CppCheck& cppcheck, int /*argc*/, const cha
         c = 0;
         for (std::list<ImportProject::FileSettings>::const_iterator fs = settings.project.fileSettings.begin(); fs != settings.project.fileSettings.end(); ++fs) {
             returnValue += cppcheck.check(*fs);
+            resultWriter.flush();
             ++c;
             if (!settings.quiet)
                 reportStatus(c, settings.project.fileSettings.size(), c, settings.project.fileSettings.size());
@@ -892,6 +973,7 @@ int CppCheckExecutor::check_internal(CppCheck& cppcheck, int /*argc*/, const cha
         for (std::map<std::string, std::size_t>::const_iterator i = _files.begin(); i != _files.end(); ++i) {
             if (_settings->library.markupFile(i->first) && _settings->library.processMarkupAfterCode(i->first)) {
                 returnValue += cppcheck.check(i->first);
+                resultWriter.flush();
                 processedsize += i->second;
                 if (!settings.quiet)
                     reportStatus(c + 1, _files.size(), processedsize, totalfilesize);
@@ -979,19 +1061,20 @@ static inline std::string ansiToOEM(const std::string &msg, bool doConvert)
 void CppCheckExecutor::reportErr(const std::string &errmsg)
 {
     // Alert only about unique errors
-    if (_errorList.find(errmsg) != _errorList.end())
+    if (!_errorList.insert(errmsg).second)
         return;
 
-    _errorList.insert(errmsg);
     if (errorOutput)
-        *errorOutput << errmsg << std::endl;
+        resultWriter.writeLine(errmsg);
     else {
-        std::cerr << ansiToOEM(errmsg, (_settings == nullptr) ? true : !_settings->xml) << std::endl;
+        resultWriter.writeLine(ansiToOEM(errmsg, (_settings == nullptr) ? true : !_settings->xml));
     }
 }
 
 void CppCheckExecutor::reportOut(const std::string &outmsg)
 {
+    // keep the order of results and messages when both are written to the terminal
+    resultWriter.flush();
     std::cout << ansiToOEM(outmsg, true) << std::endl;
 }
 
@@ -1021,6 +1104,8 @@ void CppCheckExecutor::reportProgress(const std::string &filename, const char st
 void CppCheckExecutor::reportInfo(const ErrorLogger::ErrorMessage &msg)
 {
     reportErr(msg);
+    // information messages are rare, show them immediately
+    resultWriter.flush();
 }
 
 void CppCheckExecutor::reportStatus(std::size_t fileindex, std::size_t filecount, std::size_t sizedone, std::size_t sizetotal)
@@ -1039,11 +1124,15 @@ void CppCheckExecutor::reportErr(const ErrorLogger::ErrorMessage &msg)
 {
     if (errorlist) {
         reportOut(msg.toXML());
-    } else if (_settings->xml) {
-        reportErr(msg.toXML());
-    } else {
-        reportErr(msg.toString(_settings->verbose, _settings->templateFormat, _settings->templateLocation));
+        return;
     }
+
+    formattedMessage.clear();
+    if (_settings->xml)
+        msg.appendXML(formattedMessage);
+    else
+        msg.appendString(formattedMessage, _settings->verbose, _settings->templateFormat, _settings->templateLocation);
+    reportErr(formattedMessage);
 }
 
 void CppCheckExecutor::setExceptionOutput(FILE* exception_output)
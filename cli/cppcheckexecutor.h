@@ -20,6 +20,7 @@
 #define CPPCHECKEXECUTOR_H
 
 #include "errorlogger.h"
+#include "resultwriter.h"
 
 #include <cstdio>
 #include <ctime>
@@ -187,6 +188,21 @@ private:
      */
     std::ofstream *errorOutput;
 
+    /**
+     * File descriptor for errorOutput that is used in signal handlers, -1 if there is none
+     */
+    int errorOutputFd;
+
+    /**
+     * Buffered output of the results to std::cerr or errorOutput
+     */
+    ResultWriter resultWriter;
+
+    /**
+     * Reusable buffer for formatting a result
+     */
+    std::string formattedMessage;
+
     /**
      * Has --errorlist been given?
      */
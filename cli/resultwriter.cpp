@@ -0,0 +1,96 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resultwriter.h"
+
+#include <atomic>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+ResultWriter::ResultWriter(std::ostream &out, int fd)
+    : mOut(&out), mFd(fd), mBusy(0)
+{
+    mBuffer.reserve(BUFFER_SIZE + 1024);
+}
+
+ResultWriter::~ResultWriter()
+{
+    flush();
+}
+
+void ResultWriter::setStream(std::ostream &out, int fd)
+{
+    flush();
+    mOut = &out;
+    mFd = fd;
+}
+
+void ResultWriter::writeLine(const std::string &line)
+{
+    mBusy = 1;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    mBuffer += line;
+    mBuffer += '\n';
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    mBusy = 0;
+    if (mBuffer.size() >= BUFFER_SIZE)
+        flush();
+}
+
+void ResultWriter::flush()
+{
+    if (mBuffer.empty())
+        return;
+    mBusy = 1;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    mOut->write(mBuffer.data(), mBuffer.size());
+    mOut->flush();
+    mBuffer.clear();
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    mBusy = 0;
+}
+
+void ResultWriter::flushAfterSignal()
+{
+    if (mBusy || mFd < 0)
+        return;
+    const char *data = mBuffer.data();
+    std::size_t size = mBuffer.size();
+    while (size > 0) {
+#ifdef _WIN32
+        const int n = _write(mFd, data, static_cast<unsigned int>(size));
+        if (n <= 0)
+            break;
+#else
+        const ssize_t n = ::write(mFd, data, size);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+#endif
+        data += n;
+        size -= n;
+    }
+    // the capacity is kept, clear() does not allocate
+    mBuffer.clear();
+}
@@ -0,0 +1,78 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef resultwriterH
+#define resultwriterH
+
+#include <csignal>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+/// @addtogroup CLI
+/// @{
+
+/**
+ * @brief Buffered output of the results.
+ *
+ * The result lines are collected in a buffer, which is written to the
+ * stream in one block when it is full and at checkpoints (flush()), for
+ * instance after each checked file. The stream is not flushed after each
+ * line like with std::endl.
+ */
+class ResultWriter {
+public:
+    /**
+     * @param out stream for the results
+     * @param fd file descriptor that writes to the same file as out, used by flushAfterSignal(). -1 if there is none.
+     */
+    explicit ResultWriter(std::ostream &out, int fd = -1);
+    ~ResultWriter();
+
+    /** Write to out and fd from now on, the buffered lines are written to the previous stream first */
+    void setStream(std::ostream &out, int fd = -1);
+
+    /** Add line to the buffer, a newline is appended */
+    void writeLine(const std::string &line);
+
+    /** Checkpoint: write the buffered lines and flush the stream if there are any */
+    void flush();
+
+    /**
+     * Write the buffered lines when cppcheck is terminated by a signal.
+     * Only async-signal-safe calls are used: the lines are written to the
+     * file descriptor, the stream is not touched. Nothing is written if
+     * there is no file descriptor or if the signal interrupted writeLine()
+     * or flush().
+     */
+    void flushAfterSignal();
+
+    static const std::size_t BUFFER_SIZE = 1U << 16;
+
+private:
+    std::ostream *mOut;
+    int mFd;
+    std::string mBuffer;
+
+    /** writeLine() or flush() is running */
+    volatile std::sig_atomic_t mBusy;
+};
+
+/// @}
+
+#endif // resultwriterH
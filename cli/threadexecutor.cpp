@@ -18,6 +18,7 @@
 
 #include "threadexecutor.h"
 
+#include "analyzerinfo.h"
 #include "config.h"
 #include "cppcheck.h"
 #include "cppcheckexecutor.h"
@@ -30,6 +31,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <sstream>
 #include <utility>
 
 #ifdef __SVR4  // Solaris
@@ -56,6 +58,8 @@ ThreadExecutor::ThreadExecutor(const std::map<std::string, std::size_t> &files,
 #if defined(THREADING_MODEL_FORK)
     _wpipe = 0;
 #elif defined(THREADING_MODEL_WIN)
+    _nextFile = 0;
+    _nextFileSettings = 0;
     _processedFiles = 0;
     _totalFiles = 0;
     _processedSize = 0;
@@ -68,6 +72,60 @@ ThreadExecutor::~ThreadExecutor()
     //dtor
 }
 
+unsigned int ThreadExecutor::ruleJobs() const
+{
+    const std::size_t files = _files.size() + _settings.project.fileSettings.size();
+    if (files == 0 || files >= _settings.jobs)
+        return 1;
+    return _settings.jobs / static_cast<unsigned int>(files);
+}
+
+void ThreadExecutor::sortFiles()
+{
+    _sortedFiles.clear();
+    for (std::map<std::string, std::size_t>::const_iterator i = _files.begin(); i != _files.end(); ++i)
+        _sortedFiles.push_back(i);
+    _sortedFileSettings.clear();
+    for (std::list<ImportProject::FileSettings>::const_iterator i = _settings.project.fileSettings.begin(); i != _settings.project.fileSettings.end(); ++i)
+        _sortedFileSettings.push_back(i);
+
+    if (_settings.buildDir.empty())
+        return;
+
+    std::map<std::string, std::size_t> fileCost;
+    for (std::map<std::string, std::size_t>::const_iterator i = _files.begin(); i != _files.end(); ++i)
+        fileCost[i->first] = AnalyzerInformation::getCost(_settings.buildDir, i->first, emptyString);
+    std::stable_sort(_sortedFiles.begin(), _sortedFiles.end(),
+    [&](std::map<std::string, std::size_t>::const_iterator a, std::map<std::string, std::size_t>::const_iterator b) {
+        return fileCost[a->first] > fileCost[b->first];
+    });
+
+    std::map<const ImportProject::FileSettings *, std::size_t> fileSettingsCost;
+    for (const ImportProject::FileSettings &fs : _settings.project.fileSettings)
+        fileSettingsCost[&fs] = AnalyzerInformation::getCost(_settings.buildDir, fs.filename, fs.cfg);
+    std::stable_sort(_sortedFileSettings.begin(), _sortedFileSettings.end(),
+    [&](std::list<ImportProject::FileSettings>::const_iterator a, std::list<ImportProject::FileSettings>::const_iterator b) {
+        return fileSettingsCost[&*a] > fileSettingsCost[&*b];
+    });
+}
+
+void ThreadExecutor::addFileCost(const std::string &filename, std::size_t cost)
+{
+    // Compare with the median cost when there are enough files to compare with
+    if (!_settings.quiet && _fileCosts.size() >= 10) {
+        std::vector<std::size_t> costs(_fileCosts);
+        std::nth_element(costs.begin(), costs.begin() + costs.size() / 2, costs.end());
+        const std::size_t median = std::max<std::size_t>(costs[costs.size() / 2], 1);
+        if (cost >= 10 * median && _expensiveFiles.insert(filename).second) {
+            std::ostringstream oss;
+            oss << "Checking " << filename << " may take long, its estimated cost " << cost
+                << " is " << (cost / median) << " times the median of the files checked so far";
+            _errorLogger.reportOut(oss.str());
+        }
+    }
+    _fileCosts.push_back(cost);
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 ////// This code is for platforms that support fork() only ////////////////////
@@ -80,7 +138,7 @@ void ThreadExecutor::addFileContent(const std::string &path, const std::string &
     _fileContents[ path ] = content;
 }
 
-int ThreadExecutor::handleRead(int rpipe, unsigned int &result)
+int ThreadExecutor::handleRead(int rpipe, unsigned int &result, const std::string &filename)
 {
     char type = 0;
     if (read(rpipe, &type, 1) <= 0) {
@@ -90,7 +148,7 @@ int ThreadExecutor::handleRead(int rpipe, unsigned int &result)
         return -1;
     }
 
-    if (type != REPORT_OUT && type != REPORT_ERROR && type != REPORT_INFO && type != CHILD_END) {
+    if (type != REPORT_OUT && type != REPORT_ERROR && type != REPORT_INFO && type != CHILD_END && type != REPORT_COST && type != REPORT_MEMORY) {
         std::cerr << "#### You found a bug from cppcheck.\nThreadExecutor::handleRead error, type was:" << type << std::endl;
         std::exit(0);
     }
@@ -128,6 +186,16 @@ int ThreadExecutor::handleRead(int rpipe, unsigned int &result)
                     _errorLogger.reportInfo(msg);
             }
         }
+    } else if (type == REPORT_COST) {
+        std::istringstream iss(buf);
+        std::size_t cost = 0;
+        iss >> cost;
+        addFileCost(filename, cost);
+    } else if (type == REPORT_MEMORY) {
+        std::istringstream iss(buf);
+        std::size_t bytes = 0;
+        iss >> bytes;
+        _childMemory[rpipe] = bytes;
     } else if (type == CHILD_END) {
         std::istringstream iss(buf);
         unsigned int fileResult = 0;
@@ -161,6 +229,17 @@ bool ThreadExecutor::checkLoadAverage(size_t nchildren)
 #endif
 }
 
+bool ThreadExecutor::checkMemory(size_t nchildren) const
+{
+    if (!nchildren || !_settings.maxMemory)
+        return true;
+
+    std::size_t memory = 0;
+    for (std::map<int, std::size_t>::const_iterator it = _childMemory.begin(); it != _childMemory.end(); ++it)
+        memory += it->second;
+    return memory < _settings.maxMemory;
+}
+
 unsigned int ThreadExecutor::check()
 {
     _fileCount = 0;
@@ -171,16 +250,18 @@ unsigned int ThreadExecutor::check()
         totalfilesize += i->second;
     }
 
+    sortFiles();
+
     std::list<int> rpipes;
     std::map<pid_t, std::string> childFile;
     std::map<int, std::string> pipeFile;
     std::size_t processedsize = 0;
-    std::map<std::string, std::size_t>::const_iterator iFile = _files.begin();
-    std::list<ImportProject::FileSettings>::const_iterator iFileSettings = _settings.project.fileSettings.begin();
+    std::size_t iFile = 0;
+    std::size_t iFileSettings = 0;
     for (;;) {
         // Start a new child
         size_t nchildren = rpipes.size();
-        if ((iFile != _files.end() || iFileSettings != _settings.project.fileSettings.end()) && nchildren < _settings.jobs && checkLoadAverage(nchildren)) {
+        if ((iFile < _sortedFiles.size() || iFileSettings < _sortedFileSettings.size()) && nchildren < _settings.jobs && checkLoadAverage(nchildren) && checkMemory(nchildren)) {
             int pipes[2];
             if (pipe(pipes) == -1) {
                 std::cerr << "pipe() failed: "<< std::strerror(errno) << std::endl;
@@ -209,16 +290,17 @@ unsigned int ThreadExecutor::check()
 
                 CppCheck fileChecker(*this, false);
                 fileChecker.settings() = _settings;
+                fileChecker.settings().ruleJobs = ruleJobs();
                 unsigned int resultOfCheck = 0;
 
-                if (iFileSettings != _settings.project.fileSettings.end()) {
-                    resultOfCheck = fileChecker.check(*iFileSettings);
-                } else if (!_fileContents.empty() && _fileContents.find(iFile->first) != _fileContents.end()) {
+                if (iFileSettings < _sortedFileSettings.size()) {
+                    resultOfCheck = fileChecker.check(*_sortedFileSettings[iFileSettings]);
+                } else if (!_fileContents.empty() && _fileContents.find(_sortedFiles[iFile]->first) != _fileContents.end()) {
                     // File content was given as a string
-                    resultOfCheck = fileChecker.check(iFile->first, _fileContents[ iFile->first ]);
+                    resultOfCheck = fileChecker.check(_sortedFiles[iFile]->first, _fileContents[ _sortedFiles[iFile]->first ]);
                 } else {
                     // Read file from a file
-                    resultOfCheck = fileChecker.check(iFile->first);
+                    resultOfCheck = fileChecker.check(_sortedFiles[iFile]->first);
                 }
 
                 std::ostringstream oss;
@@ -229,13 +311,14 @@ unsigned int ThreadExecutor::check()
 
             close(pipes[1]);
             rpipes.push_back(pipes[0]);
-            if (iFileSettings != _settings.project.fileSettings.end()) {
-                childFile[pid] = iFileSettings->filename + ' ' + iFileSettings->cfg;
-                pipeFile[pipes[0]] = iFileSettings->filename + ' ' + iFileSettings->cfg;
+            if (iFileSettings < _sortedFileSettings.size()) {
+                const ImportProject::FileSettings &fs = *_sortedFileSettings[iFileSettings];
+                childFile[pid] = fs.filename + ' ' + fs.cfg;
+                pipeFile[pipes[0]] = fs.filename + ' ' + fs.cfg;
                 ++iFileSettings;
             } else {
-                childFile[pid] = iFile->first;
-                pipeFile[pipes[0]] = iFile->first;
+                childFile[pid] = _sortedFiles[iFile]->first;
+                pipeFile[pipes[0]] = _sortedFiles[iFile]->first;
                 ++iFile;
             }
         } else if (!rpipes.empty()) {
@@ -252,7 +335,7 @@ unsigned int ThreadExecutor::check()
                 std::list<int>::iterator rp = rpipes.begin();
                 while (rp != rpipes.end()) {
                     if (FD_ISSET(*rp, &rfds)) {
-                        int readRes = handleRead(*rp, result);
+                        int readRes = handleRead(*rp, result, pipeFile[*rp]);
                         if (readRes == -1) {
                             std::size_t size = 0;
                             std::map<int, std::string>::iterator p = pipeFile.find(*rp);
@@ -270,6 +353,7 @@ unsigned int ThreadExecutor::check()
                             if (!_settings.quiet)
                                 CppCheckExecutor::reportStatus(_fileCount, _files.size() + _settings.project.fileSettings.size(), processedsize, totalfilesize);
 
+                            _childMemory.erase(*rp);
                             close(*rp);
                             rp = rpipes.erase(rp);
                         } else
@@ -348,6 +432,20 @@ void ThreadExecutor::reportInfo(const ErrorLogger::ErrorMessage &msg)
     writeToPipe(REPORT_INFO, msg.serialize());
 }
 
+void ThreadExecutor::reportFileCost(const std::string &/*filename*/, const std::string &/*cfg*/, std::size_t cost)
+{
+    std::ostringstream oss;
+    oss << cost;
+    writeToPipe(REPORT_COST, oss.str());
+}
+
+void ThreadExecutor::reportMemoryUsage(const std::string &/*filename*/, const std::string &/*cfg*/, std::size_t bytes)
+{
+    std::ostringstream oss;
+    oss << bytes;
+    writeToPipe(REPORT_MEMORY, oss.str());
+}
+
 #elif defined(THREADING_MODEL_WIN)
 
 void ThreadExecutor::addFileContent(const std::string &path, const std::string &content)
@@ -359,8 +457,9 @@ unsigned int ThreadExecutor::check()
 {
     HANDLE *threadHandles = new HANDLE[_settings.jobs];
 
-    _itNextFile = _files.begin();
-    _itNextFileSettings = _settings.project.fileSettings.begin();
+    sortFiles();
+    _nextFile = 0;
+    _nextFileSettings = 0;
 
     _processedFiles = 0;
     _processedSize = 0;
@@ -424,26 +523,27 @@ unsigned int __stdcall ThreadExecutor::threadProc(void *args)
     unsigned int result = 0;
 
     ThreadExecutor *threadExecutor = static_cast<ThreadExecutor*>(args);
-    std::map<std::string, std::size_t>::const_iterator &itFile = threadExecutor->_itNextFile;
-    std::list<ImportProject::FileSettings>::const_iterator &itFileSettings = threadExecutor->_itNextFileSettings;
+    std::size_t &nextFile = threadExecutor->_nextFile;
+    std::size_t &nextFileSettings = threadExecutor->_nextFileSettings;
 
     // guard static members of CppCheck against concurrent access
     EnterCriticalSection(&threadExecutor->_fileSync);
 
     CppCheck fileChecker(*threadExecutor, false);
     fileChecker.settings() = threadExecutor->_settings;
+    fileChecker.settings().ruleJobs = threadExecutor->ruleJobs();
 
     for (;;) {
-        if (itFile == threadExecutor->_files.end() && itFileSettings == threadExecutor->_settings.project.fileSettings.end()) {
+        if (nextFile == threadExecutor->_sortedFiles.size() && nextFileSettings == threadExecutor->_sortedFileSettings.size()) {
             LeaveCriticalSection(&threadExecutor->_fileSync);
             break;
         }
 
         std::size_t fileSize = 0;
-        if (itFile != threadExecutor->_files.end()) {
-            const std::string &file = itFile->first;
-            fileSize = itFile->second;
-            ++itFile;
+        if (nextFile < threadExecutor->_sortedFiles.size()) {
+            const std::string &file = threadExecutor->_sortedFiles[nextFile]->first;
+            fileSize = threadExecutor->_sortedFiles[nextFile]->second;
+            ++nextFile;
 
             LeaveCriticalSection(&threadExecutor->_fileSync);
 
@@ -456,8 +556,8 @@ unsigned int __stdcall ThreadExecutor::threadProc(void *args)
                 result += fileChecker.check(file);
             }
         } else { // file settings..
-            const ImportProject::FileSettings &fs = *itFileSettings;
-            ++itFileSettings;
+            const ImportProject::FileSettings &fs = *threadExecutor->_sortedFileSettings[nextFileSettings];
+            ++nextFileSettings;
             LeaveCriticalSection(&threadExecutor->_fileSync);
             result += fileChecker.check(fs);
         }
@@ -493,6 +593,20 @@ void ThreadExecutor::reportInfo(const ErrorLogger::ErrorMessage &msg)
     report(msg, REPORT_INFO);
 }
 
+void ThreadExecutor::reportFileCost(const std::string &filename, const std::string &cfg, std::size_t cost)
+{
+    EnterCriticalSection(&_reportSync);
+
+    addFileCost(cfg.empty() ? filename : (filename + ' ' + cfg), cost);
+
+    LeaveCriticalSection(&_reportSync);
+}
+
+void ThreadExecutor::reportMemoryUsage(const std::string &/*filename*/, const std::string &/*cfg*/, std::size_t /*bytes*/)
+{
+
+}
+
 void ThreadExecutor::report(const ErrorLogger::ErrorMessage &msg, MessageType msgType)
 {
     if (_settings.nomsg.isSuppressed(msg.toSuppressionsErrorMessage()))
@@ -551,4 +665,14 @@ void ThreadExecutor::reportInfo(const ErrorLogger::ErrorMessage &/*msg*/)
 
 }
 
+void ThreadExecutor::reportFileCost(const std::string &/*filename*/, const std::string &/*cfg*/, std::size_t /*cost*/)
+{
+
+}
+
+void ThreadExecutor::reportMemoryUsage(const std::string &/*filename*/, const std::string &/*cfg*/, std::size_t /*bytes*/)
+{
+
+}
+
 #endif
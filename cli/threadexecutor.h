@@ -25,7 +25,9 @@
 #include <cstddef>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 #if (defined(__GNUC__) || defined(__sun)) && !defined(__MINGW32__)
 #define THREADING_MODEL_FORK
@@ -52,6 +54,8 @@ public:
     virtual void reportOut(const std::string &outmsg) override;
     virtual void reportErr(const ErrorLogger::ErrorMessage &msg) override;
     virtual void reportInfo(const ErrorLogger::ErrorMessage &msg) override;
+    virtual void reportFileCost(const std::string &filename, const std::string &cfg, std::size_t cost) override;
+    virtual void reportMemoryUsage(const std::string &filename, const std::string &cfg, std::size_t bytes) override;
 
     /**
      * @brief Add content to a file, to be used in unit testing.
@@ -68,20 +72,44 @@ private:
     ErrorLogger &_errorLogger;
     unsigned int _fileCount;
 
+    /**
+     * Order the files. With a build dir, the files that were the most
+     * expensive to check in the last run are checked first, so that
+     * they do not delay the end of the run.
+     */
+    void sortFiles();
+    std::vector<std::map<std::string, std::size_t>::const_iterator> _sortedFiles;
+    std::vector<std::list<ImportProject::FileSettings>::const_iterator> _sortedFileSettings;
+
+    /**
+     * Record the estimated cost of a file, and tell the user if it is
+     * much more expensive than the files that were checked before it.
+     */
+    void addFileCost(const std::string &filename, std::size_t cost);
+    std::vector<std::size_t> _fileCosts;
+    std::set<std::string> _expensiveFiles;
+
+    /**
+     * Number of threads that execute the rules of a file. The jobs that
+     * are not needed to check the files in parallel are used for this.
+     */
+    unsigned int ruleJobs() const;
+
 #if defined(THREADING_MODEL_FORK)
 
     /** @brief Key is file name, and value is the content of the file */
     std::map<std::string, std::string> _fileContents;
 private:
-    enum PipeSignal {REPORT_OUT='1',REPORT_ERROR='2', REPORT_INFO='3', CHILD_END='4'};
+    enum PipeSignal {REPORT_OUT='1',REPORT_ERROR='2', REPORT_INFO='3', CHILD_END='4', REPORT_COST='5', REPORT_MEMORY='6'};
 
     /**
      * Read from the pipe, parse and handle what ever is in there.
+     *@param filename the file that the child checks
      *@return -1 in case of error
      *         0 if there is nothing in the pipe to be read
      *         1 if we did read something
      */
-    int handleRead(int rpipe, unsigned int &result);
+    int handleRead(int rpipe, unsigned int &result, const std::string &filename);
     void writeToPipe(PipeSignal type, const std::string &data);
     /**
      * Write end of status pipe, different for each child.
@@ -97,6 +125,16 @@ private:
      */
     bool checkLoadAverage(size_t nchildren);
 
+    /**
+     * @brief Check memory condition
+     * @param nchildren - count of currently ran children
+     * @return true - if new process can be started
+     */
+    bool checkMemory(size_t nchildren) const;
+
+    /** @brief Key is the read end of the pipe of a child, and value is the memory that the child uses */
+    std::map<int, std::size_t> _childMemory;
+
 public:
     /**
      * @return true if support for threads exist.
@@ -111,8 +149,8 @@ private:
     enum MessageType {REPORT_ERROR, REPORT_INFO};
 
     std::map<std::string, std::string> _fileContents;
-    std::map<std::string, std::size_t>::const_iterator _itNextFile;
-    std::list<ImportProject::FileSettings>::const_iterator _itNextFileSettings;
+    std::size_t _nextFile;
+    std::size_t _nextFileSettings;
     std::size_t _processedFiles;
     std::size_t _totalFiles;
     std::size_t _processedSize;
@@ -7,3 +7,7 @@ if (UNIX)
     endif()
     add_definitions(-DCFGDIR="${CMAKE_INSTALL_PREFIX}/share/${PROJECT_NAME}")
 endif()
+
+if (HAVE_COUNTERS)
+    add_definitions(-DHAVE_COUNTERS)
+endif()
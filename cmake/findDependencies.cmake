@@ -11,6 +11,8 @@ if (HAVE_RULES)
     if (NOT PCRE)
         message(FATAL_ERROR "pcre dependency for RULES has not been found")
     endif()
+    # the rules are executed in several threads
+    find_package(Threads REQUIRED)
 endif()
 
 set(CMAKE_INCLUDE_CURRENT_DIR ON)
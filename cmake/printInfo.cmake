@@ -31,6 +31,7 @@ message( STATUS "BUILD_TESTS =           ${BUILD_TESTS}" )
 message( STATUS "BUILD_GUI =             ${BUILD_GUI}" )
 message( STATUS )
 message( STATUS "HAVE_RULES =            ${HAVE_RULES}" )
+message( STATUS "HAVE_COUNTERS =         ${HAVE_COUNTERS}" )
 message( STATUS )
 message( STATUS "Change a value with: cmake -D<Variable>=<Value>" )
 message( STATUS )
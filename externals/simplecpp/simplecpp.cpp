@@ -29,6 +29,8 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <stack>
 #include <stdexcept>
@@ -38,6 +40,11 @@
 #include <windows.h>
 #undef ERROR
 #undef TRUE
+#else
+#include <cerrno>
+#include <ctime>
+#include <dirent.h>
+#include <sys/stat.h>
 #endif
 
 static bool isHex(const std::string &s)
@@ -2096,23 +2103,165 @@ static const simplecpp::Token *gotoNextLine(const simplecpp::Token *tok)
     return tok;
 }
 
-static std::string openHeader(std::ifstream &f, const simplecpp::DUI &dui, const std::string &sourcefile, const std::string &header, bool systemheader)
+namespace {
+    /**
+     * Process wide cache of include lookups. A missing header costs one
+     * failed open per include path, so both found and missing headers are
+     * remembered. Directory listings are cached so that the candidates in
+     * each include root can be tested without touching the file system.
+     * The cache is dropped when a listed directory has been modified.
+     */
+    class IncludeCache {
+    public:
+        /**
+         * Lookup header
+         * @param key includer dir, header name and system flag
+         * @param result output: path where header was found, empty if it was not found
+         * @return true if the lookup is cached
+         */
+        bool find(const std::string &includePaths, const std::string &key, std::string *result) const {
+            const std::map<std::string, std::map<std::string, std::string> >::const_iterator it1 = mResolved.find(includePaths);
+            if (it1 == mResolved.end())
+                return false;
+            const std::map<std::string, std::string>::const_iterator it2 = it1->second.find(key);
+            if (it2 == it1->second.end())
+                return false;
+            *result = it2->second;
+            return true;
+        }
+
+        void insert(const std::string &includePaths, const std::string &key, const std::string &result) {
+            mResolved[includePaths][key] = result;
+        }
+
+        /** Does file exist? The result might be cached. */
+        bool exists(const std::string &path) {
+#if !defined(SIMPLECPP_WINDOWS) && !defined(__APPLE__)
+            // Case sensitive file systems: look in the directory listing
+            const std::string::size_type sep = path.find_last_of('/');
+            const std::string dir = (sep == std::string::npos) ? std::string(".") : path.substr(0, sep + 1U);
+            const std::string name = (sep == std::string::npos) ? path : path.substr(sep + 1U);
+            const Directory &directory = listDirectory(dir);
+            if (directory.listed)
+                return directory.entries.find(name) != directory.entries.end();
+            if (directory.missing)
+                return false;
+#endif
+            std::ifstream f(path.c_str());
+            return f.is_open();
+        }
+
+        void clear() {
+            mResolved.clear();
+#if !defined(SIMPLECPP_WINDOWS) && !defined(__APPLE__)
+            mDirectories.clear();
+#endif
+        }
+
+        /**
+         * Drop the cache if headers have been added or removed since the
+         * directories were listed. Directories that have been modified are
+         * listed again, the cache is kept if their entries are unchanged.
+         */
+        void revalidate() {
+#if !defined(SIMPLECPP_WINDOWS) && !defined(__APPLE__)
+            for (std::map<std::string, Directory>::iterator it = mDirectories.begin(); it != mDirectories.end(); ++it) {
+                Directory &directory = it->second;
+                if (!directory.racy) {
+                    struct stat st;
+                    if (stat(it->first.c_str(), &st) == 0 ? (!directory.missing && sameTime(st.st_mtim, directory.mtime)) : directory.missing)
+                        continue;
+                }
+                Directory current;
+                readDirectory(it->first, current);
+                if (current.listed != directory.listed || current.missing != directory.missing || current.entries != directory.entries) {
+                    clear();
+                    return;
+                }
+                directory = current;
+            }
+#endif
+        }
+
+        std::mutex mutex;
+
+    private:
+#if !defined(SIMPLECPP_WINDOWS) && !defined(__APPLE__)
+        struct Directory {
+            Directory() : listed(false), missing(false), racy(false) {
+                mtime.tv_sec = 0;
+                mtime.tv_nsec = 0;
+            }
+            bool listed;
+            bool missing;
+            /** modified so recently that a later change might get the same time stamp */
+            bool racy;
+            struct timespec mtime;
+            std::set<std::string> entries;
+        };
+
+        static bool sameTime(const struct timespec &t1, const struct timespec &t2) {
+            return t1.tv_sec == t2.tv_sec && t1.tv_nsec == t2.tv_nsec;
+        }
+
+        const Directory &listDirectory(const std::string &dir) {
+            const std::map<std::string, Directory>::const_iterator it = mDirectories.find(dir);
+            if (it != mDirectories.end())
+                return it->second;
+            Directory &directory = mDirectories[dir];
+            readDirectory(dir, directory);
+            return directory;
+        }
+
+        static void readDirectory(const std::string &dir, Directory &directory) {
+            struct stat st;
+            if (stat(dir.c_str(), &st) == 0) {
+                directory.mtime = st.st_mtim;
+                directory.racy = (st.st_mtim.tv_sec + 1 >= std::time(0));
+            }
+            DIR *d = opendir(dir.c_str());
+            if (!d) {
+                directory.missing = (errno == ENOENT || errno == ENOTDIR);
+                return;
+            }
+            while (const struct dirent *entry = readdir(d))
+                directory.entries.insert(entry->d_name);
+            closedir(d);
+            directory.listed = true;
+        }
+
+        std::map<std::string, Directory> mDirectories;
+#endif
+
+        /** include paths => (includer dir, header, system flag) => path */
+        std::map<std::string, std::map<std::string, std::string> > mResolved;
+    };
+
+    IncludeCache includeCache;
+}
+
+/** Does file exist? With cached=true the cached directory listings are used. */
+static bool headerExists(const std::string &path, bool cached)
 {
-    if (isAbsolutePath(header)) {
-        f.open(header.c_str());
-        return f.is_open() ? simplecpp::simplifyPath(header) : "";
-    }
+    if (cached)
+        return includeCache.exists(path);
+    std::ifstream f(path.c_str());
+    return f.is_open();
+}
+
+static std::string resolveHeader(const simplecpp::DUI &dui, const std::string &sourcefile, const std::string &header, bool systemheader, bool cached)
+{
+    if (isAbsolutePath(header))
+        return headerExists(header, cached) ? header : "";
 
     if (!systemheader) {
         if (sourcefile.find_first_of("\\/") != std::string::npos) {
             const std::string s = sourcefile.substr(0, sourcefile.find_last_of("\\/") + 1U) + header;
-            f.open(s.c_str());
-            if (f.is_open())
-                return simplecpp::simplifyPath(s);
+            if (headerExists(s, cached))
+                return s;
         } else {
-            f.open(header.c_str());
-            if (f.is_open())
-                return simplecpp::simplifyPath(header);
+            if (headerExists(header, cached))
+                return header;
         }
     }
 
@@ -2121,14 +2270,62 @@ static std::string openHeader(std::ifstream &f, const simplecpp::DUI &dui, const
         if (!s.empty() && s[s.size()-1U]!='/' && s[s.size()-1U]!='\\')
             s += '/';
         s += header;
-        f.open(s.c_str());
-        if (f.is_open())
-            return simplecpp::simplifyPath(s);
+        if (headerExists(s, cached))
+            return s;
     }
 
     return "";
 }
 
+static std::string openHeader(std::ifstream &f, const simplecpp::DUI &dui, const std::string &sourcefile, const std::string &header, bool systemheader)
+{
+    std::string includePaths;
+    for (std::list<std::string>::const_iterator it = dui.includePaths.begin(); it != dui.includePaths.end(); ++it) {
+        includePaths += *it;
+        includePaths += '\n';
+    }
+    std::string key;
+    if (!systemheader && !isAbsolutePath(header) && sourcefile.find_first_of("\\/") != std::string::npos)
+        key = sourcefile.substr(0, sourcefile.find_last_of("\\/") + 1U);
+    key += '\n' + header + (systemheader ? "\n<" : "\n\"");
+
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(includeCache.mutex);
+        if (!includeCache.find(includePaths, key, &path)) {
+            path = resolveHeader(dui, sourcefile, header, systemheader, true);
+            includeCache.insert(includePaths, key, path);
+        }
+    }
+    if (path.empty())
+        return "";
+    f.open(path.c_str());
+    if (!f.is_open()) {
+        // the file was removed after the lookup was cached, search again without the cache
+        path = resolveHeader(dui, sourcefile, header, systemheader, false);
+        {
+            std::lock_guard<std::mutex> lock(includeCache.mutex);
+            includeCache.insert(includePaths, key, path);
+        }
+        if (path.empty())
+            return "";
+        f.open(path.c_str());
+    }
+    return f.is_open() ? simplecpp::simplifyPath(path) : "";
+}
+
+static void revalidateIncludeCache()
+{
+    std::lock_guard<std::mutex> lock(includeCache.mutex);
+    includeCache.revalidate();
+}
+
+void simplecpp::clearIncludeCache()
+{
+    std::lock_guard<std::mutex> lock(includeCache.mutex);
+    includeCache.clear();
+}
+
 static std::string getFileName(const std::map<std::string, simplecpp::TokenList *> &filedata, const std::string &sourcefile, const std::string &header, const simplecpp::DUI &dui, bool systemheader)
 {
     if (filedata.empty()) {
@@ -2174,6 +2371,8 @@ std::map<std::string, simplecpp::TokenList*> simplecpp::load(const simplecpp::To
 
     std::list<const Token *> filelist;
 
+    revalidateIncludeCache();
+
     // -include files
     for (std::list<std::string>::const_iterator it = dui.includes.begin(); it != dui.includes.end(); ++it) {
         const std::string &filename = realFilename(*it);
@@ -2263,6 +2462,8 @@ static bool preprocessToken(simplecpp::TokenList &output, const simplecpp::Token
 
 void simplecpp::preprocess(simplecpp::TokenList &output, const simplecpp::TokenList &rawtokens, std::vector<std::string> &files, std::map<std::string, simplecpp::TokenList *> &filedata, const simplecpp::DUI &dui, simplecpp::OutputList *outputList, std::list<simplecpp::MacroUsage> *macroUsage)
 {
+    revalidateIncludeCache();
+
     std::map<std::string, std::size_t> sizeOfType(rawtokens.sizeOfType);
     sizeOfType.insert(std::pair<std::string, std::size_t>("char", sizeof(char)));
     sizeOfType.insert(std::pair<std::string, std::size_t>("short", sizeof(short)));
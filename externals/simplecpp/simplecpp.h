@@ -310,6 +310,9 @@ namespace simplecpp {
      */
     SIMPLECPP_LIB void cleanup(std::map<std::string, TokenList*> &filedata);
 
+    /** Forget cached include lookups. They are also forgotten when a searched directory has been modified. */
+    SIMPLECPP_LIB void clearIncludeCache();
+
     /** Simplify path */
     SIMPLECPP_LIB std::string simplifyPath(std::string path);
 }
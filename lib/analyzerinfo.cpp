@@ -159,3 +159,27 @@ void AnalyzerInformation::setFileInfo(const std::string &check, const std::strin
     if (mOutputStream.is_open() && !fileInfo.empty())
         mOutputStream << "  <FileInfo check=\"" << check << "\">\n" << fileInfo << "  </FileInfo>\n";
 }
+
+void AnalyzerInformation::setCost(std::size_t cost)
+{
+    if (mOutputStream.is_open() && cost > 0)
+        mOutputStream << "  <cost value=\"" << cost << "\"/>\n";
+}
+
+std::size_t AnalyzerInformation::getCost(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg)
+{
+    tinyxml2::XMLDocument doc;
+    const tinyxml2::XMLError error = doc.LoadFile(getAnalyzerInfoFile(buildDir, sourcefile, cfg).c_str());
+    if (error != tinyxml2::XML_SUCCESS)
+        return 0;
+
+    const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
+    if (rootNode == nullptr)
+        return 0;
+
+    const tinyxml2::XMLElement * const costNode = rootNode->FirstChildElement("cost");
+    if (costNode == nullptr)
+        return 0;
+    const int64_t cost = costNode->Int64Attribute("value");
+    return cost > 0 ? static_cast<std::size_t>(cost) : 0;
+}
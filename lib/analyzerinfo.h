@@ -25,6 +25,7 @@
 #include "errorlogger.h"
 #include "importproject.h"
 
+#include <cstddef>
 #include <fstream>
 #include <list>
 #include <string>
@@ -56,7 +57,11 @@ public:
     bool analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, unsigned long long checksum, std::list<ErrorLogger::ErrorMessage> *errors);
     void reportErr(const ErrorLogger::ErrorMessage &msg, bool verbose);
     void setFileInfo(const std::string &check, const std::string &fileInfo);
+    /** Store the estimated cost of checking the file, see Tokenizer::estimateCost() */
+    void setCost(std::size_t cost);
     static std::string getAnalyzerInfoFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg);
+    /** The estimated cost of checking the file in the last run, 0 if it is not known */
+    static std::size_t getCost(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg);
 private:
     std::ofstream mOutputStream;
     std::string mAnalyzerInfoFile;
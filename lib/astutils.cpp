@@ -720,9 +720,9 @@ bool isUniqueExpression(const Token* tok)
         const Type * varType = var->type();
         // Iterate over the variables in scope and the parameters of the function if possible
         const Function * fun = scope->function;
-        const std::list<Variable>* setOfVars[] = {&scope->varlist, fun ? &fun->argumentList : nullptr};
+        const StableVector<Variable>* setOfVars[] = {&scope->varlist, fun ? &fun->argumentList : nullptr};
         if (varType) {
-            for (const std::list<Variable>* vars:setOfVars) {
+            for (const StableVector<Variable>* vars:setOfVars) {
                 if (!vars)
                     continue;
                 for (const Variable& v:*vars) {
@@ -732,7 +732,7 @@ bool isUniqueExpression(const Token* tok)
                 }
             }
         } else {
-            for (const std::list<Variable>* vars:setOfVars) {
+            for (const StableVector<Variable>* vars:setOfVars) {
                 if (!vars)
                     continue;
                 for (const Variable& v:*vars) {
@@ -895,56 +895,69 @@ bool isVariableChangedByFunctionCall(const Token *tok, const Settings *settings,
     return arg && !arg->isConst() && arg->isReference();
 }
 
-bool isVariableChanged(const Token *start, const Token *end, const unsigned int varid, bool globalvar, const Settings *settings, bool cpp)
+bool isVariableChanged(const Token *tok, const Settings *settings, bool cpp)
 {
-    for (const Token *tok = start; tok != end; tok = tok->next()) {
-        if (tok->varId() != varid) {
-            if (globalvar && Token::Match(tok, "%name% ("))
-                // TODO: Is global variable really changed by function call?
-                return true;
-            continue;
+    if (Token::Match(tok, "%name% %assign%|++|--"))
+        return true;
+
+    if (Token::Match(tok->previous(), "++|-- %name%"))
+        return true;
+
+    if (isLikelyStreamRead(cpp, tok->previous()))
+        return true;
+
+    // Member function call
+    if (Token::Match(tok, "%name% . %name% (")) {
+        const Variable * var = tok->variable();
+        bool isConst = var && var->isConst();
+        if (!isConst && var) {
+            const ValueType * valueType = var->valueType();
+            isConst = (valueType && valueType->pointer == 1 && valueType->constness == 1);
         }
 
-        if (Token::Match(tok, "%name% %assign%|++|--"))
+        const Token *ftok = tok->tokAt(2);
+        const Function * fun = ftok->function();
+        if (!isConst && (!fun || !fun->isConst()))
             return true;
+    }
 
-        if (Token::Match(tok->previous(), "++|-- %name%"))
-            return true;
+    const Token *ftok = tok;
+    while (ftok && !Token::Match(ftok, "[({[]"))
+        ftok = ftok->astParent();
 
-        if (isLikelyStreamRead(cpp, tok->previous()))
+    if (ftok && Token::Match(ftok->link(), ") !!{")) {
+        bool inconclusive = false;
+        bool isChanged = isVariableChangedByFunctionCall(tok, settings, &inconclusive);
+        isChanged |= inconclusive;
+        if (isChanged)
             return true;
+    }
 
-        // Member function call
-        if (Token::Match(tok, "%name% . %name% (")) {
-            const Variable * var = tok->variable();
-            bool isConst = var && var->isConst();
-            if (!isConst && var) {
-                const ValueType * valueType = var->valueType();
-                isConst = (valueType && valueType->pointer == 1 && valueType->constness == 1);
-            }
-
-            const Token *ftok = tok->tokAt(2);
-            const Function * fun = ftok->function();
-            if (!isConst && (!fun || !fun->isConst()))
-                return true;
-        }
+    const Token *parent = tok->astParent();
+    while (Token::Match(parent, ".|::"))
+        parent = parent->astParent();
+    return parent && parent->tokType() == Token::eIncDecOp;
+}
 
-        const Token *ftok = tok;
-        while (ftok && !Token::Match(ftok, "[({[]"))
-            ftok = ftok->astParent();
+bool isVariableChanged(const Token *start, const Token *end, const unsigned int varid, bool globalvar, const Settings *settings, bool cpp)
+{
+    // Use the def/use index of the symbol database when it is valid for this query
+    if (start && start->scope() && start->scope()->check) {
+        const DefUseIndex *defUse = start->scope()->check->defUseIndex();
+        bool changed = false;
+        if (defUse && defUse->isChanged(start, end, varid, globalvar, settings, cpp, &changed))
+            return changed;
+    }
 
-        if (ftok && Token::Match(ftok->link(), ") !!{")) {
-            bool inconclusive = false;
-            bool isChanged = isVariableChangedByFunctionCall(tok, settings, &inconclusive);
-            isChanged |= inconclusive;
-            if (isChanged)
+    for (const Token *tok = start; tok != end; tok = tok->next()) {
+        if (tok->varId() != varid) {
+            if (globalvar && Token::Match(tok, "%name% ("))
+                // TODO: Is global variable really changed by function call?
                 return true;
+            continue;
         }
 
-        const Token *parent = tok->astParent();
-        while (Token::Match(parent, ".|::"))
-            parent = parent->astParent();
-        if (parent && parent->tokType() == Token::eIncDecOp)
+        if (isVariableChanged(tok, settings, cpp))
             return true;
     }
     return false;
@@ -130,6 +130,9 @@ bool isVariableChangedByFunctionCall(const Token *tok, unsigned int varid, const
  */
 bool isVariableChangedByFunctionCall(const Token *tok, const Settings *settings, bool *inconclusive);
 
+/** Is variable changed at given token? The token must have the varid of the variable. */
+bool isVariableChanged(const Token *tok, const Settings *settings, bool cpp);
+
 /** Is variable changed in block of code? */
 bool isVariableChanged(const Token *start, const Token *end, const unsigned int varid, bool globalvar, const Settings *settings, bool cpp);
 
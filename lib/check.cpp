@@ -54,6 +54,22 @@ bool Check::wrongData(const Token *tok, bool condition, const char *str)
     return condition;
 }
 
+void Check::loadConfigs(Settings *settings)
+{
+    settings->checkConfigs.clear();
+    const YAML::Node &configure = settings->userRuleConfigure;
+    if (!configure)
+        return;
+    for (std::list<Check *>::const_iterator it = instances().begin(); it != instances().end(); ++it) {
+        const YAML::Node node = configure[(*it)->name()];
+        if (!node)
+            continue;
+        const std::shared_ptr<const CheckConfig> config = (*it)->loadConfig(node);
+        if (config)
+            settings->checkConfigs[(*it)->name()] = config;
+    }
+}
+
 std::list<Check *> &Check::instances()
 {
 #ifdef __SVR4
@@ -29,6 +29,8 @@
 #include "valueflow.h"
 
 #include <list>
+#include <map>
+#include <memory>
 #include <string>
 
 namespace tinyxml2 {
@@ -41,6 +43,15 @@ namespace tinyxml2 {
 /// @addtogroup Core
 /// @{
 
+/**
+ * @brief Base class for the configuration of a check, from the --conf file.
+ * The configuration is parsed once and is immutable after that.
+ */
+class CPPCHECKLIB CheckConfig {
+public:
+    virtual ~CheckConfig() {}
+};
+
 /**
  * @brief Interface class that cppcheck uses to communicate with the checks.
  * All checking classes must inherit from this class
@@ -53,7 +64,6 @@ public:
     /** This constructor is used when running checks. */
     Check(const std::string &aname, const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger)
         : mTokenizer(tokenizer), mSettings(settings), mErrorLogger(errorLogger), mName(aname) {
-            //loadConf(settings->userRuleConfigure);
     }
 
     virtual ~Check() {
@@ -61,8 +71,6 @@ public:
             instances().remove(this);
     }
 
-    //virtual void loadConf(const YAML::Node &configure) {}
-
     /** List of registered check classes. This is used by Cppcheck to run checks and generate documentation */
     static std::list<Check *> &instances();
 
@@ -73,6 +81,24 @@ public:
     /** run checks, the token list is simplified */
     virtual void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) = 0;
 
+    /**
+     * Parse the configuration of this check. This is called once for
+     * the registered instance, with the node that has the name of the
+     * check in the --conf file. Throws a YAML::Exception if the
+     * configuration is invalid.
+     * @return the configuration, or nullptr if the check has none
+     */
+    virtual std::shared_ptr<const CheckConfig> loadConfig(const YAML::Node &node) const {
+        (void)node;
+        return nullptr;
+    }
+
+    /**
+     * Parse the configurations of all registered checks from
+     * settings->userRuleConfigure into settings->checkConfigs.
+     */
+    static void loadConfigs(Settings *settings);
+
     /** get error messages */
     virtual void getErrorMessages(ErrorLogger *errorLogger, const Settings *settings) const = 0;
 
@@ -121,6 +147,15 @@ public:
     }
 
 protected:
+    /** The configuration of this check, nullptr if it is not configured */
+    template<class T>
+    const T *config() const {
+        if (!mSettings)
+            return nullptr;
+        const std::map<std::string, std::shared_ptr<const CheckConfig> >::const_iterator it = mSettings->checkConfigs.find(mName);
+        return it == mSettings->checkConfigs.end() ? nullptr : static_cast<const T *>(it->second.get());
+    }
+
     const Tokenizer * const mTokenizer;
     const Settings * const mSettings;
     ErrorLogger * const mErrorLogger;
@@ -167,7 +202,7 @@ protected:
         if (!value) {
             errorPath.emplace_back(errtok,bug);
         } else if (mSettings->verbose || mSettings->xml || !mSettings->templateLocation.empty()) {
-            errorPath = value->errorPath;
+            errorPath = value->errorPath.toList();
             errorPath.emplace_back(errtok,bug);
         } else {
             if (value->condition)
@@ -35,6 +35,7 @@
 #include <cstddef>
 #include <set>
 #include <stack>
+#include <vector>
 
 //---------------------------------------------------------------------------
 
@@ -418,7 +419,7 @@ const char *CheckMemoryLeak::functionArgAlloc(const Function *func, unsigned int
     if (!Token::simpleMatch(func->retDef, "void"))
         return "";
 
-    std::list<Variable>::const_iterator arg = func->argumentList.begin();
+    StableVector<Variable>::const_iterator arg = func->argumentList.begin();
     for (; arg != func->argumentList.end(); ++arg) {
         if (arg->index() == targetpar-1)
             break;
@@ -2014,6 +2015,474 @@ const Token *CheckMemoryLeakInFunction::findleak(const Token *tokens)
 }
 
 
+namespace {
+    /**
+     * Control flow graph for the code returned by getcode(). The allocation
+     * state of the variable is propagated through the graph once, instead
+     * of rewriting the code until nothing changes as simplifycode() does.
+     */
+    class LeakCfg {
+    public:
+        explicit LeakCfg(bool cpp) : mCpp(cpp), mDepth(0), mBailout(false) {}
+
+        /** Build graph. Returns false if the code can't be handled (goto). */
+        bool build(const Token *tokens);
+
+        /** Propagate allocation state and return the first leak (nullptr => no leak) */
+        const Token *findleak(const Token **deallocDealloc) const;
+
+    private:
+        /** possible states of the variable */
+        enum State { NOALLOC = 1, ALLOC = 2, FREED = 4, USED = 8 };
+
+        enum Kind {
+            NOP,
+            ALLOC_,    // variable is allocated
+            DEALLOC,   // variable is deallocated
+            USE,       // variable is used in unknown way => not tracked anymore
+            ASSIGN,    // variable is assigned
+            LEAVE,     // return/break/continue out of the checked scope
+            EXIT,      // noreturn
+            NONNULL,   // variable is not null on this edge
+            ISNULL,    // variable is null on this edge
+            UNKNOWN,   // variable is checked in unknown way on this edge
+            ENDBLOCK   // end of a { } block
+        };
+
+        struct Node {
+            Node(Kind k, const Token *t) : kind(k), tok(t) {}
+            Kind kind;
+            const Token *tok;
+            std::vector<std::size_t> successors;
+        };
+
+        typedef std::vector<std::size_t> Ends;
+
+        /** break/continue targets */
+        struct Jumps {
+            explicit Jumps(bool loop) : isLoop(loop) {}
+            bool isLoop;
+            Ends breaks;
+            Ends continues;
+        };
+
+        std::size_t addNode(Kind kind, const Token *tok, const Ends &predecessors);
+        void connect(const Ends &predecessors, std::size_t node);
+
+        const Token *parseBlock(const Token *tok, Ends &ends);
+        const Token *parseStatement(const Token *tok, Ends &ends);
+        const Token *parseIf(const Token *tok, Ends &ends);
+        const Token *parseLoop(const Token *tok, Ends &ends);
+        const Token *parseDo(const Token *tok, Ends &ends);
+        const Token *parseSwitch(const Token *tok, Ends &ends);
+        const Token *parseTry(const Token *tok, Ends &ends);
+        const Token *parseJump(const Token *tok, Ends &ends);
+
+        static bool isLeak(unsigned char state) {
+            // conditional allocation that is released on some other path =>
+            // the conditions are probably correlated
+            return (state & ALLOC) && !((state & NOALLOC) && (state & (FREED | USED)));
+        }
+
+        const bool mCpp;
+        std::vector<Node> mNodes;
+        std::vector<Jumps> mJumps;
+        /** first node of each try block that is being parsed */
+        std::vector<std::size_t> mTry;
+        int mDepth;
+        bool mBailout;
+    };
+}
+
+std::size_t LeakCfg::addNode(Kind kind, const Token *tok, const Ends &predecessors)
+{
+    mNodes.emplace_back(kind, tok);
+    connect(predecessors, mNodes.size() - 1);
+    return mNodes.size() - 1;
+}
+
+void LeakCfg::connect(const Ends &predecessors, std::size_t node)
+{
+    for (std::size_t p : predecessors)
+        mNodes[p].successors.push_back(node);
+}
+
+bool LeakCfg::build(const Token *tokens)
+{
+    Ends ends;
+    ends.push_back(addNode(NOP, tokens, Ends()));
+    const Token *tok = parseBlock(tokens, ends);
+    if (mBailout)
+        return false;
+
+    // end of checked scope
+    const Token *last = tok;
+    if (!last) {
+        last = tokens;
+        while (last->next())
+            last = last->next();
+    }
+    addNode(LEAVE, last, ends);
+    return true;
+}
+
+const Token *LeakCfg::parseBlock(const Token *tok, Ends &ends)
+{
+    while (tok && tok->str() != "}" && !mBailout)
+        tok = parseStatement(tok, ends);
+    return tok;
+}
+
+const Token *LeakCfg::parseStatement(const Token *tok, Ends &ends)
+{
+    const std::string &str = tok->str();
+
+    if (str == "{") {
+        ++mDepth;
+        tok = parseBlock(tok->next(), ends);
+        --mDepth;
+        if (!tok)
+            return nullptr;
+        if (!ends.empty())
+            ends.assign(1, addNode(ENDBLOCK, tok, ends));
+        return tok->next();
+    }
+    if (str == ";")
+        return tok->next();
+    if (Token::Match(tok, "if|if(var)|if(!var)|ifv"))
+        return parseIf(tok, ends);
+    if (Token::Match(tok, "loop|while1|while(var)|while(!var)"))
+        return parseLoop(tok, ends);
+    if (str == "do")
+        return parseDo(tok, ends);
+    if (str == "switch")
+        return parseSwitch(tok, ends);
+    if (str == "try")
+        return parseTry(tok, ends);
+    if (str == "goto") {
+        mBailout = true;
+        return nullptr;
+    }
+
+    // simple statement
+    for (; tok && !Token::Match(tok, "[;{}]"); tok = tok->next()) {
+        if (Token::Match(tok, "if|if(var)|if(!var)|ifv|loop|while1|while(var)|while(!var)|do|switch|try|goto"))
+            return tok;
+        if (tok->str() == "alloc")
+            ends.assign(1, addNode(ALLOC_, tok, ends));
+        else if (tok->str() == "dealloc")
+            ends.assign(1, addNode(DEALLOC, tok, ends));
+        else if (tok->str() == "use")
+            ends.assign(1, addNode(USE, tok, ends));
+        else if (tok->str() == "assign")
+            ends.assign(1, addNode(ASSIGN, tok, ends));
+        else if (tok->str() == "exit")
+            ends.assign(1, addNode(EXIT, tok, ends));
+        else if (tok->str() == "callfunc" && mDepth == 0 && Token::simpleMatch(tok, "callfunc ; }"))
+            // function call at end of scope might be noreturn
+            ends.assign(1, addNode(EXIT, tok, ends));
+        else if (Token::Match(tok, "return|break|continue|throw"))
+            return parseJump(tok, ends);
+    }
+    if (tok && tok->str() == ";")
+        tok = tok->next();
+    return tok;
+}
+
+const Token *LeakCfg::parseJump(const Token *tok, Ends &ends)
+{
+    const Token *jumpTok = tok;
+    if (Token::simpleMatch(tok, "return use")) {
+        ends.assign(1, addNode(USE, tok, ends));
+        tok = tok->next();
+    }
+    tok = tok->next();
+    if (tok && tok->str() == ";")
+        tok = tok->next();
+
+    if (jumpTok->str() == "throw" && mCpp && !mTry.empty()) {
+        // throw inside try block => continue in catch
+        addNode(NOP, jumpTok, ends);
+    } else if (Token::Match(jumpTok, "break|continue") && !mJumps.empty()) {
+        Jumps *jumps = &mJumps.back();
+        if (jumpTok->str() == "continue") {
+            for (std::vector<Jumps>::reverse_iterator it = mJumps.rbegin(); it != mJumps.rend(); ++it) {
+                if (it->isLoop) {
+                    jumps = &*it;
+                    break;
+                }
+            }
+        }
+        if (jumpTok->str() == "break" || jumps->isLoop) {
+            const std::size_t node = addNode(NOP, jumpTok, ends);
+            (jumpTok->str() == "break" ? jumps->breaks : jumps->continues).push_back(node);
+        } else {
+            addNode(LEAVE, jumpTok, ends);
+        }
+    } else {
+        addNode(LEAVE, jumpTok, ends);
+    }
+    ends.clear();
+    return tok;
+}
+
+const Token *LeakCfg::parseIf(const Token *tok, Ends &ends)
+{
+    const std::string &cond = tok->str();
+    const Token *ifTok = tok;
+    tok = tok->next();
+    while (Token::Match(tok, "callfunc|if"))
+        tok = tok->next();
+
+    Ends thenEnds(1, addNode(cond == "if(var)" ? NONNULL : cond == "if(!var)" ? ISNULL : cond == "ifv" ? UNKNOWN : NOP, ifTok, ends));
+    Ends elseEnds(1, addNode(cond == "if(var)" ? ISNULL : cond == "if(!var)" ? NONNULL : cond == "ifv" ? UNKNOWN : NOP, ifTok, ends));
+
+    if (tok && tok->str() != "}")
+        tok = parseStatement(tok, thenEnds);
+    if (tok && tok->str() == "else")
+        tok = parseStatement(tok->next(), elseEnds);
+
+    ends = thenEnds;
+    ends.insert(ends.end(), elseEnds.begin(), elseEnds.end());
+    return tok;
+}
+
+const Token *LeakCfg::parseLoop(const Token *tok, Ends &ends)
+{
+    const std::string &cond = tok->str();
+    const std::size_t head = addNode(NOP, tok, ends);
+    tok = tok->next();
+
+    // "loop !var" => the condition is "!var && ..", the body is only
+    // executed when the variable is null
+    const bool notvar = (tok && tok->str() == "!var");
+    if (notvar)
+        tok = tok->next();
+
+    Ends bodyEnds(1, head);
+    if (cond == "while(var)")
+        bodyEnds.assign(1, addNode(NONNULL, tok, bodyEnds));
+    else if (cond == "while(!var)" || notvar)
+        bodyEnds.assign(1, addNode(ISNULL, tok, bodyEnds));
+
+    mJumps.emplace_back(true);
+    if (tok && tok->str() != "}")
+        tok = parseStatement(tok, bodyEnds);
+    const Jumps jumps = mJumps.back();
+    mJumps.pop_back();
+
+    connect(bodyEnds, head);
+    connect(jumps.continues, head);
+
+    ends = jumps.breaks;
+    if (cond == "while(var)")
+        ends.push_back(addNode(ISNULL, tok, Ends(1, head)));
+    else if (cond == "while(!var)")
+        ends.push_back(addNode(NONNULL, tok, Ends(1, head)));
+    else if (cond != "while1")
+        ends.push_back(head);
+    return tok;
+}
+
+const Token *LeakCfg::parseDo(const Token *tok, Ends &ends)
+{
+    const std::size_t head = addNode(NOP, tok, ends);
+    Ends bodyEnds(1, head);
+
+    mJumps.emplace_back(true);
+    tok = tok->next();
+    if (tok && tok->str() != "}")
+        tok = parseStatement(tok, bodyEnds);
+    const Jumps jumps = mJumps.back();
+    mJumps.pop_back();
+
+    bodyEnds.insert(bodyEnds.end(), jumps.continues.begin(), jumps.continues.end());
+    const std::size_t condition = addNode(NOP, tok, bodyEnds);
+    ends = jumps.breaks;
+    if (Token::Match(tok, "loop|while1|while(var)|while(!var)")) {
+        const std::string &cond = tok->str();
+        if (cond == "while(var)") {
+            connect(Ends(1, addNode(NONNULL, tok, Ends(1, condition))), head);
+            ends.push_back(addNode(ISNULL, tok, Ends(1, condition)));
+        } else if (cond == "while(!var)") {
+            connect(Ends(1, addNode(ISNULL, tok, Ends(1, condition))), head);
+            ends.push_back(addNode(NONNULL, tok, Ends(1, condition)));
+        } else {
+            connect(Ends(1, condition), head);
+            if (cond != "while1")
+                ends.push_back(condition);
+        }
+        tok = tok->next();
+        if (tok && tok->str() == ";")
+            tok = tok->next();
+    } else {
+        ends.push_back(condition);
+    }
+    return tok;
+}
+
+const Token *LeakCfg::parseSwitch(const Token *tok, Ends &ends)
+{
+    const std::size_t head = addNode(NOP, tok, ends);
+    ends.assign(1, head);
+    tok = tok->next();
+    if (!tok || tok->str() != "{")
+        return tok;
+
+    mJumps.emplace_back(false);
+    ++mDepth;
+    bool hasDefault = false;
+    Ends caseEnds;
+    tok = tok->next();
+    while (tok && tok->str() != "}" && !mBailout) {
+        if (Token::Match(tok, "case|default")) {
+            hasDefault |= (tok->str() == "default");
+            Ends predecessors(caseEnds);
+            predecessors.push_back(head);
+            caseEnds.assign(1, addNode(NOP, tok, predecessors));
+            tok = tok->next();
+        } else {
+            tok = parseStatement(tok, caseEnds);
+        }
+    }
+    --mDepth;
+    const Jumps jumps = mJumps.back();
+    mJumps.pop_back();
+
+    ends = caseEnds;
+    ends.insert(ends.end(), jumps.breaks.begin(), jumps.breaks.end());
+    if (!hasDefault)
+        ends.push_back(head);
+    return tok ? tok->next() : nullptr;
+}
+
+const Token *LeakCfg::parseTry(const Token *tok, Ends &ends)
+{
+    const std::size_t tryNode = addNode(NOP, tok, ends);
+    Ends tryEnds(1, tryNode);
+
+    mTry.push_back(tryNode);
+    tok = tok->next();
+    if (tok && tok->str() != "}")
+        tok = parseStatement(tok, tryEnds);
+    mTry.pop_back();
+    const std::size_t tryEnd = mNodes.size();
+
+    ends = tryEnds;
+    while (tok && tok->str() == "catch") {
+        // exception can be thrown anywhere in the try block
+        const std::size_t catchNode = addNode(NOP, tok, Ends());
+        for (std::size_t node = tryNode; node < tryEnd; ++node) {
+            if (mNodes[node].kind != LEAVE)
+                mNodes[node].successors.push_back(catchNode);
+        }
+        Ends catchEnds(1, catchNode);
+        tok = tok->next();
+        if (tok && tok->str() != "}")
+            tok = parseStatement(tok, catchEnds);
+        ends.insert(ends.end(), catchEnds.begin(), catchEnds.end());
+    }
+    return tok;
+}
+
+const Token *LeakCfg::findleak(const Token **deallocDealloc) const
+{
+    std::vector<unsigned char> in(mNodes.size(), 0);
+    std::vector<std::size_t> worklist;
+    std::size_t leak = mNodes.size();
+    std::size_t dealloc2 = mNodes.size();
+
+    in[0] = NOALLOC;
+    worklist.push_back(0);
+    while (!worklist.empty()) {
+        const std::size_t n = worklist.back();
+        worklist.pop_back();
+        const Node &node = mNodes[n];
+        unsigned char out = in[n];
+        switch (node.kind) {
+        case NOP:
+            break;
+        case ALLOC_:
+            out = ALLOC;
+            break;
+        case ASSIGN:
+            out = NOALLOC;
+            break;
+        case DEALLOC:
+            out = FREED;
+            break;
+        case USE:
+            out = USED;
+            break;
+        case LEAVE:
+            out = 0;
+            break;
+        case EXIT:
+            out = 0;
+            break;
+        case NONNULL:
+        case ENDBLOCK:
+            break;
+        case ISNULL:
+            if (out & ALLOC)
+                out = (out & ~ALLOC) | NOALLOC;
+            break;
+        case UNKNOWN:
+            if (out & ALLOC)
+                out = (out & ~ALLOC) | USED;
+            break;
+        }
+        if (!out)
+            continue;
+        for (std::size_t s : node.successors) {
+            if ((in[s] | out) != in[s]) {
+                in[s] |= out;
+                worklist.push_back(s);
+            }
+        }
+    }
+
+    // All paths are known => check the state at each node. Like
+    // simplifycode(), a leak when the variable is overwritten is reported
+    // first. Otherwise the leak is reported at the last place where the
+    // memory is lost.
+    std::size_t leave = mNodes.size();
+    for (std::size_t n = 0; n < mNodes.size(); ++n) {
+        const Kind kind = mNodes[n].kind;
+        if ((kind == ALLOC_ || kind == ASSIGN) && isLeak(in[n]))
+            leak = std::min(leak, n);
+        else if (kind == LEAVE && isLeak(in[n]))
+            leave = n;
+        else if (kind == ENDBLOCK && in[n] == (ALLOC | FREED))
+            // conditionally deallocated in block => leak at end of block
+            leave = n;
+        else if (kind == DEALLOC && in[n] == FREED)
+            dealloc2 = std::min(dealloc2, n);
+    }
+    if (leak == mNodes.size())
+        leak = leave;
+
+    if (deallocDealloc)
+        *deallocDealloc = (dealloc2 < mNodes.size()) ? mNodes[dealloc2].tok : nullptr;
+    return (leak < mNodes.size()) ? mNodes[leak].tok : nullptr;
+}
+
+const Token *CheckMemoryLeakInFunction::findleakCfg(const Token *tokens, bool cpp, const Token **deallocDealloc, bool *bailout)
+{
+    LeakCfg cfg(cpp);
+    if (!cfg.build(tokens)) {
+        if (deallocDealloc)
+            *deallocDealloc = nullptr;
+        if (bailout)
+            *bailout = true;
+        return nullptr;
+    }
+    if (bailout)
+        *bailout = false;
+    return cfg.findleak(deallocDealloc);
+}
+
+
 // Check for memory leaks for a function variable.
 void CheckMemoryLeakInFunction::checkScope(const Token *startTok, const std::string &varname, unsigned int varid, bool classmember, unsigned int sz)
 {
@@ -2066,55 +2535,87 @@ void CheckMemoryLeakInFunction::checkScope(const Token *startTok, const std::str
         return;
     }
 
+    const Token *cfgLeak = nullptr;
+    const Token *cfgDeallocDealloc = nullptr;
+    bool cfgBailout = false;
+    if (mSettings->memleakEngine != Settings::MEMLEAK_SIMPLIFY) {
+        cfgLeak = findleakCfg(tok, mTokenizer->isCPP(), &cfgDeallocDealloc, &cfgBailout);
+
+        // if the cfg engine bails out, simplifycode() is used instead
+        if (mSettings->memleakEngine == Settings::MEMLEAK_CFG && !cfgBailout) {
+            if (cfgLeak)
+                memoryLeak(cfgLeak, varname, alloctype);
+            else if (!use_addr && cfgDeallocDealloc)
+                deallocDeallocError(cfgDeallocDealloc, varname);
+            TokenList::deleteTokens(tok);
+            return;
+        }
+    }
+
+    // The cfg engine doesn't modify the code. Remember the line numbers
+    // before simplifycode() deletes the tokens.
+    const unsigned int cfgLeakLine = cfgLeak ? cfgLeak->linenr() : 0U;
+    const unsigned int cfgDeallocDeallocLine = (!use_addr && cfgDeallocDealloc) ? cfgDeallocDealloc->linenr() : 0U;
+
     simplifycode(tok);
 
     if (mSettings->debugwarnings) {
         tok->printOut(("Checkmemoryleak: simplifycode result for: " + varname).c_str());
     }
 
+    result = nullptr;
+    const Token *deallocDealloc = nullptr;
+
     // If the variable is not allocated at all => no memory leak
-    if (Token::findsimplematch(tok, "alloc") == nullptr) {
-        TokenList::deleteTokens(tok);
-        return;
-    }
+    if (Token::findsimplematch(tok, "alloc")) {
+        /** @todo handle "goto" */
+        if (Token::findsimplematch(tok, "goto")) {
+            cfgBailout = true;
+        }
 
-    /** @todo handle "goto" */
-    if (Token::findsimplematch(tok, "goto")) {
-        TokenList::deleteTokens(tok);
-        return;
-    }
+        else if ((result = findleak(tok)) != nullptr) {
+            memoryLeak(result, varname, alloctype);
+        }
 
-    if ((result = findleak(tok)) != nullptr) {
-        memoryLeak(result, varname, alloctype);
-    }
+        else if (!use_addr && (deallocDealloc = Token::findsimplematch(tok, "dealloc ; dealloc ;")) != nullptr) {
+            deallocDeallocError(deallocDealloc->tokAt(2), varname);
+        }
 
-    else if (!use_addr && (result = Token::findsimplematch(tok, "dealloc ; dealloc ;")) != nullptr) {
-        deallocDeallocError(result->tokAt(2), varname);
+        // detect cases that "simplifycode" don't handle well..
+        else if (mSettings->debugwarnings) {
+            Token *first = tok;
+            while (first && first->str() == ";")
+                first = first->next();
+
+            bool noerr = false;
+            noerr = noerr || Token::simpleMatch(first, "alloc ; }");
+            noerr = noerr || Token::simpleMatch(first, "alloc ; dealloc ; }");
+            noerr = noerr || Token::simpleMatch(first, "alloc ; return use ; }");
+            noerr = noerr || Token::simpleMatch(first, "alloc ; use ; }");
+            noerr = noerr || Token::simpleMatch(first, "alloc ; use ; return ; }");
+            noerr = noerr || Token::simpleMatch(first, "alloc ; dealloc ; return ; }");
+            noerr = noerr || Token::simpleMatch(first, "if alloc ; dealloc ; }");
+            noerr = noerr || Token::simpleMatch(first, "if alloc ; return use ; }");
+            noerr = noerr || Token::simpleMatch(first, "if alloc ; use ; }");
+            noerr = noerr || Token::simpleMatch(first, "alloc ; ifv return ; dealloc ; }");
+            noerr = noerr || Token::simpleMatch(first, "alloc ; if return ; dealloc; }");
+
+            // Unhandled case..
+            if (!noerr)
+                reportError(first, Severity::debug, "debug",
+                            "inconclusive leak of " + varname + ": " + tok->stringifyList(false, false, false, false, false, nullptr, nullptr));
+        }
     }
 
-    // detect cases that "simplifycode" don't handle well..
-    else if (tok && mSettings->debugwarnings) {
-        Token *first = tok;
-        while (first && first->str() == ";")
-            first = first->next();
-
-        bool noerr = false;
-        noerr = noerr || Token::simpleMatch(first, "alloc ; }");
-        noerr = noerr || Token::simpleMatch(first, "alloc ; dealloc ; }");
-        noerr = noerr || Token::simpleMatch(first, "alloc ; return use ; }");
-        noerr = noerr || Token::simpleMatch(first, "alloc ; use ; }");
-        noerr = noerr || Token::simpleMatch(first, "alloc ; use ; return ; }");
-        noerr = noerr || Token::simpleMatch(first, "alloc ; dealloc ; return ; }");
-        noerr = noerr || Token::simpleMatch(first, "if alloc ; dealloc ; }");
-        noerr = noerr || Token::simpleMatch(first, "if alloc ; return use ; }");
-        noerr = noerr || Token::simpleMatch(first, "if alloc ; use ; }");
-        noerr = noerr || Token::simpleMatch(first, "alloc ; ifv return ; dealloc ; }");
-        noerr = noerr || Token::simpleMatch(first, "alloc ; if return ; dealloc; }");
-
-        // Unhandled case..
-        if (!noerr)
-            reportError(first, Severity::debug, "debug",
-                        "inconclusive leak of " + varname + ": " + tok->stringifyList(false, false, false, false, false, nullptr, nullptr));
+    // Compare the verdicts of the two engines
+    if (mSettings->memleakEngine == Settings::MEMLEAK_COMPARE && !cfgBailout) {
+        const unsigned int leakLine = result ? result->linenr() : 0U;
+        const unsigned int deallocDeallocLine = (!result && deallocDealloc) ? deallocDealloc->tokAt(2)->linenr() : 0U;
+        if (leakLine != cfgLeakLine || deallocDeallocLine != (cfgLeakLine ? 0U : cfgDeallocDeallocLine)) {
+            reportError(tok, Severity::debug, "debug",
+                        "memleak engines disagree for " + varname + ": simplifycode leak line " + MathLib::toString(leakLine) +
+                        ", cfg leak line " + MathLib::toString(cfgLeakLine));
+        }
     }
 
     TokenList::deleteTokens(tok);
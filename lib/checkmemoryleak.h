@@ -266,6 +266,18 @@ public:
 
     static const Token *findleak(const Token *tokens);
 
+    /**
+     * Find leak in the code returned by getcode() without simplifying it.
+     * A control flow graph is created for the code and the allocation state
+     * is propagated through it.
+     * @param tokens code returned by getcode()
+     * @param cpp c++ code
+     * @param deallocDealloc output: token where the variable is deallocated twice
+     * @param bailout output: set when the code can't be handled (goto)
+     * @return token where the leak occurs, nullptr if there is no leak
+     */
+    static const Token *findleakCfg(const Token *tokens, bool cpp, const Token **deallocDealloc, bool *bailout);
+
     /**
      * Checking the variable varname
      * @param startTok start token
@@ -801,7 +801,6 @@ void CheckOther::checkUnreachableCode()
     for (const Scope * scope : symbolDatabase->functionScopes) {
         for (const Token* tok = scope->bodyStart; tok && tok != scope->bodyEnd; tok = tok->next()) {
             const Token* secondBreak = nullptr;
-            const Token* labelName = nullptr;
             if (tok->link() && Token::Match(tok, "(|[|<"))
                 tok = tok->link();
             else if (Token::Match(tok, "break|continue ;"))
@@ -818,10 +817,9 @@ void CheckOther::checkUnreachableCode()
                         break;
                     }
                 }
-            } else if (Token::Match(tok, "goto %any% ;")) {
+            } else if (Token::Match(tok, "goto %any% ;"))
                 secondBreak = tok->tokAt(3);
-                labelName = tok->next();
-            } else if (Token::Match(tok, "%name% (") && mSettings->library.isnoreturn(tok) && !Token::Match(tok->next()->astParent(), "?|:")) {
+            else if (Token::Match(tok, "%name% (") && mSettings->library.isnoreturn(tok) && !Token::Match(tok->next()->astParent(), "?|:")) {
                 if ((!tok->function() || (tok->function()->token != tok && tok->function()->tokenDef != tok)) && tok->linkAt(1)->strAt(1) != "{")
                     secondBreak = tok->linkAt(1)->tokAt(2);
             }
@@ -844,20 +842,16 @@ void CheckOther::checkUnreachableCode()
                     }
                     tok = Token::findmatch(secondBreak, "[}:]");
                 } else if (!Token::Match(secondBreak, "return|}|case|default") && secondBreak->strAt(1) != ":") { // TODO: No bailout for unconditional scopes
-                    // If the goto label is followed by a loop construct in which the label is defined it's quite likely
-                    // that the goto jump was intended to skip some code on the first loop iteration.
-                    bool labelInFollowingLoop = false;
-                    if (labelName && Token::Match(secondBreak, "while|do|for")) {
-                        const Token *scope2 = Token::findsimplematch(secondBreak, "{");
-                        if (scope2) {
-                            for (const Token *tokIter = scope2; tokIter != scope2->link() && tokIter; tokIter = tokIter->next()) {
-                                if (Token::Match(tokIter, "[;{}] %any% :") && labelName->str() == tokIter->strAt(1)) {
-                                    labelInFollowingLoop = true;
-                                    break;
-                                }
-                            }
-                        }
-                    }
+                    // The code can still be reached through a jump, for instance a goto to a label in a following
+                    // loop that skips some code on the first loop iteration. "do" and braces are not in any block.
+                    const Scope *functionScope = secondBreak->scope();
+                    while (functionScope && functionScope->type != Scope::eFunction && functionScope->type != Scope::eLambda)
+                        functionScope = functionScope->nestedIn;
+                    const ControlFlowGraph *cfg = symbolDatabase->controlFlowGraph(functionScope);
+                    const Token *blockToken = secondBreak;
+                    while (cfg && blockToken && blockToken != scope->bodyEnd && Token::Match(blockToken, "do|{") && cfg->blockOf(blockToken) == ControlFlowGraph::NONE)
+                        blockToken = blockToken->next();
+                    const bool reachable = cfg && cfg->isReachable(cfg->blockOf(blockToken));
 
                     // hide FP for statements that just hide compiler warnings about unused function arguments
                     bool silencedCompilerWarningOnly = false;
@@ -874,7 +868,7 @@ void CheckOther::checkUnreachableCode()
                     if (silencedWarning)
                         secondBreak = silencedWarning;
 
-                    if (!labelInFollowingLoop && !silencedCompilerWarningOnly)
+                    if (!reachable && !silencedCompilerWarningOnly)
                         unreachableCodeError(secondBreak, inconclusive);
                     tok = Token::findmatch(secondBreak, "[}:]");
                 } else
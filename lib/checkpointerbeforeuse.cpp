@@ -175,7 +175,7 @@ bool CheckPointerBeforeUse::isSkip(const Token* tok) {
 
 bool CheckPointerBeforeUse::isContainerType(const Token* tok) {
     bool isContainerType = false;
-    if (!(tok && tok->variable())) {
+    if (!(mConfig && tok && tok->variable())) {
         return isContainerType;
     }
 
@@ -183,8 +183,7 @@ bool CheckPointerBeforeUse::isContainerType(const Token* tok) {
          tokType && tokType != tok->variable()->typeEndToken();
          tokType = tokType->next()) {
 
-        auto res = std::find(mFilterContainerType.begin(), mFilterContainerType.end(), tokType->str());
-        if (res != mFilterContainerType.end()){
+        if (mConfig->containerTypes.count(tokType->str()) > 0) {
             isContainerType = true;
             break;
         }
@@ -265,15 +264,12 @@ bool CheckPointerBeforeUse::resultReview() {
 
 /** the format of the configure: 
  */
-void CheckPointerBeforeUse::loadConf(const YAML::Node &configure) {
-    if (!configure["CheckPointerBeforeUse"]) {
-        return;
-    }
-
-    for (const auto& it_ct: configure["CheckPointerBeforeUse"]["containerType"]) {
-        mFilterContainerType.push_back(it_ct.as<std::string>());
-        //std::cout << it_ct.as<std::string>() << std::endl;
+std::shared_ptr<const CheckConfig> CheckPointerBeforeUse::loadConfig(const YAML::Node &node) const {
+    std::shared_ptr<Config> config = std::make_shared<Config>();
+    for (const auto& it_ct: node["containerType"]) {
+        config->containerTypes.insert(it_ct.as<std::string>());
     }
+    return config;
 }
 
 
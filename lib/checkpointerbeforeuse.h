@@ -22,6 +22,8 @@
 #define checkpointerbeforeuseH
 //---------------------------------------------------------------------------
 #include <map>
+#include <set>
+#include <string>
 #include <utility>
 
 #include "config.h"
@@ -35,12 +37,11 @@
 class CPPCHECKLIB CheckPointerBeforeUse : public Check {
 public:
     /** This constructor is used when registering the CheckClass */
-    CheckPointerBeforeUse() : Check(myName()) {}
+    CheckPointerBeforeUse() : Check(myName()), mConfig(nullptr) {}
 
     /** This constructor is used when running checks. */
     CheckPointerBeforeUse(const Tokenizer* tokenizer, const Settings* settings, ErrorLogger* errorLogger)
-        : Check(myName(), tokenizer, settings, errorLogger) {
-                loadConf(settings->userRuleConfigure);
+        : Check(myName(), tokenizer, settings, errorLogger), mConfig(config<Config>()) {
     }
     
     void runSimplifiedChecks(const Tokenizer* tokenizer, const Settings* settings,
@@ -53,8 +54,19 @@ public:
     void wrongUse();
     void getErrorMessages(ErrorLogger* errorLogger, const Settings* settings) const override {}
 
+    std::shared_ptr<const CheckConfig> loadConfig(const YAML::Node &node) const override;
+
 private:
-    void loadConf(const YAML::Node &configure);
+    /** the format of the configure:
+     * CheckPointerBeforeUse:
+     *   containerType:
+     *     - 'vector'
+     */
+    struct Config : public CheckConfig {
+        /** variables of these types are not checked */
+        std::set<std::string> containerTypes;
+    };
+
     void report_error_info(const Token* tok);
     void report_warning_info(const Token* tok);
     bool isSkip(const Token* tok);
@@ -100,14 +112,14 @@ private:
     bool resultReview();
     std::string getTokenString(const Token* begin, const Token* end) const;
     std::string classInfo() const override {
-        return "test";
+        return "Check that pointers are checked against null before they are dereferenced.\n";
     }
     static std::string myName() {
         return "CheckPointerBeforeUse";
     }
 
 private:
-    std::vector<std::string> mFilterContainerType;
+    const Config *mConfig;
 };
 /// @}
 //---------------------------------------------------------------------------
@@ -39,39 +39,37 @@ static const CWE CWE398(398U);  // Indicator of Poor Code Quality
 static const CWE CWE562(562U);  // Return of Stack Variable Address
 static const CWE CWE590(590U);  // Free of Memory not on the Heap
 
-std::set<CheckTryCatchFunc::sExceptInfo, CheckTryCatchFunc::sExceptComp> CheckTryCatchFunc::_except_info;
-
 // 需要根据具体的业务代码需求来设计
 bool CheckTryCatchFunc::is_target(const Token *tok, std::set<std::string>& exception_patterns) {
-    for (auto& ex : _except_info) {
-        for (auto& func : ex.func_names) {
-            if (Token::Match(tok, (func + " (").c_str()) && tok->linkAt(1)) {
-                if (ex.class_name.empty()) {//any type
-                    if (tok->strAt(-1) == "." && tok->tokAt(-1) && !(tok->tokAt(-1)->isLiteral())) {
-                        exception_patterns = ex.exception_patterns;
-                        return true;
-                    }
-                }
-                else if (ex.class_name == "::") {//gloable function
-                    if (tok->strAt(-1) != ".") {
-                        exception_patterns = ex.exception_patterns;
-                        return true;
-                    }
-                }
-                else {
-                    const Token* var_tok = tok->astParent()->astOperand1();
+    for (std::size_t i = mConfig->functions.findMatch(tok); i != TokenPatternTable::npos; i = mConfig->functions.findMatch(tok, i + 1)) {
+        if (!tok->linkAt(1)) {
+            continue;
+        }
+        const sExceptInfo& ex = *mConfig->functionInfo[i];
+        if (ex.class_name.empty()) {//any type
+            if (tok->strAt(-1) == "." && tok->tokAt(-1) && !(tok->tokAt(-1)->isLiteral())) {
+                exception_patterns = ex.exception_patterns;
+                return true;
+            }
+        }
+        else if (ex.class_name == "::") {//gloable function
+            if (tok->strAt(-1) != ".") {
+                exception_patterns = ex.exception_patterns;
+                return true;
+            }
+        }
+        else {
+            const Token* var_tok = tok->astParent()->astOperand1();
 
-                    if (!var_tok || !var_tok->variable()) {
-                        return false;
-                    }
+            if (!var_tok || !var_tok->variable()) {
+                return false;
+            }
 
-                    const std::string type_str = var_tok->str();
+            const std::string type_str = var_tok->str();
 
-                    if (type_str.find(ex.class_name) != std::string::npos) {
-                         exception_patterns = ex.exception_patterns;
-                         return  true;
-                    }
-                }
+            if (type_str.find(ex.class_name) != std::string::npos) {
+                 exception_patterns = ex.exception_patterns;
+                 return  true;
             }
         }
     }
@@ -203,12 +201,9 @@ bool CheckTryCatchFunc::check_single_catch_exception_type(const Token* catchToke
  *     - 'boost :: bad_lexical_cast'
  *     - 'bad_lexical_cast'
  */
-void CheckTryCatchFunc::loadConf(const YAML::Node &configure) {
-    if (!configure["CheckTryCatchFunc"]) {
-        return;
-    }
-
-    for (const auto& it: configure["CheckTryCatchFunc"]) {
+std::shared_ptr<const CheckConfig> CheckTryCatchFunc::loadConfig(const YAML::Node &node) const {
+    std::shared_ptr<Config> config = std::make_shared<Config>();
+    for (const auto& it: node) {
         sExceptInfo info;
         info.class_name = it["class"].as<std::string>();
 
@@ -220,8 +215,17 @@ void CheckTryCatchFunc::loadConf(const YAML::Node &configure) {
             info.exception_patterns.insert(it_e.as<std::string>());
         }
         
-        _except_info.insert(info);
+        config->exceptInfo.insert(info);
+    }
+
+    // Index the function patterns by their first token. They are tried in the order of exceptInfo.
+    for (const auto& ex : config->exceptInfo) {
+        for (const auto& func : ex.func_names) {
+            config->functions.add(func + " (");
+            config->functionInfo.push_back(&ex);
+        }
     }
+    return config;
 }
 
 void CheckTryCatchFunc::report_error_info(const Token* tok) {
@@ -24,10 +24,12 @@
 
 #include "config.h"
 #include "check.h"
+#include "tokenpatterntable.h"
 #include <vector>
 #include <set>
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 
 /// @addtogroup Checks
@@ -37,12 +39,11 @@
 class CPPCHECKLIB CheckTryCatchFunc : public Check {
 public:
     /** This constructor is used when registering the CheckClass */
-    CheckTryCatchFunc() : Check(myName()) {}
+    CheckTryCatchFunc() : Check(myName()), mConfig(nullptr) {}
 
     /** This constructor is used when running checks. */
     CheckTryCatchFunc(const Tokenizer* tokenizer, const Settings* settings, ErrorLogger* errorLogger)
-        : Check(myName(), tokenizer, settings, errorLogger) {
-                loadConf(settings->userRuleConfigure);
+        : Check(myName(), tokenizer, settings, errorLogger), mConfig(config<Config>()) {
                 beginpattern = "try";
                 endpattern = "catch";
                 allexceptiontypepattern = ". . .";
@@ -57,8 +58,9 @@ public:
     void wrongUse();
     void getErrorMessages(ErrorLogger* errorLogger, const Settings* settings) const override {}
 
+    std::shared_ptr<const CheckConfig> loadConfig(const YAML::Node &node) const override;
+
 private:
-    void loadConf(const YAML::Node &configure);
     bool is_target(const Token *tok, std::set<std::string>& exception_patterns);
     void report_error_info(const Token* tok);
     void report_warning_info(const Token* tok);
@@ -67,7 +69,7 @@ private:
     bool check_single_catch_exception_type(const Token* catchToken);
     
     bool is_check_filter() {
-        if (_except_info.empty()) {
+        if (!mConfig || mConfig->exceptInfo.empty()) {
             std::cout << "can not find configure for CheckTryCatchFunc, this check will be filter" << std::endl;
             return true;
         }
@@ -110,11 +112,19 @@ private:
         }
     };
 
+    struct Config : public CheckConfig {
+        std::set<sExceptInfo, sExceptComp> exceptInfo;
+        /** "function (" patterns of all exceptInfo entries */
+        TokenPatternTable functions;
+        /** the exceptInfo entry of each pattern in functions */
+        std::vector<const sExceptInfo *> functionInfo;
+    };
+
     std::string beginpattern;
     std::string endpattern;
     std::string allexceptiontypepattern;
     std::set<std::string> exceptiontypepattern;
-    static std::set<sExceptInfo, sExceptComp> _except_info;
+    const Config *mConfig;
 };
 /// @}
 //---------------------------------------------------------------------------
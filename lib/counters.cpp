@@ -0,0 +1,190 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "counters.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#if defined(HAVE_COUNTERS) && defined(__GNUC__) && defined(__GLIBC__)
+#define USE_BACKTRACE_SYMBOLS
+#include <execinfo.h>
+#endif
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    typedef std::map<std::string, unsigned long> NamedCounters;
+
+    struct Data {
+        /** category => literal address => count */
+        std::map<const char *, std::map<const char *, unsigned long> > literals;
+        /** category => name => count */
+        std::map<std::string, NamedCounters> names;
+        /** category => return address => count */
+        std::map<const char *, std::map<const void *, unsigned long> > callSites;
+
+        ~Data();
+    };
+
+    Data &data()
+    {
+        static Data d;
+        return d;
+    }
+
+    std::string callSiteName(const void *address)
+    {
+#ifdef USE_BACKTRACE_SYMBOLS
+        void *addresses[1] = { const_cast<void *>(address) };
+        char **symbols = backtrace_symbols(addresses, 1);
+        if (symbols) {
+            const std::string ret(symbols[0]);
+            std::free(symbols);
+            return ret;
+        }
+#endif
+        std::ostringstream ostr;
+        ostr << address;
+        return ostr.str();
+    }
+
+    /** all counters by category, literals and call sites are converted to names */
+    std::map<std::string, NamedCounters> allCounters()
+    {
+        std::map<std::string, NamedCounters> ret(data().names);
+        for (std::map<const char *, std::map<const char *, unsigned long> >::const_iterator it = data().literals.begin(); it != data().literals.end(); ++it) {
+            NamedCounters &counters = ret[it->first];
+            for (std::map<const char *, unsigned long>::const_iterator it2 = it->second.begin(); it2 != it->second.end(); ++it2)
+                counters[it2->first] += it2->second;
+        }
+        for (std::map<const char *, std::map<const void *, unsigned long> >::const_iterator it = data().callSites.begin(); it != data().callSites.end(); ++it) {
+            NamedCounters &counters = ret[it->first];
+            for (std::map<const void *, unsigned long>::const_iterator it2 = it->second.begin(); it2 != it->second.end(); ++it2)
+                counters[callSiteName(it2->first)] += it2->second;
+        }
+        return ret;
+    }
+
+    bool moreCounts(const std::pair<std::string, unsigned long> &lhs, const std::pair<std::string, unsigned long> &rhs)
+    {
+        if (lhs.second != rhs.second)
+            return lhs.second > rhs.second;
+        return lhs.first < rhs.first;
+    }
+
+    std::string jsonString(const std::string &s)
+    {
+        std::string ret("\"");
+        for (std::string::size_type i = 0; i < s.size(); ++i) {
+            const unsigned char c = s[i];
+            if (c == '\"' || c == '\\') {
+                ret += '\\';
+                ret += c;
+            } else if (c < 0x20) {
+                char buf[8];
+                std::sprintf(buf, "\\u%04x", c);
+                ret += buf;
+            } else {
+                ret += c;
+            }
+        }
+        return ret + '\"';
+    }
+
+    Data::~Data()
+    {
+#ifdef HAVE_COUNTERS
+        if (literals.empty() && names.empty() && callSites.empty())
+            return;
+        const char *env = std::getenv("CPPCHECK_COUNTERS_FILE");
+        std::string filename;
+        if (env && *env)
+            filename = env;
+        else {
+            std::ostringstream ostr;
+#ifdef _WIN32
+            ostr << "cppcheck-counters-" << _getpid() << ".json";
+#else
+            ostr << "cppcheck-counters-" << getpid() << ".json";
+#endif
+            filename = ostr.str();
+        }
+        std::ofstream fout(filename.c_str());
+        if (fout.is_open())
+            Counters::writeJson(fout);
+#endif
+    }
+}
+
+void Counters::countLiteral(const char *category, const char *name, unsigned long n)
+{
+    data().literals[category][name] += n;
+}
+
+void Counters::count(const char *category, const std::string &name, unsigned long n)
+{
+    data().names[category][name] += n;
+}
+
+void Counters::countCallSite(const char *category, const void *returnAddress)
+{
+    ++data().callSites[category][returnAddress];
+}
+
+unsigned long Counters::get(const char *category, const std::string &name)
+{
+    const std::map<std::string, NamedCounters> counters = allCounters();
+    const std::map<std::string, NamedCounters>::const_iterator it = counters.find(category);
+    if (it == counters.end())
+        return 0;
+    const NamedCounters::const_iterator it2 = it->second.find(name);
+    return it2 == it->second.end() ? 0 : it2->second;
+}
+
+void Counters::writeJson(std::ostream &out)
+{
+    const std::map<std::string, NamedCounters> counters = allCounters();
+    out << "{";
+    for (std::map<std::string, NamedCounters>::const_iterator it = counters.begin(); it != counters.end(); ++it) {
+        std::vector<std::pair<std::string, unsigned long> > sorted(it->second.begin(), it->second.end());
+        std::sort(sorted.begin(), sorted.end(), moreCounts);
+        out << (it == counters.begin() ? "\n" : ",\n") << "  " << jsonString(it->first) << ": {";
+        for (std::size_t i = 0; i < sorted.size(); ++i)
+            out << (i == 0 ? "\n" : ",\n") << "    " << jsonString(sorted[i].first) << ": " << sorted[i].second;
+        out << "\n  }";
+    }
+    out << "\n}\n";
+}
+
+void Counters::reset()
+{
+    data().literals.clear();
+    data().names.clear();
+    data().callSites.clear();
+}
@@ -0,0 +1,80 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+//---------------------------------------------------------------------------
+#ifndef countersH
+#define countersH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <ostream>
+#include <string>
+
+/**
+ * Hot path counters. The counters are only updated when cppcheck is
+ * compiled with HAVE_COUNTERS; otherwise the COUNTER_ macros expand to
+ * nothing. The results are written as JSON when the process exits, to
+ * the file named by the CPPCHECK_COUNTERS_FILE environment variable or
+ * to cppcheck-counters-<pid>.json.
+ *
+ * Like the --showtime results the counters are not synchronised, so use
+ * a single thread (-j is fine on platforms where cppcheck forks).
+ */
+namespace Counters {
+    /** Count event. The name must be a string literal, it is counted by address. */
+    CPPCHECKLIB void countLiteral(const char *category, const char *name, unsigned long n = 1);
+
+    /** Count event */
+    CPPCHECKLIB void count(const char *category, const std::string &name, unsigned long n = 1);
+
+    /**
+     * Count call from given return address. The address is written as
+     * the calling function and the offset in it, so a hot pattern can be
+     * traced to the function that matches it.
+     */
+    CPPCHECKLIB void countCallSite(const char *category, const void *returnAddress);
+
+    /** Current value of counter */
+    CPPCHECKLIB unsigned long get(const char *category, const std::string &name);
+
+    /** Write all counters as JSON, counters with the highest count first */
+    CPPCHECKLIB void writeJson(std::ostream &out);
+
+    CPPCHECKLIB void reset();
+}
+
+#ifdef HAVE_COUNTERS
+#if defined(__GNUC__)
+#define COUNTER_RETURN_ADDRESS __builtin_return_address(0)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define COUNTER_RETURN_ADDRESS _ReturnAddress()
+#else
+#define COUNTER_RETURN_ADDRESS nullptr
+#endif
+#define COUNTER_LITERAL(category, name)  Counters::countLiteral(category, name)
+#define COUNTER_NAME(category, name)     Counters::count(category, name)
+#define COUNTER_CALLSITE(category)       Counters::countCallSite(category, COUNTER_RETURN_ADDRESS)
+#else
+#define COUNTER_LITERAL(category, name)
+#define COUNTER_NAME(category, name)
+#define COUNTER_CALLSITE(category)
+#endif
+
+//---------------------------------------------------------------------------
+#endif // countersH
@@ -19,11 +19,14 @@
 
 #include "check.h"
 #include "checkunusedfunctions.h"
+#include "dumpwriter.h"
 #include "library.h"
 #include "mathlib.h"
 #include "path.h"
 #include "platform.h"
 #include "preprocessor.h" // Preprocessor
+#include "rulematcher.h"
+#include "subprocess.h"
 #include "suppressions.h"
 #include "timer.h"
 #include "token.h"
@@ -34,17 +37,17 @@
 #include <simplecpp.h>
 #include <tinyxml2.h>
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <ctime>
+#include <memory>
 #include <new>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 #include <vector>
 
-#ifdef HAVE_RULES
-#define PCRE_STATIC
-#include <pcre.h>
-#endif
-
 static const char Version[] = CPPCHECK_VERSION_STRING;
 static const char ExtraVersion[] = "";
 
@@ -105,6 +108,20 @@ unsigned int CppCheck::check(const ImportProject::FileSettings &fs)
     return temp.checkFile(Path::simplifyPath(fs.filename), fs.cfg, fin);
 }
 
+static void addDegradedStage(std::vector<std::string> &stages, const std::string &stage)
+{
+    if (std::find(stages.begin(), stages.end(), stage) == stages.end())
+        stages.push_back(stage);
+}
+
+static void addValueFlowStage(const Tokenizer &tokenizer, std::vector<std::string> &stages, bool &valueFlowTimeout)
+{
+    if (tokenizer.isValueFlowBudgetExceeded())
+        addDegradedStage(stages, "ValueFlow iterations");
+    else if (tokenizer.isValueFlowIncomplete())
+        valueFlowTimeout = true;
+}
+
 unsigned int CppCheck::checkFile(const std::string& filename, const std::string &cfgname, std::istream& fileStream)
 {
     mExitCode = 0;
@@ -146,6 +163,16 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
 
     CheckUnusedFunctions checkUnusedFunctions(nullptr, nullptr, nullptr);
 
+    // estimated cost of checking all configurations
+    std::size_t fileCost = 0;
+
+    // When the time budget is exceeded the file is checked in cheaper
+    // modes, these are the stages that were degraded
+    const std::time_t deadline = mSettings.maxTimePerFile ? std::time(0) + mSettings.maxTimePerFile : 0;
+    std::vector<std::string> degradedStages;
+    // the ValueFlow analysis was stopped by its built-in time limit
+    bool valueFlowTimeout = false;
+
     bool internalErrorFound(false);
     try {
         Preprocessor preprocessor(mSettings, this);
@@ -200,41 +227,66 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
             plistFile << ErrorLogger::plistHeader(version(), files);
         }
 
-        // write dump file xml prolog
+        // write dump file prolog
         std::ofstream fdump;
+        std::ostringstream addonDump;
+        std::string dumpfile;
+        std::unique_ptr<DumpWriter> dumpWriter;
         if (mSettings.dump) {
-            const std::string dumpfile(mSettings.dumpFile.empty() ? (filename + ".dump") : mSettings.dumpFile);
-            fdump.open(dumpfile);
-            if (fdump.is_open()) {
-                fdump << "<?xml version=\"1.0\"?>" << std::endl;
-                fdump << "<dumps>" << std::endl;
-                fdump << "  <platform"
-                      << " name=\"" << mSettings.platformString() << '\"'
-                      << " char_bit=\"" << mSettings.char_bit << '\"'
-                      << " short_bit=\"" << mSettings.short_bit << '\"'
-                      << " int_bit=\"" << mSettings.int_bit << '\"'
-                      << " long_bit=\"" << mSettings.long_bit << '\"'
-                      << " long_long_bit=\"" << mSettings.long_long_bit << '\"'
-                      << " pointer_bit=\"" << (mSettings.sizeof_pointer * mSettings.char_bit) << '\"'
-                      << "/>\n";
-                fdump << "  <rawtokens>" << std::endl;
-                for (unsigned int i = 0; i < files.size(); ++i)
-                    fdump << "    <file index=\"" << i << "\" name=\"" << ErrorLogger::toxml(files[i]) << "\"/>" << std::endl;
-                for (const simplecpp::Token *tok = tokens1.cfront(); tok; tok = tok->next) {
-                    fdump << "    <tok "
-                          << "fileIndex=\"" << tok->location.fileIndex << "\" "
-                          << "linenr=\"" << tok->location.line << "\" "
-                          << "str=\"" << ErrorLogger::toxml(tok->str()) << "\""
-                          << "/>" << std::endl;
+            dumpfile = mSettings.dumpFile.empty() ? (filename + ".dump") : mSettings.dumpFile;
+            if (mSettings.dumpFormat == Settings::DUMP_BINARY) {
+                fdump.open(dumpfile, std::ios::out | std::ios::binary);
+                if (fdump.is_open())
+                    dumpWriter.reset(new BinaryDumpWriter(fdump));
+            } else {
+                fdump.open(dumpfile);
+                if (fdump.is_open()) {
+                    XmlDumpWriter *xmlWriter = new XmlDumpWriter(fdump);
+                    xmlWriter->prolog();
+                    dumpWriter.reset(xmlWriter);
                 }
-                fdump << "  </rawtokens>" << std::endl;
             }
+            if (!dumpWriter) {
+                dumpFileError(filename, dumpfile);
+                dumpfile.clear();
+            }
+        }
+        if (!dumpWriter && !mSettings.addons.empty()) {
+            // the addons read the dump from a pipe
+            dumpWriter.reset(new BinaryDumpWriter(addonDump));
+        }
+        if (dumpWriter) {
+            dumpWriter->startElement("dumps");
+            dumpWriter->startElement("platform");
+            dumpWriter->rawAttribute("name", mSettings.platformString());
+            dumpWriter->attribute("char_bit", mSettings.char_bit);
+            dumpWriter->attribute("short_bit", mSettings.short_bit);
+            dumpWriter->attribute("int_bit", mSettings.int_bit);
+            dumpWriter->attribute("long_bit", mSettings.long_bit);
+            dumpWriter->attribute("long_long_bit", mSettings.long_long_bit);
+            dumpWriter->attribute("pointer_bit", mSettings.sizeof_pointer * mSettings.char_bit);
+            dumpWriter->endElement();
+            dumpWriter->startElement("rawtokens");
+            for (unsigned int i = 0; i < files.size(); ++i) {
+                dumpWriter->startElement("file");
+                dumpWriter->attribute("index", i);
+                dumpWriter->attribute("name", files[i]);
+                dumpWriter->endElement();
+            }
+            for (const simplecpp::Token *tok = tokens1.cfront(); tok; tok = tok->next) {
+                dumpWriter->startElement("tok");
+                dumpWriter->attribute("fileIndex", tok->location.fileIndex);
+                dumpWriter->attribute("linenr", tok->location.line);
+                dumpWriter->attribute("str", tok->str());
+                dumpWriter->endElement();
+            }
+            dumpWriter->endElement();
         }
 
         // Parse comments and then remove them
         preprocessor.inlineSuppressions(tokens1);
-        if (mSettings.dump && fdump.is_open()) {
-            mSettings.nomsg.dump(fdump);
+        if (dumpWriter) {
+            mSettings.nomsg.dump(*dumpWriter);
         }
         tokens1.removeComments();
         preprocessor.removeComments();
@@ -324,6 +376,12 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
             if (!mSettings.force && ++checkCount > mSettings.maxConfigs)
                 break;
 
+            // Skip the remaining configurations if the time budget is exceeded
+            if (hasValidConfig && deadline != 0 && std::time(0) >= deadline) {
+                addDegradedStage(degradedStages, "configurations");
+                break;
+            }
+
             mCurrentConfig = currCfg;
 
             if (!mSettings.userDefines.empty()) {
@@ -355,6 +413,7 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
             Tokenizer mTokenizer(&mSettings, this);
             if (mSettings.showtime != SHOWTIME_NONE)
                 mTokenizer.setTimerResults(&S_timerResults);
+            mTokenizer.setDeadline(deadline);
 
             try {
                 bool result;
@@ -387,15 +446,17 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
                 Timer timer2("Tokenizer::simplifyTokens1", mSettings.showtime, &S_timerResults);
                 result = mTokenizer.simplifyTokens1(mCurrentConfig);
                 timer2.Stop();
+                addValueFlowStage(mTokenizer, degradedStages, valueFlowTimeout);
                 if (!result)
                     continue;
 
-                // dump xml if --dump
-                if (mSettings.dump && fdump.is_open()) {
-                    fdump << "<dump cfg=\"" << ErrorLogger::toxml(mCurrentConfig) << "\">" << std::endl;
-                    preprocessor.dump(fdump);
-                    mTokenizer.dump(fdump);
-                    fdump << "</dump>" << std::endl;
+                // dump data if --dump
+                if (dumpWriter) {
+                    dumpWriter->startElement("dump");
+                    dumpWriter->attribute("cfg", mCurrentConfig);
+                    preprocessor.dump(*dumpWriter);
+                    mTokenizer.dump(*dumpWriter);
+                    dumpWriter->endElement();
                 }
 
                 // Skip if we already met the same simplified token list
@@ -409,6 +470,12 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
                     checksums.insert(checksum);
                 }
 
+                const std::size_t cost = mTokenizer.estimateCost();
+                fileCost += cost;
+                mErrorLogger.reportFileCost(filename, mCurrentConfig, cost);
+                const std::size_t memory = mTokenizer.memoryUsage();
+                mErrorLogger.reportMemoryUsage(filename, mCurrentConfig, memory);
+
                 // Check normal tokens
                 checkNormalTokens(mTokenizer);
 
@@ -417,11 +484,16 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
                     checkUnusedFunctions.parseTokens(mTokenizer, filename.c_str(), &mSettings);
 
                 // simplify more if required, skip rest of iteration if failed
-                if (mSimplify) {
+                if (mSimplify && ((deadline != 0 && std::time(0) >= deadline) ||
+                                  (mSettings.maxMemoryPerFile && memory > mSettings.maxMemoryPerFile))) {
+                    // the time or memory budget is exceeded
+                    addDegradedStage(degradedStages, "simplified checks");
+                } else if (mSimplify) {
                     // if further simplification fails then skip rest of iteration
                     Timer timer3("Tokenizer::simplifyTokenList2", mSettings.showtime, &S_timerResults);
                     result = mTokenizer.simplifyTokenList2();
                     timer3.Stop();
+                    addValueFlowStage(mTokenizer, degradedStages, valueFlowTimeout);
                     if (!result)
                         continue;
 
@@ -436,6 +508,12 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
                 continue;
 
             } catch (const InternalError &e) {
+                if (e.type == InternalError::LIMIT) {
+                    // the configuration needs more memory than the budget allows
+                    addDegradedStage(degradedStages, "aborted configurations");
+                    continue;
+                }
+
                 std::list<ErrorLogger::ErrorMessage::FileLocation> locationList;
                 ErrorLogger::ErrorMessage::FileLocation loc;
                 if (e.token) {
@@ -464,6 +542,9 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
             }
         }
 
+        if (!degradedStages.empty() || valueFlowTimeout)
+            degradedAnalysisMessage(Path::toNativeSeparators(filename), degradedStages, valueFlowTimeout);
+
         if (!hasValidConfig && configurations.size() > 1 && mSettings.isEnabled(Settings::INFORMATION)) {
             std::string msg;
             msg = "This file is not analyzed. Cppcheck failed to extract a valid configuration. Use -v for more details.";
@@ -485,8 +566,15 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
         }
 
         // dumped all configs, close root </dumps> element now
-        if (mSettings.dump && fdump.is_open())
-            fdump << "</dumps>" << std::endl;
+        if (dumpWriter) {
+            dumpWriter->endElement();
+            dumpWriter->flush();
+        }
+
+        if (dumpWriter && !mSettings.addons.empty()) {
+            fdump.close();
+            executeAddons(filename, dumpfile, addonDump.str());
+        }
 
     } catch (const std::runtime_error &e) {
         internalError(filename, e.what());
@@ -498,6 +586,7 @@ unsigned int CppCheck::checkFile(const std::string& filename, const std::string
     }
 
     mAnalyzerInformation.setFileInfo("CheckUnusedFunctions", checkUnusedFunctions.analyzerInfo());
+    mAnalyzerInformation.setCost(fileCost);
     mAnalyzerInformation.close();
 
     // In jointSuppressionReport mode, unmatched suppressions are
@@ -599,271 +688,75 @@ void CppCheck::checkSimplifiedTokens(const Tokenizer &tokenizer)
         executeRules("simple", tokenizer);
 }
 
-#ifdef HAVE_RULES
-
-static const char * pcreErrorCodeToString(const int pcreExecRet)
-{
-    switch (pcreExecRet) {
-    case PCRE_ERROR_NULL:
-        return "Either code or subject was passed as NULL, or ovector was NULL "
-               "and ovecsize was not zero (PCRE_ERROR_NULL)";
-    case PCRE_ERROR_BADOPTION:
-        return "An unrecognized bit was set in the options argument (PCRE_ERROR_BADOPTION)";
-    case PCRE_ERROR_BADMAGIC:
-        return "PCRE stores a 4-byte \"magic number\" at the start of the compiled code, "
-               "to catch the case when it is passed a junk pointer and to detect when a "
-               "pattern that was compiled in an environment of one endianness is run in "
-               "an environment with the other endianness. This is the error that PCRE "
-               "gives when the magic number is not present (PCRE_ERROR_BADMAGIC)";
-    case PCRE_ERROR_UNKNOWN_NODE:
-        return "While running the pattern match, an unknown item was encountered in the "
-               "compiled pattern. This error could be caused by a bug in PCRE or by "
-               "overwriting of the compiled pattern (PCRE_ERROR_UNKNOWN_NODE)";
-    case PCRE_ERROR_NOMEMORY:
-        return "If a pattern contains back references, but the ovector that is passed "
-               "to pcre_exec() is not big enough to remember the referenced substrings, "
-               "PCRE gets a block of memory at the start of matching to use for this purpose. "
-               "If the call via pcre_malloc() fails, this error is given. The memory is "
-               "automatically freed at the end of matching. This error is also given if "
-               "pcre_stack_malloc() fails in pcre_exec(). "
-               "This can happen only when PCRE has been compiled with "
-               "--disable-stack-for-recursion (PCRE_ERROR_NOMEMORY)";
-    case PCRE_ERROR_NOSUBSTRING:
-        return "This error is used by the pcre_copy_substring(), pcre_get_substring(), "
-               "and pcre_get_substring_list() functions (see below). "
-               "It is never returned by pcre_exec() (PCRE_ERROR_NOSUBSTRING)";
-    case PCRE_ERROR_MATCHLIMIT:
-        return "The backtracking limit, as specified by the match_limit field in a pcre_extra "
-               "structure (or defaulted) was reached. "
-               "See the description above (PCRE_ERROR_MATCHLIMIT)";
-    case PCRE_ERROR_CALLOUT:
-        return "This error is never generated by pcre_exec() itself. "
-               "It is provided for use by callout functions that want to yield a distinctive "
-               "error code. See the pcrecallout documentation for details (PCRE_ERROR_CALLOUT)";
-    case PCRE_ERROR_BADUTF8:
-        return "A string that contains an invalid UTF-8 byte sequence was passed as a subject, "
-               "and the PCRE_NO_UTF8_CHECK option was not set. If the size of the output vector "
-               "(ovecsize) is at least 2, the byte offset to the start of the the invalid UTF-8 "
-               "character is placed in the first element, and a reason code is placed in the "
-               "second element. The reason codes are listed in the following section. For "
-               "backward compatibility, if PCRE_PARTIAL_HARD is set and the problem is a truncated "
-               "UTF-8 character at the end of the subject (reason codes 1 to 5), "
-               "PCRE_ERROR_SHORTUTF8 is returned instead of PCRE_ERROR_BADUTF8";
-    case PCRE_ERROR_BADUTF8_OFFSET:
-        return "The UTF-8 byte sequence that was passed as a subject was checked and found to "
-               "be valid (the PCRE_NO_UTF8_CHECK option was not set), but the value of "
-               "startoffset did not point to the beginning of a UTF-8 character or the end of "
-               "the subject (PCRE_ERROR_BADUTF8_OFFSET)";
-    case PCRE_ERROR_PARTIAL:
-        return "The subject string did not match, but it did match partially. See the "
-               "pcrepartial documentation for details of partial matching (PCRE_ERROR_PARTIAL)";
-    case PCRE_ERROR_BADPARTIAL:
-        return "This code is no longer in use. It was formerly returned when the PCRE_PARTIAL "
-               "option was used with a compiled pattern containing items that were not supported "
-               "for partial matching. From release 8.00 onwards, there are no restrictions on "
-               "partial matching (PCRE_ERROR_BADPARTIAL)";
-    case PCRE_ERROR_INTERNAL:
-        return "An unexpected internal error has occurred. This error could be caused by a bug "
-               "in PCRE or by overwriting of the compiled pattern (PCRE_ERROR_INTERNAL)";
-    case PCRE_ERROR_BADCOUNT:
-        return"This error is given if the value of the ovecsize argument is negative "
-              "(PCRE_ERROR_BADCOUNT)";
-    case PCRE_ERROR_RECURSIONLIMIT :
-        return "The internal recursion limit, as specified by the match_limit_recursion "
-               "field in a pcre_extra structure (or defaulted) was reached. "
-               "See the description above (PCRE_ERROR_RECURSIONLIMIT)";
-    case PCRE_ERROR_DFA_UITEM:
-        return "PCRE_ERROR_DFA_UITEM";
-    case PCRE_ERROR_DFA_UCOND:
-        return "PCRE_ERROR_DFA_UCOND";
-    case PCRE_ERROR_DFA_WSSIZE:
-        return "PCRE_ERROR_DFA_WSSIZE";
-    case PCRE_ERROR_DFA_RECURSE:
-        return "PCRE_ERROR_DFA_RECURSE";
-    case PCRE_ERROR_NULLWSLIMIT:
-        return "PCRE_ERROR_NULLWSLIMIT";
-    case PCRE_ERROR_BADNEWLINE:
-        return "An invalid combination of PCRE_NEWLINE_xxx options was "
-               "given (PCRE_ERROR_BADNEWLINE)";
-    case PCRE_ERROR_BADOFFSET:
-        return "The value of startoffset was negative or greater than the length "
-               "of the subject, that is, the value in length (PCRE_ERROR_BADOFFSET)";
-    case PCRE_ERROR_SHORTUTF8:
-        return "This error is returned instead of PCRE_ERROR_BADUTF8 when the subject "
-               "string ends with a truncated UTF-8 character and the PCRE_PARTIAL_HARD option is set. "
-               "Information about the failure is returned as for PCRE_ERROR_BADUTF8. "
-               "It is in fact sufficient to detect this case, but this special error code for "
-               "PCRE_PARTIAL_HARD precedes the implementation of returned information; "
-               "it is retained for backwards compatibility (PCRE_ERROR_SHORTUTF8)";
-    case PCRE_ERROR_RECURSELOOP:
-        return "This error is returned when pcre_exec() detects a recursion loop "
-               "within the pattern. Specifically, it means that either the whole pattern "
-               "or a subpattern has been called recursively for the second time at the same "
-               "position in the subject string. Some simple patterns that might do this "
-               "are detected and faulted at compile time, but more complicated cases, "
-               "in particular mutual recursions between two different subpatterns, "
-               "cannot be detected until run time (PCRE_ERROR_RECURSELOOP)";
-    case PCRE_ERROR_JIT_STACKLIMIT:
-        return "This error is returned when a pattern that was successfully studied "
-               "using a JIT compile option is being matched, but the memory available "
-               "for the just-in-time processing stack is not large enough. See the pcrejit "
-               "documentation for more details (PCRE_ERROR_JIT_STACKLIMIT)";
-    case PCRE_ERROR_BADMODE:
-        return "This error is given if a pattern that was compiled by the 8-bit library "
-               "is passed to a 16-bit or 32-bit library function, or vice versa (PCRE_ERROR_BADMODE)";
-    case PCRE_ERROR_BADENDIANNESS:
-        return "This error is given if a pattern that was compiled and saved is reloaded on a "
-               "host with different endianness. The utility function pcre_pattern_to_host_byte_order() "
-               "can be used to convert such a pattern so that it runs on the new host (PCRE_ERROR_BADENDIANNESS)";
-    case PCRE_ERROR_DFA_BADRESTART:
-        return "PCRE_ERROR_DFA_BADRESTART";
-#if PCRE_MAJOR >= 8 && PCRE_MINOR >= 32
-    case PCRE_ERROR_BADLENGTH:
-        return "This error is given if pcre_exec() is called with a negative value for the length argument (PCRE_ERROR_BADLENGTH)";
-    case PCRE_ERROR_JIT_BADOPTION:
-        return "This error is returned when a pattern that was successfully studied using a JIT compile "
-               "option is being matched, but the matching mode (partial or complete match) does not correspond "
-               "to any JIT compilation mode. When the JIT fast path function is used, this error may be "
-               "also given for invalid options. See the pcrejit documentation for more details (PCRE_ERROR_JIT_BADOPTION)";
-#endif
-    }
-    return "";
-}
-
-#endif // HAVE_RULES
-
-
 void CppCheck::executeRules(const std::string &tokenlist, const Tokenizer &tokenizer)
 {
     (void)tokenlist;
     (void)tokenizer;
 
 #ifdef HAVE_RULES
-    // Are there rules to execute?
-    bool isrule = false;
-    for (std::list<Settings::Rule>::const_iterator it = mSettings.rules.begin(); it != mSettings.rules.end(); ++it) {
-        if (it->tokenlist == tokenlist)
-            isrule = true;
-    }
+    // The rules are normally compiled when the settings are loaded
+    if (!mSettings.ruleMatcher || !mSettings.ruleMatcher->compiledFrom(mSettings.rules))
+        mSettings.compileRules();
+    const std::shared_ptr<const RuleMatcher> ruleMatcher = mSettings.ruleMatcher;
 
     // There is no rule to execute
-    if (isrule == false)
+    if (!ruleMatcher->hasRules(tokenlist))
         return;
 
-    // Write all tokens in a string that can be parsed by pcre
-    std::ostringstream ostr;
-    for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next())
-        ostr << " " << tok->str();
-    const std::string str(ostr.str());
-
-    for (std::list<Settings::Rule>::const_iterator it = mSettings.rules.begin(); it != mSettings.rules.end(); ++it) {
-        const Settings::Rule &rule = *it;
-        if (rule.pattern.empty() || rule.id.empty() || rule.severity == Severity::none || rule.tokenlist != tokenlist)
-            continue;
+    // Write all tokens in a string that can be parsed by pcre, and remember where each token ends
+    std::string str;
+    std::vector<const Token *> tokens;
+    std::vector<std::size_t> tokenEnds;
+    for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
+        str += ' ';
+        str += tok->str();
+        tokens.push_back(tok);
+        tokenEnds.push_back(str.size());
+    }
 
-        const char *pcreCompileErrorStr = nullptr;
-        int erroffset = 0;
-        pcre * const re = pcre_compile(rule.pattern.c_str(),0,&pcreCompileErrorStr,&erroffset,nullptr);
-        if (!re) {
-            if (pcreCompileErrorStr) {
-                const std::string msg = "pcre_compile failed: " + std::string(pcreCompileErrorStr);
-                const ErrorLogger::ErrorMessage errmsg(std::list<ErrorLogger::ErrorMessage::FileLocation>(),
-                                                       emptyString,
-                                                       Severity::error,
-                                                       msg,
-                                                       "pcre_compile",
-                                                       false);
+    const std::vector<RuleMatcher::Result> results = ruleMatcher->match(tokenlist, str, mSettings.ruleJobs);
 
-                reportErr(errmsg);
-            }
-            continue;
-        }
-
-        // Optimize the regex, but only if PCRE_CONFIG_JIT is available
-#ifdef PCRE_CONFIG_JIT
-        const char *pcreStudyErrorStr = nullptr;
-        pcre_extra * const pcreExtra = pcre_study(re, PCRE_STUDY_JIT_COMPILE, &pcreStudyErrorStr);
-        // pcre_study() returns NULL for both errors and when it can not optimize the regex.
-        // The last argument is how one checks for errors.
-        // It is NULL if everything works, and points to an error string otherwise.
-        if (pcreStudyErrorStr) {
-            const std::string msg = "pcre_study failed: " + std::string(pcreStudyErrorStr);
+    for (std::vector<RuleMatcher::Result>::const_iterator it = results.begin(); it != results.end(); ++it) {
+        if (!it->errorId.empty()) {
             const ErrorLogger::ErrorMessage errmsg(std::list<ErrorLogger::ErrorMessage::FileLocation>(),
                                                    emptyString,
                                                    Severity::error,
-                                                   msg,
-                                                   "pcre_study",
+                                                   it->error,
+                                                   it->errorId,
                                                    false);
 
             reportErr(errmsg);
-            // pcre_compile() worked, but pcre_study() returned an error. Free the resources allocated by pcre_compile().
-            pcre_free(re);
             continue;
         }
-#else
-        const pcre_extra * const pcreExtra = nullptr;
-#endif
-
-        int pos = 0;
-        int ovector[30]= {0};
-        while (pos < (int)str.size()) {
-            const int pcreExecRet = pcre_exec(re, pcreExtra, str.c_str(), (int)str.size(), pos, 0, ovector, 30);
-            if (pcreExecRet < 0) {
-                const std::string errorMessage = pcreErrorCodeToString(pcreExecRet);
-                if (!errorMessage.empty()) {
-                    const ErrorLogger::ErrorMessage errmsg(std::list<ErrorLogger::ErrorMessage::FileLocation>(),
-                                                           emptyString,
-                                                           Severity::error,
-                                                           std::string("pcre_exec failed: ") + errorMessage,
-                                                           "pcre_exec",
-                                                           false);
-
-                    reportErr(errmsg);
-                }
-                break;
-            }
-            const unsigned int pos1 = (unsigned int)ovector[0];
-            const unsigned int pos2 = (unsigned int)ovector[1];
 
-            // jump to the end of the match for the next pcre_exec
-            pos = (int)pos2;
+        const Settings::Rule &rule = *it->rule;
+        const std::size_t pos1 = it->begin;
+        const std::size_t pos2 = it->end;
 
-            // determine location..
-            ErrorLogger::ErrorMessage::FileLocation loc;
-            loc.setfile(tokenizer.list.getSourceFilePath());
-            loc.line = 0;
-
-            std::size_t len = 0;
-            for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
-                len = len + 1U + tok->str().size();
-                if (len > pos1) {
-                    loc.setfile(tokenizer.list.getFiles().at(tok->fileIndex()));
-                    loc.line = tok->linenr();
-                    break;
-                }
-            }
+        // determine location..
+        ErrorLogger::ErrorMessage::FileLocation loc;
+        loc.setfile(tokenizer.list.getSourceFilePath());
+        loc.line = 0;
 
-            const std::list<ErrorLogger::ErrorMessage::FileLocation> callStack(1, loc);
+        const std::vector<std::size_t>::const_iterator tokenEnd = std::upper_bound(tokenEnds.begin(), tokenEnds.end(), pos1);
+        if (tokenEnd != tokenEnds.end()) {
+            const Token * const tok = tokens[tokenEnd - tokenEnds.begin()];
+            loc.setfile(tokenizer.list.getFiles().at(tok->fileIndex()));
+            loc.line = tok->linenr();
+        }
 
-            // Create error message
-            std::string summary;
-            if (rule.summary.empty())
-                summary = "found '" + str.substr(pos1, pos2 - pos1) + "'";
-            else
-                summary = rule.summary;
-            const ErrorLogger::ErrorMessage errmsg(callStack, tokenizer.list.getSourceFilePath(), rule.severity, summary, rule.id, false);
+        const std::list<ErrorLogger::ErrorMessage::FileLocation> callStack(1, loc);
 
-            // Report error
-            reportErr(errmsg);
-        }
+        // Create error message
+        std::string summary;
+        if (rule.summary.empty())
+            summary = "found '" + str.substr(pos1, pos2 - pos1) + "'";
+        else
+            summary = rule.summary;
+        const ErrorLogger::ErrorMessage errmsg(callStack, tokenizer.list.getSourceFilePath(), rule.severity, summary, rule.id, false);
 
-        pcre_free(re);
-#ifdef PCRE_CONFIG_JIT
-        // Free up the EXTRA PCRE value (may be NULL at this point)
-        if (pcreExtra) {
-            pcre_free_study(pcreExtra);
-        }
-#endif
+        // Report error
+        reportErr(errmsg);
     }
 #endif
 }
@@ -873,6 +766,90 @@ Settings &CppCheck::settings()
     return mSettings;
 }
 
+/**
+ * Parse a result line that an addon writes to stderr, like
+ * "[file.c:12] (style): message [id]" or "[file.c:12]: (style) message [id]".
+ * The id is the addon name when the line does not end with one.
+ */
+static bool parseAddonResult(const std::string &line, const std::string &addonName, const std::string &file0, ErrorLogger::ErrorMessage &errmsg)
+{
+    if (line.empty() || line[0] != '[')
+        return false;
+    const std::string::size_type endLocation = line.find(']');
+    if (endLocation == std::string::npos)
+        return false;
+    const std::string location = line.substr(1, endLocation - 1);
+    const std::string::size_type colon = location.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == location.size() ||
+        location.find_first_not_of("0123456789", colon + 1) != std::string::npos)
+        return false;
+
+    std::string::size_type pos = line.find_first_not_of(": ", endLocation + 1);
+    if (pos == std::string::npos || line[pos] != '(')
+        return false;
+    const std::string::size_type endSeverity = line.find(')', pos);
+    if (endSeverity == std::string::npos)
+        return false;
+    std::string severity = line.substr(pos + 1, endSeverity - pos - 1);
+    severity.erase(0, severity.find_first_not_of(' '));
+    severity.erase(severity.find_last_not_of(' ') + 1);
+
+    pos = line.find_first_not_of(": ", endSeverity + 1);
+    std::string message = (pos == std::string::npos) ? std::string() : line.substr(pos);
+    std::string id = addonName;
+    const std::string::size_type startId = message.rfind(" [");
+    if (startId != std::string::npos && message.back() == ']') {
+        id = message.substr(startId + 2, message.size() - startId - 3);
+        message.erase(startId);
+    }
+
+    ErrorLogger::ErrorMessage::FileLocation loc;
+    loc.setfile(location.substr(0, colon));
+    loc.line = std::atoi(location.c_str() + colon + 1);
+    const std::list<ErrorLogger::ErrorMessage::FileLocation> callStack(1, loc);
+    errmsg = ErrorLogger::ErrorMessage(callStack, file0, Severity::fromString(severity), message, id, false);
+    return true;
+}
+
+void CppCheck::executeAddons(const std::string &filename, const std::string &dumpfile, const std::string &dumpData)
+{
+    for (const std::string &addon : mSettings.addons) {
+        // the addon reads the dump from stdin when its file name is "-"
+        std::vector<std::string> args;
+        args.push_back(mSettings.addonPython);
+        args.push_back(addon);
+        args.push_back(dumpfile.empty() ? std::string("-") : dumpfile);
+        std::string out, err;
+        const int exitCode = executeProcess(args, dumpfile.empty() ? dumpData : std::string(), out, err);
+        // 127: the shell convention for "command not found", used when exec fails after fork
+        if (exitCode == -1 || exitCode == 127) {
+            reportOut("Failed to execute addon '" + addon + "'");
+            continue;
+        }
+
+        std::string addonName = Path::stripDirectoryPart(addon);
+        addonName.erase(addonName.size() - Path::getFilenameExtension(addonName).size());
+
+        // results are reported like the results of the checks, other output is passed on
+        std::istringstream istr(err);
+        std::string line;
+        while (std::getline(istr, line)) {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            ErrorLogger::ErrorMessage errmsg;
+            if (parseAddonResult(line, addonName, Path::toNativeSeparators(filename), errmsg))
+                reportErr(errmsg);
+            else if (!line.empty() && !mSettings.quiet)
+                reportOut(line);
+        }
+        if (!out.empty() && !mSettings.quiet) {
+            std::istringstream ostr(out);
+            while (std::getline(ostr, line))
+                reportOut(line);
+        }
+    }
+}
+
 void CppCheck::tooManyConfigsError(const std::string &file, const std::size_t numberOfConfigurations)
 {
     if (!mSettings.isEnabled(Settings::INFORMATION) && !mTooManyConfigs)
@@ -914,6 +891,29 @@ void CppCheck::tooManyConfigsError(const std::string &file, const std::size_t nu
     reportErr(errmsg);
 }
 
+void CppCheck::dumpFileError(const std::string &file, const std::string &dumpfile)
+{
+    std::list<ErrorLogger::ErrorMessage::FileLocation> loclist;
+    if (!file.empty()) {
+        ErrorLogger::ErrorMessage::FileLocation location;
+        location.setfile(Path::toNativeSeparators(file));
+        loclist.push_back(location);
+    }
+
+    std::string msg = "Failed to write the dump file '" + dumpfile + "'.";
+    if (!mSettings.addons.empty())
+        msg += " The dump is passed to the addons through a pipe instead.";
+
+    ErrorLogger::ErrorMessage errmsg(loclist,
+                                     emptyString,
+                                     Severity::error,
+                                     msg,
+                                     "dumpFileError",
+                                     false);
+
+    reportErr(errmsg);
+}
+
 void CppCheck::purgedConfigurationMessage(const std::string &file, const std::string& configuration)
 {
     mTooManyConfigs = false;
@@ -938,6 +938,54 @@ void CppCheck::purgedConfigurationMessage(const std::string &file, const std::st
     reportErr(errmsg);
 }
 
+void CppCheck::degradedAnalysisMessage(const std::string &file, const std::vector<std::string> &stages, bool valueFlowTimeout)
+{
+    if (!mSettings.isEnabled(Settings::INFORMATION) && !file.empty())
+        return;
+
+    std::list<ErrorLogger::ErrorMessage::FileLocation> loclist;
+    if (!file.empty()) {
+        ErrorLogger::ErrorMessage::FileLocation location;
+        location.setfile(file);
+        loclist.push_back(location);
+    }
+
+    std::string shortMessage;
+    std::string verboseMessage;
+    if (!stages.empty()) {
+        std::string stageList;
+        for (const std::string &stage : stages) {
+            if (!stageList.empty())
+                stageList += ", ";
+            stageList += stage;
+        }
+        shortMessage = "Analysis of this file was degraded to stay within its budget: " + stageList + ".";
+        verboseMessage = "Checking this file took too long or needed too much memory, so it was checked "
+                         "in cheaper modes and some findings may be missing. These stages were degraded: " +
+                         stageList + ". The budget of a file is set with --max-time-per-file and "
+                         "--max-memory-per-file.";
+    }
+    if (valueFlowTimeout) {
+        // no budget is involved, ValueFlow stops repeating itself after a while
+        if (!shortMessage.empty()) {
+            shortMessage += ' ';
+            verboseMessage += ' ';
+        }
+        shortMessage += "ValueFlow analysis of this file was stopped by its time limit.";
+        verboseMessage += "The ValueFlow analysis is repeated until no more values are found, but for this "
+                          "file it was stopped by its built-in time limit, so some findings may be missing.";
+    }
+
+    ErrorLogger::ErrorMessage errmsg(loclist,
+                                     emptyString,
+                                     Severity::information,
+                                     shortMessage + "\n" + verboseMessage,
+                                     "analysisDegraded",
+                                     false);
+
+    reportErr(errmsg);
+}
+
 //---------------------------------------------------------------------------
 
 void CppCheck::reportErr(const ErrorLogger::ErrorMessage &msg)
@@ -1017,6 +1065,10 @@ void CppCheck::getErrorMessages()
     mTooManyConfigs = true;
     tooManyConfigsError("",0U);
 
+    degradedAnalysisMessage("", std::vector<std::string>(1, "ValueFlow iterations"), false);
+
+    dumpFileError("", "file.dump");
+
     // call all "getErrorMessages" in all registered Check classes
     for (std::list<Check *>::const_iterator it = Check::instances().begin(); it != Check::instances().end(); ++it)
         (*it)->getErrorMessages(this, &s);
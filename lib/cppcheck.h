@@ -33,6 +33,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 class Tokenizer;
 
@@ -124,6 +125,8 @@ public:
 
     void tooManyConfigsError(const std::string &file, const std::size_t numberOfConfigurations);
     void purgedConfigurationMessage(const std::string &file, const std::string& configuration);
+    void degradedAnalysisMessage(const std::string &file, const std::vector<std::string> &stages, bool valueFlowTimeout);
+    void dumpFileError(const std::string &file, const std::string &dumpfile);
 
     void dontSimplify() {
         mSimplify = false;
@@ -182,6 +185,16 @@ private:
      */
     void executeRules(const std::string &tokenlist, const Tokenizer &tokenizer);
 
+    /**
+     * @brief Execute the addons (--addon) for the checked file. The
+     * results that they write are reported like the results of the checks.
+     * @param filename the checked file
+     * @param dumpfile dump file that the addons read, empty if the dump is
+     * passed to them through a pipe
+     * @param dumpData the dump that is written to the pipe
+     */
+    void executeAddons(const std::string &filename, const std::string &dumpfile, const std::string &dumpData);
+
     /**
      * @brief Errors and warnings are directed here.
      *
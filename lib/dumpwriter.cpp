@@ -0,0 +1,308 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dumpwriter.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+void DumpWriter::attribute(const char name[], bool value)
+{
+    if (value)
+        writeAttribute(name, "true", 4, true);
+    else
+        writeAttribute(name, "false", 5, true);
+}
+
+void DumpWriter::attribute(const char name[], int value)
+{
+    attribute(name, static_cast<long long>(value));
+}
+
+void DumpWriter::attribute(const char name[], unsigned int value)
+{
+    attribute(name, static_cast<unsigned long long>(value));
+}
+
+void DumpWriter::attribute(const char name[], long value)
+{
+    attribute(name, static_cast<long long>(value));
+}
+
+void DumpWriter::attribute(const char name[], unsigned long value)
+{
+    attribute(name, static_cast<unsigned long long>(value));
+}
+
+void DumpWriter::attribute(const char name[], long long value)
+{
+    char buf[32];
+    const int len = std::snprintf(buf, sizeof(buf), "%lld", value);
+    writeAttribute(name, buf, len, true);
+}
+
+void DumpWriter::attribute(const char name[], unsigned long long value)
+{
+    char buf[32];
+    const int len = std::snprintf(buf, sizeof(buf), "%llu", value);
+    writeAttribute(name, buf, len, true);
+}
+
+void DumpWriter::attribute(const char name[], double value)
+{
+    // Same format as std::ostream
+    char buf[64];
+    const int len = std::snprintf(buf, sizeof(buf), "%g", value);
+    writeAttribute(name, buf, len, true);
+}
+
+void DumpWriter::attribute(const char name[], const void *id)
+{
+    if (!id) {
+        writeAttribute(name, "0", 1, true);
+        return;
+    }
+    static const char hex[] = "0123456789abcdef";
+    char buf[2 + 2 * sizeof(std::uintptr_t)];
+    char *end = buf + sizeof(buf);
+    char *p = end;
+    for (std::uintptr_t value = reinterpret_cast<std::uintptr_t>(id); value != 0; value >>= 4)
+        *--p = hex[value & 0xf];
+    *--p = 'x';
+    *--p = '0';
+    writeAttribute(name, p, end - p, true);
+}
+
+void DumpWriter::appendPlain(std::string &buf, const char value[], std::size_t len)
+{
+    for (std::size_t i = 0; i < len; ++i) {
+        const unsigned char c = value[i];
+        if (c == '\0')
+            buf += "\\0";
+        else if (c >= ' ' && c <= 0x7f)
+            buf += static_cast<char>(c);
+        else
+            buf += 'x';
+    }
+}
+
+//---------------------------------------------------------------------------
+
+// The xml is written like the dump was written before there was a
+// DumpWriter: <dump> elements are not indented, and <suppression> elements
+// are closed with " />".
+static bool isUnindented(const char name[])
+{
+    return std::strcmp(name, "dump") == 0;
+}
+
+static const char *emptyElementEnd(const char name[])
+{
+    return std::strcmp(name, "suppression") == 0 ? " />\n" : "/>\n";
+}
+
+XmlDumpWriter::XmlDumpWriter(std::ostream &out, unsigned int depth)
+    : mOut(out), mDepth(depth), mUnindented(0), mStartTagOpen(false), mHasAttributes(false)
+{
+    mBuffer.reserve(BUFFER_SIZE + 1024);
+}
+
+XmlDumpWriter::~XmlDumpWriter()
+{
+    flush();
+}
+
+void XmlDumpWriter::prolog()
+{
+    mBuffer += "<?xml version=\"1.0\"?>\n";
+}
+
+void XmlDumpWriter::indent()
+{
+    mBuffer.append(2 * (mDepth + mElements.size() - mUnindented), ' ');
+}
+
+void XmlDumpWriter::startElement(const char name[])
+{
+    if (mStartTagOpen)
+        mBuffer += ">\n";
+    if (isUnindented(name))
+        ++mUnindented;
+    indent();
+    mBuffer += '<';
+    mBuffer += name;
+    mElements.push_back(name);
+    mStartTagOpen = true;
+    mHasAttributes = false;
+}
+
+void XmlDumpWriter::endElement()
+{
+    const char *name = mElements.back();
+    mElements.pop_back();
+    if (mStartTagOpen && mHasAttributes)
+        mBuffer += emptyElementEnd(name);
+    else {
+        // an element without attributes is a list, it has an end tag even if it is empty
+        if (mStartTagOpen)
+            mBuffer += ">\n";
+        indent();
+        mBuffer += "</";
+        mBuffer += name;
+        mBuffer += ">\n";
+    }
+    if (isUnindented(name))
+        --mUnindented;
+    mStartTagOpen = false;
+    if (mBuffer.size() >= BUFFER_SIZE)
+        flush();
+}
+
+void XmlDumpWriter::flush()
+{
+    mOut.write(mBuffer.data(), mBuffer.size());
+    mBuffer.clear();
+}
+
+void XmlDumpWriter::writeAttribute(const char name[], const char value[], std::size_t len, bool plain)
+{
+    mHasAttributes = true;
+    mBuffer += ' ';
+    mBuffer += name;
+    mBuffer += "=\"";
+    if (plain)
+        mBuffer.append(value, len);
+    else {
+        for (std::size_t i = 0; i < len; ++i) {
+            switch (value[i]) {
+            case '<':
+                mBuffer += "&lt;";
+                break;
+            case '>':
+                mBuffer += "&gt;";
+                break;
+            case '&':
+                mBuffer += "&amp;";
+                break;
+            case '\"':
+                mBuffer += "&quot;";
+                break;
+            default:
+                appendPlain(mBuffer, value + i, 1);
+                break;
+            }
+        }
+    }
+    mBuffer += '\"';
+}
+
+//---------------------------------------------------------------------------
+
+const char BinaryDumpWriter::MAGIC[] = "CPPCHECK-DUMP 1\n";
+
+BinaryDumpWriter::BinaryDumpWriter(std::ostream &out)
+    : mOut(out)
+{
+    mBuffer.reserve(BUFFER_SIZE + 1024);
+    mBuffer += MAGIC;
+}
+
+BinaryDumpWriter::~BinaryDumpWriter()
+{
+    flush();
+}
+
+void BinaryDumpWriter::startElement(const char name[])
+{
+    if (!mPendingNames.empty())
+        writePending('E');
+    mPendingNames.push_back(name);
+    mPendingShape.append(reinterpret_cast<const char *>(&name), sizeof(const char *));
+}
+
+void BinaryDumpWriter::endElement()
+{
+    if (!mPendingNames.empty())
+        writePending('L');
+    else
+        endRecord(startRecord('X'));
+    if (mBuffer.size() >= BUFFER_SIZE)
+        flush();
+}
+
+void BinaryDumpWriter::flush()
+{
+    mOut.write(mBuffer.data(), mBuffer.size());
+    mBuffer.clear();
+}
+
+void BinaryDumpWriter::writeAttribute(const char name[], const char value[], std::size_t len, bool plain)
+{
+    mPendingNames.push_back(name);
+    mPendingShape.append(reinterpret_cast<const char *>(&name), sizeof(const char *));
+    mPendingValues += '\0';
+    if (plain)
+        mPendingValues.append(value, len);
+    else
+        appendPlain(mPendingValues, value, len);
+}
+
+void BinaryDumpWriter::writePending(char kind)
+{
+    unsigned int id;
+    const std::unordered_map<std::string, unsigned int>::const_iterator it = mShapes.find(mPendingShape);
+    if (it != mShapes.end())
+        id = it->second;
+    else {
+        id = static_cast<unsigned int>(mShapes.size());
+        mShapes[mPendingShape] = id;
+        const std::size_t start = startRecord('T');
+        mBuffer += std::to_string(id);
+        for (const char *name : mPendingNames) {
+            mBuffer += '\0';
+            mBuffer += name;
+        }
+        endRecord(start);
+    }
+    const std::size_t start = startRecord(kind);
+    char buf[16];
+    mBuffer.append(buf, std::snprintf(buf, sizeof(buf), "%u", id));
+    mBuffer += mPendingValues;
+    endRecord(start);
+    mPendingNames.clear();
+    mPendingShape.clear();
+    mPendingValues.clear();
+}
+
+std::size_t BinaryDumpWriter::startRecord(char kind)
+{
+    const std::size_t start = mBuffer.size();
+    mBuffer.append(4, '\0');
+    mBuffer += kind;
+    return start;
+}
+
+void BinaryDumpWriter::endRecord(std::size_t start)
+{
+    const std::uint32_t len = static_cast<std::uint32_t>(mBuffer.size() - start - 4);
+    mBuffer[start] = static_cast<char>(len & 0xff);
+    mBuffer[start + 1] = static_cast<char>((len >> 8) & 0xff);
+    mBuffer[start + 2] = static_cast<char>((len >> 16) & 0xff);
+    mBuffer[start + 3] = static_cast<char>((len >> 24) & 0xff);
+}
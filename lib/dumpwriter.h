@@ -0,0 +1,192 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef dumpwriterH
+#define dumpwriterH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Writer for the --dump data.
+ *
+ * The dump is a tree of elements with attributes. The attribute values
+ * are the same strings in all formats, so addons see the same data
+ * whatever the format is. Output is buffered and written to the stream
+ * in large blocks.
+ *
+ * Element and attribute names must be string literals. The attributes of
+ * an element must be written before its child elements.
+ */
+class CPPCHECKLIB DumpWriter {
+public:
+    virtual ~DumpWriter() {}
+
+    virtual void startElement(const char name[]) = 0;
+    virtual void endElement() = 0;
+
+    void attribute(const char name[], const std::string &value) {
+        writeAttribute(name, value.data(), value.size(), false);
+    }
+    void attribute(const char name[], const char value[]) {
+        writeAttribute(name, value, std::strlen(value), false);
+    }
+    /**
+     * Write the value as it is, without escaping. Only for the attributes
+     * that the xml dump has always written this way. The value must not
+     * contain '\0'.
+     */
+    void rawAttribute(const char name[], const std::string &value) {
+        writeAttribute(name, value.data(), value.size(), true);
+    }
+    /** "true" or "false" */
+    void attribute(const char name[], bool value);
+    void attribute(const char name[], int value);
+    void attribute(const char name[], unsigned int value);
+    void attribute(const char name[], long value);
+    void attribute(const char name[], unsigned long value);
+    void attribute(const char name[], long long value);
+    void attribute(const char name[], unsigned long long value);
+    void attribute(const char name[], double value);
+    /** The id of an object, "0" for a null pointer */
+    void attribute(const char name[], const void *id);
+
+    /** Write the buffered data to the stream */
+    virtual void flush() = 0;
+
+protected:
+    /**
+     * @param plain the value only has characters that need no escaping,
+     * like numbers and ids
+     */
+    virtual void writeAttribute(const char name[], const char value[], std::size_t len, bool plain) = 0;
+
+    /** Append a value, with the same character replacements as ErrorLogger::toxml() but without xml entities */
+    static void appendPlain(std::string &buf, const char value[], std::size_t len);
+
+    /** Size of the buffer that is written to the stream at once */
+    static const std::size_t BUFFER_SIZE = 1U << 16;
+};
+
+/**
+ * @brief Writes the dump as xml.
+ *
+ * Elements are indented with two spaces per level. Elements without
+ * attributes always get an end tag, elements with attributes are closed
+ * with "/>" if they have no child elements.
+ */
+class CPPCHECKLIB XmlDumpWriter : public DumpWriter {
+public:
+    /** @param depth indentation level of the top level elements */
+    explicit XmlDumpWriter(std::ostream &out, unsigned int depth = 0);
+    ~XmlDumpWriter() override;
+
+    /** Write the xml declaration */
+    void prolog();
+
+    void startElement(const char name[]) override;
+    void endElement() override;
+    void flush() override;
+
+protected:
+    void writeAttribute(const char name[], const char value[], std::size_t len, bool plain) override;
+
+private:
+    void indent();
+
+    std::ostream &mOut;
+    std::string mBuffer;
+    std::vector<const char *> mElements;
+    const unsigned int mDepth;
+    /** number of open elements that do not indent their child elements */
+    unsigned int mUnindented;
+    /** is the start tag of the current element still open? */
+    bool mStartTagOpen;
+    /** does the current element have attributes? */
+    bool mHasAttributes;
+};
+
+/**
+ * @brief Writes the dump as length-prefixed records.
+ *
+ * The file starts with the line "CPPCHECK-DUMP 1". Each record is a
+ * 32-bit little endian length followed by that many bytes of text. The
+ * first character is the kind of the record, the rest are fields that
+ * are separated by '\0'.
+ *
+ * - 'T' id tag name... : defines a shape, the tag and attribute names
+ *   of elements
+ * - 'E' id value... : element with shape id and attribute values, its
+ *   child elements follow and then an 'X' record
+ * - 'L' id value... : element without child elements
+ * - 'X' : end of the last 'E' element
+ *
+ * A shape is defined before the first element that uses it. Shape ids
+ * are decimal numbers, counting from 0. Several shapes can have the
+ * same names.
+ */
+class CPPCHECKLIB BinaryDumpWriter : public DumpWriter {
+public:
+    static const char MAGIC[];
+
+    /** Writes the magic line */
+    explicit BinaryDumpWriter(std::ostream &out);
+    ~BinaryDumpWriter() override;
+
+    void startElement(const char name[]) override;
+    void endElement() override;
+    void flush() override;
+
+protected:
+    void writeAttribute(const char name[], const char value[], std::size_t len, bool plain) override;
+
+private:
+    /** write the pending element as an 'E' or 'L' record */
+    void writePending(char kind);
+    /** start a record, returns the position of its length */
+    std::size_t startRecord(char kind);
+    void endRecord(std::size_t start);
+
+    std::ostream &mOut;
+    std::string mBuffer;
+    /**
+     * shape ids. The key is the addresses of the tag and attribute
+     * names, which are string literals.
+     */
+    std::unordered_map<std::string, unsigned int> mShapes;
+
+    /** the element that has been started, until its kind is known */
+    std::vector<const char *> mPendingNames;
+    std::string mPendingShape;
+    std::string mPendingValues;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // dumpwriterH
@@ -29,6 +29,7 @@
 #include <array>
 #include <cassert>
 #include <cctype>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <iomanip>
@@ -49,6 +50,9 @@ InternalError::InternalError(const Token *tok, const std::string &errorMsg, Type
     case INTERNAL:
         id = "cppcheckError";
         break;
+    case LIMIT:
+        id = "cppcheckLimit";
+        break;
     }
 }
 
@@ -386,54 +390,121 @@ std::string ErrorLogger::ErrorMessage::fixInvalidChars(const std::string& raw)
     return result;
 }
 
+// Escape like tinyxml2::XMLPrinter does it: all entities in attributes, only & < > in text
+static void appendXmlEscaped(std::string &out, char c, bool attribute)
+{
+    switch (c) {
+    case '&':
+        out += "&amp;";
+        break;
+    case '<':
+        out += "&lt;";
+        break;
+    case '>':
+        out += "&gt;";
+        break;
+    case '\"':
+        out += attribute ? "&quot;" : "\"";
+        break;
+    case '\'':
+        out += attribute ? "&apos;" : "\'";
+        break;
+    default:
+        out += c;
+        break;
+    }
+}
+
+static void appendXmlEscaped(std::string &out, const char *str, bool attribute)
+{
+    for (; *str; ++str)
+        appendXmlEscaped(out, *str, attribute);
+}
+
+static void appendXmlAttribute(std::string &out, const char name[], const std::string &value)
+{
+    out += ' ';
+    out += name;
+    out += "=\"";
+    appendXmlEscaped(out, value.c_str(), true);
+    out += '\"';
+}
+
+static void appendXmlAttribute(std::string &out, const char name[], long long value)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%lld", value);
+    out += ' ';
+    out += name;
+    out += "=\"";
+    out += buf;
+    out += '\"';
+}
+
+/** Same as appendXmlAttribute(out, name, fixInvalidChars(value)) without the temporary string */
+static void appendXmlAttributeFixInvalidChars(std::string &out, const char name[], const std::string &value)
+{
+    out += ' ';
+    out += name;
+    out += "=\"";
+    for (const char c : value) {
+        if (std::isprint(static_cast<unsigned char>(c)))
+            appendXmlEscaped(out, c, true);
+        else {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\%03o", static_cast<unsigned int>(static_cast<unsigned char>(c)));
+            out += buf;
+        }
+    }
+    out += '\"';
+}
+
 std::string ErrorLogger::ErrorMessage::toXML() const
 {
-    tinyxml2::XMLPrinter printer(nullptr, false, 2);
-    printer.OpenElement("error", false);
-    printer.PushAttribute("id", _id.c_str());
-    printer.PushAttribute("severity", Severity::toString(_severity).c_str());
-    printer.PushAttribute("msg", fixInvalidChars(mShortMessage).c_str());
-    printer.PushAttribute("verbose", fixInvalidChars(mVerboseMessage).c_str());
+    std::string result;
+    appendXML(result);
+    return result;
+}
+
+void ErrorLogger::ErrorMessage::appendXML(std::string &out) const
+{
+    // Same output as tinyxml2::XMLPrinter(nullptr, false, 2)
+    out += "        <error";
+    appendXmlAttribute(out, "id", _id);
+    appendXmlAttribute(out, "severity", Severity::toString(_severity));
+    appendXmlAttributeFixInvalidChars(out, "msg", mShortMessage);
+    appendXmlAttributeFixInvalidChars(out, "verbose", mVerboseMessage);
     if (_cwe.id)
-        printer.PushAttribute("cwe", _cwe.id);
+        appendXmlAttribute(out, "cwe", _cwe.id);
     if (_inconclusive)
-        printer.PushAttribute("inconclusive", "true");
+        appendXmlAttribute(out, "inconclusive", "true");
+
+    if (_callStack.empty() && mSymbolNames.empty()) {
+        out += "/>";
+        return;
+    }
+    out += '>';
 
     for (std::list<FileLocation>::const_reverse_iterator it = _callStack.rbegin(); it != _callStack.rend(); ++it) {
-        printer.OpenElement("location", false);
+        out += "\n            <location";
         if (!file0.empty() && (*it).getfile() != file0)
-            printer.PushAttribute("file0", Path::toNativeSeparators(file0).c_str());
-        printer.PushAttribute("file", (*it).getfile().c_str());
-        printer.PushAttribute("line", std::max((*it).line,0));
+            appendXmlAttribute(out, "file0", Path::toNativeSeparators(file0));
+        appendXmlAttribute(out, "file", (*it).getfile());
+        appendXmlAttribute(out, "line", std::max((*it).line,0));
         if (!it->getinfo().empty())
-            printer.PushAttribute("info", it->getinfo().c_str());
-        printer.CloseElement(false);
+            appendXmlAttribute(out, "info", it->getinfo());
+        out += "/>";
     }
     for (std::string::size_type pos = 0; pos < mSymbolNames.size();) {
-        const std::string::size_type pos2 = mSymbolNames.find('\n', pos);
-        std::string symbolName;
-        if (pos2 == std::string::npos) {
-            symbolName = mSymbolNames.substr(pos);
-            pos = pos2;
-        } else {
-            symbolName = mSymbolNames.substr(pos, pos2-pos);
-            pos = pos2 + 1;
-        }
-        printer.OpenElement("symbol", false);
-        printer.PushText(symbolName.c_str());
-        printer.CloseElement(false);
-    }
-    printer.CloseElement(false);
-    return printer.CStr();
-}
-
-void ErrorLogger::ErrorMessage::findAndReplace(std::string &source, const std::string &searchFor, const std::string &replaceWith)
-{
-    std::string::size_type index = 0;
-    while ((index = source.find(searchFor, index)) != std::string::npos) {
-        source.replace(index, searchFor.length(), replaceWith);
-        index += replaceWith.length();
+        std::string::size_type pos2 = mSymbolNames.find('\n', pos);
+        if (pos2 == std::string::npos)
+            pos2 = mSymbolNames.size();
+        out += "\n            <symbol>";
+        appendXmlEscaped(out, mSymbolNames.substr(pos, pos2-pos).c_str(), false);
+        out += "</symbol>";
+        pos = pos2 + 1;
     }
+    out += "\n        </error>";
 }
 
 // TODO: read info from some shared resource instead?
@@ -453,97 +524,133 @@ static std::string readCode(const std::string &file, unsigned int linenr, unsign
     return line + endl + std::string((column>0 ? column-1 : column), ' ') + '^';
 }
 
+static bool noFields(std::string &, const std::string &)
+{
+    return false;
+}
+
+/**
+ * Append template to out. The escapes \\b, \\n, \\r and \\t are replaced
+ * and the fields "{name}" are written by the field callback, which
+ * returns false for unknown fields. Unknown fields are kept.
+ */
+template<class F>
+static void appendTemplate(std::string &out, const std::string &templateFormat, F field)
+{
+    for (std::string::size_type pos = 0; pos < templateFormat.size(); ++pos) {
+        const char c = templateFormat[pos];
+        if (c == '\\' && pos + 1 < templateFormat.size()) {
+            const char e = templateFormat[pos + 1];
+            if (e == 'b' || e == 'n' || e == 'r' || e == 't') {
+                out += (e == 'b') ? '\b' : (e == 'n') ? '\n' : (e == 'r') ? '\r' : '\t';
+                ++pos;
+                continue;
+            }
+        } else if (c == '{') {
+            const std::string::size_type end = templateFormat.find('}', pos + 1);
+            if (end != std::string::npos && field(out, templateFormat.substr(pos + 1, end - pos - 1))) {
+                pos = end;
+                continue;
+            }
+        }
+        out += c;
+    }
+}
+
+/** Line ending of {code}, the same as the template uses */
+static const char *templateEndl(const std::string &templateFormat)
+{
+    std::string text;
+    appendTemplate(text, templateFormat, noFields);
+    const std::string::size_type pos = text.find('\r');
+    if (pos == std::string::npos)
+        return "\n";
+    if (pos+1 < text.size() && text[pos+1] == '\n')
+        return "\r\n";
+    return "\r";
+}
+
 std::string ErrorLogger::ErrorMessage::toString(bool verbose, const std::string &templateFormat, const std::string &templateLocation) const
+{
+    std::string result;
+    appendString(result, verbose, templateFormat, templateLocation);
+    return result;
+}
+
+void ErrorLogger::ErrorMessage::appendString(std::string &out, bool verbose, const std::string &templateFormat, const std::string &templateLocation) const
 {
     // Save this ErrorMessage in plain text.
 
     // No template is given
     if (templateFormat.empty()) {
-        std::ostringstream text;
-        if (!_callStack.empty())
-            text << callStackToString(_callStack) << ": ";
+        if (!_callStack.empty()) {
+            out += callStackToString(_callStack);
+            out += ": ";
+        }
         if (_severity != Severity::none) {
-            text << '(' << Severity::toString(_severity);
+            out += '(';
+            out += Severity::toString(_severity);
             if (_inconclusive)
-                text << ", inconclusive";
-            text << ") ";
+                out += ", inconclusive";
+            out += ") ";
         }
-        text << (verbose ? mVerboseMessage : mShortMessage);
-        return text.str();
+        out += verbose ? mVerboseMessage : mShortMessage;
+        return;
     }
 
     // template is given. Reformat the output according to it
-    std::string result = templateFormat;
     // Support a few special characters to allow to specific formatting, see http://sourceforge.net/apps/phpbb/cppcheck/viewtopic.php?f=4&t=494&sid=21715d362c0dbafd3791da4d9522f814
-    // Substitution should be done first so messages from cppcheck never get translated.
-    findAndReplace(result, "\\b", "\b");
-    findAndReplace(result, "\\n", "\n");
-    findAndReplace(result, "\\r", "\r");
-    findAndReplace(result, "\\t", "\t");
-
-    findAndReplace(result, "{id}", _id);
-    if (result.find("{inconclusive:") != std::string::npos) {
-        const std::string::size_type pos1 = result.find("{inconclusive:");
-        const std::string::size_type pos2 = result.find('}', pos1+1);
-        const std::string replaceFrom = result.substr(pos1,pos2-pos1+1);
-        const std::string replaceWith = _inconclusive ? result.substr(pos1+14, pos2-pos1-14) : std::string();
-        findAndReplace(result, replaceFrom, replaceWith);
-    }
-    findAndReplace(result, "{severity}", Severity::toString(_severity));
-    findAndReplace(result, "{cwe}", MathLib::toString(_cwe.id));
-    findAndReplace(result, "{message}", verbose ? mVerboseMessage : mShortMessage);
-    findAndReplace(result, "{callstack}", _callStack.empty() ? emptyString : callStackToString(_callStack));
-    if (!_callStack.empty()) {
-        findAndReplace(result, "{file}", _callStack.back().getfile());
-        findAndReplace(result, "{line}", MathLib::toString(_callStack.back().line));
-        findAndReplace(result, "{column}", MathLib::toString(_callStack.back().col));
-        if (result.find("{code}") != std::string::npos) {
-            const std::string::size_type pos = result.find('\r');
-            const char *endl;
-            if (pos == std::string::npos)
-                endl = "\n";
-            else if (pos+1 < result.size() && result[pos+1] == '\n')
-                endl = "\r\n";
-            else
-                endl = "\r";
-            findAndReplace(result, "{code}", readCode(_callStack.back().getOrigFile(), _callStack.back().line, _callStack.back().col, endl));
-        }
-    } else {
-        findAndReplace(result, "{file}", "nofile");
-        findAndReplace(result, "{line}", "0");
-        findAndReplace(result, "{column}", "0");
-        findAndReplace(result, "{code}", emptyString);
-    }
+    // Only the template is substituted, so messages from cppcheck never get translated.
+    const FileLocation *location = _callStack.empty() ? nullptr : &_callStack.back();
+    appendTemplate(out, templateFormat, [&](std::string &o, const std::string &name) -> bool {
+        if (name == "id")
+            o += _id;
+        else if (name.compare(0, 13, "inconclusive:") == 0) {
+            if (_inconclusive)
+                appendTemplate(o, name.substr(13), noFields);
+        } else if (name == "severity")
+            o += Severity::toString(_severity);
+        else if (name == "cwe")
+            o += MathLib::toString(_cwe.id);
+        else if (name == "message")
+            o += verbose ? mVerboseMessage : mShortMessage;
+        else if (name == "callstack") {
+            if (location)
+                o += callStackToString(_callStack);
+        } else if (name == "file")
+            o += location ? location->getfile() : "nofile";
+        else if (name == "line")
+            o += location ? MathLib::toString(location->line) : "0";
+        else if (name == "column")
+            o += location ? MathLib::toString(location->col) : "0";
+        else if (name == "code") {
+            if (location)
+                o += readCode(location->getOrigFile(), location->line, location->col, templateEndl(templateFormat));
+        } else
+            return false;
+        return true;
+    });
 
     if (!templateLocation.empty() && _callStack.size() >= 2U) {
         for (const FileLocation &fileLocation : _callStack) {
-            std::string text = templateLocation;
-
-            findAndReplace(text, "\\b", "\b");
-            findAndReplace(text, "\\n", "\n");
-            findAndReplace(text, "\\r", "\r");
-            findAndReplace(text, "\\t", "\t");
-
-            findAndReplace(text, "{file}", fileLocation.getfile());
-            findAndReplace(text, "{line}", MathLib::toString(fileLocation.line));
-            findAndReplace(text, "{column}", MathLib::toString(fileLocation.col));
-            findAndReplace(text, "{info}", fileLocation.getinfo().empty() ? mShortMessage : fileLocation.getinfo());
-            if (text.find("{code}") != std::string::npos) {
-                const std::string::size_type pos = text.find('\r');
-                const char *endl;
-                if (pos == std::string::npos)
-                    endl = "\n";
-                else if (pos+1 < text.size() && text[pos+1] == '\n')
-                    endl = "\r\n";
+            out += '\n';
+            appendTemplate(out, templateLocation, [&](std::string &o, const std::string &name) -> bool {
+                if (name == "file")
+                    o += fileLocation.getfile();
+                else if (name == "line")
+                    o += MathLib::toString(fileLocation.line);
+                else if (name == "column")
+                    o += MathLib::toString(fileLocation.col);
+                else if (name == "info")
+                    o += fileLocation.getinfo().empty() ? mShortMessage : fileLocation.getinfo();
+                else if (name == "code")
+                    o += readCode(fileLocation.getOrigFile(), fileLocation.line, fileLocation.col, templateEndl(templateLocation));
                 else
-                    endl = "\r";
-                findAndReplace(text, "{code}", readCode(fileLocation.getOrigFile(), fileLocation.line, fileLocation.col, endl));
-            }
-            result += '\n' + text;
+                    return false;
+                return true;
+            });
         }
     }
-
-    return result;
 }
 
 void ErrorLogger::reportUnmatchedSuppressions(const std::list<Suppressions::Suppression> &unmatched)
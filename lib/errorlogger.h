@@ -54,7 +54,7 @@ namespace tinyxml2 {
 
 /** @brief Simple container to be thrown when internal error is detected. */
 struct InternalError {
-    enum Type {AST, SYNTAX, UNKNOWN_MACRO, INTERNAL};
+    enum Type {AST, SYNTAX, UNKNOWN_MACRO, INTERNAL, LIMIT};
     InternalError(const Token *tok, const std::string &errorMsg, Type type = INTERNAL);
     const Token *token;
     std::string errorMessage;
@@ -254,6 +254,9 @@ public:
          */
         std::string toXML() const;
 
+        /** Append the error message in XML format to out */
+        void appendXML(std::string &out) const;
+
         static std::string getXMLHeader();
         static std::string getXMLFooter();
 
@@ -268,6 +271,9 @@ public:
          */
         std::string toString(bool verbose, const std::string &templateFormat = emptyString, const std::string &templateLocation = emptyString) const;
 
+        /** Append the error message formatted like toString() does it to out */
+        void appendString(std::string &out, bool verbose, const std::string &templateFormat = emptyString, const std::string &templateLocation = emptyString) const;
+
         std::string serialize() const;
         bool deserialize(const std::string &data);
 
@@ -302,15 +308,6 @@ public:
         Suppressions::ErrorMessage toSuppressionsErrorMessage() const;
 
     private:
-        /**
-         * Replace all occurrences of searchFor with replaceWith in the
-         * given source.
-         * @param source The string to modify
-         * @param searchFor What should be searched for
-         * @param replaceWith What will replace the found item
-         */
-        static void findAndReplace(std::string &source, const std::string &searchFor, const std::string &replaceWith);
-
         static std::string fixInvalidChars(const std::string& raw);
 
         /** Short message */
@@ -359,6 +356,32 @@ public:
         (void)value;
     }
 
+    /**
+     * Report how expensive it is to check a configuration of a file,
+     * before the checks are run
+     * @param filename main file that is checked
+     * @param cfg configuration
+     * @param cost estimated cost, see Tokenizer::estimateCost()
+     */
+    virtual void reportFileCost(const std::string &filename, const std::string &cfg, std::size_t cost) {
+        (void)filename;
+        (void)cfg;
+        (void)cost;
+    }
+
+    /**
+     * Report how much memory checking a configuration of a file uses,
+     * before the checks are run
+     * @param filename main file that is checked
+     * @param cfg configuration
+     * @param bytes estimated memory usage, see Tokenizer::memoryUsage()
+     */
+    virtual void reportMemoryUsage(const std::string &filename, const std::string &cfg, std::size_t bytes) {
+        (void)filename;
+        (void)cfg;
+        (void)bytes;
+    }
+
     /**
      * Output information messages.
      * @param msg Location and other information about the found error.
@@ -32,7 +32,9 @@ HEADERS += $${PWD}/check.h \
            $${PWD}/checkunusedfunctions.h \
            $${PWD}/checkunusedvar.h \
            $${PWD}/checkvaarg.h \
+           $${PWD}/counters.h \
            $${PWD}/cppcheck.h \
+           $${PWD}/dumpwriter.h \
            $${PWD}/errorlogger.h \
            $${PWD}/importproject.h \
            $${PWD}/library.h \
@@ -41,7 +43,12 @@ HEADERS += $${PWD}/check.h \
            $${PWD}/pathmatch.h \
            $${PWD}/platform.h \
            $${PWD}/preprocessor.h \
+           $${PWD}/rulematcher.h \
            $${PWD}/settings.h \
+           $${PWD}/smallvector.h \
+           $${PWD}/subprocess.h \
+           $${PWD}/stablevector.h \
+           $${PWD}/stringhashmap.h \
            $${PWD}/suppressions.h \
            $${PWD}/symboldatabase.h \
            $${PWD}/templatesimplifier.h \
@@ -49,6 +56,7 @@ HEADERS += $${PWD}/check.h \
            $${PWD}/token.h \
            $${PWD}/tokenize.h \
            $${PWD}/tokenlist.h \
+           $${PWD}/tokenpatterntable.h \
            $${PWD}/valueflow.h \
 
 
@@ -80,7 +88,9 @@ SOURCES += $${PWD}/analyzerinfo.cpp \
            $${PWD}/checkunusedfunctions.cpp \
            $${PWD}/checkunusedvar.cpp \
            $${PWD}/checkvaarg.cpp \
+           $${PWD}/counters.cpp \
            $${PWD}/cppcheck.cpp \
+           $${PWD}/dumpwriter.cpp \
            $${PWD}/errorlogger.cpp \
            $${PWD}/importproject.cpp \
            $${PWD}/library.cpp \
@@ -89,7 +99,9 @@ SOURCES += $${PWD}/analyzerinfo.cpp \
            $${PWD}/pathmatch.cpp \
            $${PWD}/platform.cpp \
            $${PWD}/preprocessor.cpp \
+           $${PWD}/rulematcher.cpp \
            $${PWD}/settings.cpp \
+           $${PWD}/subprocess.cpp \
            $${PWD}/suppressions.cpp \
            $${PWD}/symboldatabase.cpp \
            $${PWD}/templatesimplifier.cpp \
@@ -97,4 +109,5 @@ SOURCES += $${PWD}/analyzerinfo.cpp \
            $${PWD}/token.cpp \
            $${PWD}/tokenize.cpp \
            $${PWD}/tokenlist.cpp \
+           $${PWD}/tokenpatterntable.cpp \
            $${PWD}/valueflow.cpp
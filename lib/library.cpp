@@ -26,11 +26,18 @@
 #include "token.h"
 #include "tokenlist.h"
 #include "utils.h"
+#include "version.h"
 
 #include <cctype>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
 #include <list>
+#include <sstream>
 
 static std::vector<std::string> getnames(const char *names)
 {
@@ -55,7 +62,357 @@ static void gettokenlistfromvalid(const std::string& valid, TokenList& tokenList
     }
 }
 
-Library::Library() : mAllocId(0)
+namespace {
+    const char cacheMagic[] = "cppcheck-cfg-cache";
+
+    /** Increment this when the cached library tables are changed */
+    const unsigned int cacheFormat = 2;
+
+    /** Serialization of the library tables in the binary cache format */
+    class CacheWriter {
+    public:
+        explicit CacheWriter(std::string *data) : mData(data) {}
+
+        void write(unsigned int value) {
+            for (int i = 0; i < 4; ++i)
+                mData->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+        void write(int value) {
+            write(static_cast<unsigned int>(value));
+        }
+        void write(bool value) {
+            mData->push_back(value ? 1 : 0);
+        }
+        void write(char value) {
+            mData->push_back(value);
+        }
+        void write(const std::string &str) {
+            write(static_cast<unsigned int>(str.size()));
+            mData->append(str);
+        }
+        void write(const Library::AllocFunc &func) {
+            write(func.groupId);
+            write(func.arg);
+        }
+        void write(const Library::WarnInfo &warn) {
+            write(warn.message);
+            write(static_cast<int>(warn.standards.c));
+            write(static_cast<int>(warn.standards.cpp));
+            write(warn.standards.posix);
+            write(static_cast<int>(warn.severity));
+        }
+        void write(const Library::Container::Function &func) {
+            write(static_cast<int>(func.action));
+            write(static_cast<int>(func.yield));
+        }
+        void write(const Library::Container &container) {
+            write(container.startPattern);
+            write(container.endPattern);
+            write(container.itEndPattern);
+            write(container.functions);
+            write(container.type_templateArgNo);
+            write(container.size_templateArgNo);
+            write(container.arrayLike_indexOp);
+            write(container.stdStringLike);
+            write(container.opLessAllowed);
+        }
+        void write(const Library::ArgumentChecks::MinSize &minsize) {
+            write(static_cast<int>(minsize.type));
+            write(minsize.arg);
+            write(minsize.arg2);
+        }
+        void write(const Library::ArgumentChecks &ac) {
+            write(ac.notbool);
+            write(ac.notnull);
+            write(ac.notuninit);
+            write(ac.formatstr);
+            write(ac.strz);
+            write(ac.optional);
+            write(ac.variadic);
+            write(ac.valid);
+            write(ac.iteratorInfo.container);
+            write(ac.iteratorInfo.it);
+            write(ac.iteratorInfo.first);
+            write(ac.iteratorInfo.last);
+            write(ac.minsizes);
+        }
+        void write(const Library::Function &func) {
+            write(func.argumentChecks);
+            write(func.use);
+            write(func.leakignore);
+            write(func.isconst);
+            write(func.ispure);
+            write(func.useretval);
+            write(func.ignore);
+            write(func.formatstr);
+            write(func.formatstr_scan);
+            write(func.formatstr_secure);
+        }
+        void write(const Library::PodType &podtype) {
+            write(podtype.size);
+            write(podtype.sign);
+        }
+        void write(const Library::PlatformType &type) {
+            write(type.mType);
+            write(type._signed);
+            write(type._unsigned);
+            write(type._long);
+            write(type._pointer);
+            write(type._ptr_ptr);
+            write(type._const_ptr);
+        }
+        void write(const Library::Platform &platform) {
+            write(platform.mPlatformTypes);
+        }
+        template<class T> void write(const std::vector<T> &values) {
+            write(static_cast<unsigned int>(values.size()));
+            for (typename std::vector<T>::const_iterator it = values.begin(); it != values.end(); ++it)
+                write(*it);
+        }
+        template<class T> void write(const std::set<T> &values) {
+            write(static_cast<unsigned int>(values.size()));
+            for (typename std::set<T>::const_iterator it = values.begin(); it != values.end(); ++it)
+                write(*it);
+        }
+        template<class V> void write(const StringHashMap<V> &values) {
+            write(static_cast<unsigned int>(values.size()));
+            for (typename StringHashMap<V>::const_iterator it = values.begin(); it != values.end(); ++it) {
+                write(it->first);
+                write(it->second);
+            }
+        }
+        template<class K, class V> void write(const std::map<K, V> &values) {
+            write(static_cast<unsigned int>(values.size()));
+            for (typename std::map<K, V>::const_iterator it = values.begin(); it != values.end(); ++it) {
+                write(it->first);
+                write(it->second);
+            }
+        }
+
+    private:
+        std::string *mData;
+    };
+
+    /** Deserialization of the binary cache format, all reads fail after the first error */
+    class CacheReader {
+    public:
+        explicit CacheReader(const std::string &data) : mData(data), mPos(0), mOk(true) {}
+
+        bool ok() const {
+            return mOk;
+        }
+        bool atEnd() const {
+            return mPos == mData.size();
+        }
+
+        void read(unsigned int *value) {
+            *value = 0;
+            if (!available(4))
+                return;
+            for (int i = 0; i < 4; ++i)
+                *value |= static_cast<unsigned int>(static_cast<unsigned char>(mData[mPos++])) << (8 * i);
+        }
+        void read(int *value) {
+            unsigned int u;
+            read(&u);
+            *value = static_cast<int>(u);
+        }
+        void read(bool *value) {
+            *value = available(1) && mData[mPos++] != 0;
+        }
+        void read(char *value) {
+            *value = available(1) ? mData[mPos++] : 0;
+        }
+        void read(std::string *str) {
+            unsigned int size;
+            read(&size);
+            if (!available(size))
+                return;
+            str->assign(mData, mPos, size);
+            mPos += size;
+        }
+        template<class E> void readEnum(E *value) {
+            int i;
+            read(&i);
+            *value = static_cast<E>(i);
+        }
+        void read(Library::AllocFunc *func) {
+            read(&func->groupId);
+            read(&func->arg);
+        }
+        void read(Library::WarnInfo *warn) {
+            read(&warn->message);
+            readEnum(&warn->standards.c);
+            readEnum(&warn->standards.cpp);
+            read(&warn->standards.posix);
+            readEnum(&warn->severity);
+        }
+        void read(Library::Container::Function *func) {
+            readEnum(&func->action);
+            readEnum(&func->yield);
+        }
+        void read(Library::Container *container) {
+            read(&container->startPattern);
+            read(&container->endPattern);
+            read(&container->itEndPattern);
+            read(&container->functions);
+            read(&container->type_templateArgNo);
+            read(&container->size_templateArgNo);
+            read(&container->arrayLike_indexOp);
+            read(&container->stdStringLike);
+            read(&container->opLessAllowed);
+        }
+        void read(std::vector<Library::ArgumentChecks::MinSize> *minsizes) {
+            unsigned int size;
+            read(&size);
+            for (unsigned int i = 0; i < size && mOk; ++i) {
+                Library::ArgumentChecks::MinSize minsize(Library::ArgumentChecks::MinSize::NONE, 0);
+                readEnum(&minsize.type);
+                read(&minsize.arg);
+                read(&minsize.arg2);
+                minsizes->push_back(minsize);
+            }
+        }
+        void read(Library::ArgumentChecks *ac) {
+            read(&ac->notbool);
+            read(&ac->notnull);
+            read(&ac->notuninit);
+            read(&ac->formatstr);
+            read(&ac->strz);
+            read(&ac->optional);
+            read(&ac->variadic);
+            read(&ac->valid);
+            read(&ac->iteratorInfo.container);
+            read(&ac->iteratorInfo.it);
+            read(&ac->iteratorInfo.first);
+            read(&ac->iteratorInfo.last);
+            read(&ac->minsizes);
+        }
+        void read(Library::Function *func) {
+            read(&func->argumentChecks);
+            read(&func->use);
+            read(&func->leakignore);
+            read(&func->isconst);
+            read(&func->ispure);
+            read(&func->useretval);
+            read(&func->ignore);
+            read(&func->formatstr);
+            read(&func->formatstr_scan);
+            read(&func->formatstr_secure);
+        }
+        void read(Library::PodType *podtype) {
+            read(&podtype->size);
+            read(&podtype->sign);
+        }
+        void read(Library::PlatformType *type) {
+            read(&type->mType);
+            read(&type->_signed);
+            read(&type->_unsigned);
+            read(&type->_long);
+            read(&type->_pointer);
+            read(&type->_ptr_ptr);
+            read(&type->_const_ptr);
+        }
+        void read(Library::Platform *platform) {
+            read(&platform->mPlatformTypes);
+        }
+        template<class T> void read(std::vector<T> *values) {
+            unsigned int size;
+            read(&size);
+            for (unsigned int i = 0; i < size && mOk; ++i) {
+                T value;
+                read(&value);
+                values->push_back(value);
+            }
+        }
+        template<class T> void read(std::set<T> *values) {
+            unsigned int size;
+            read(&size);
+            for (unsigned int i = 0; i < size && mOk; ++i) {
+                T value;
+                read(&value);
+                values->insert(value);
+            }
+        }
+        template<class V> void read(StringHashMap<V> *values) {
+            unsigned int size;
+            read(&size);
+            for (unsigned int i = 0; i < size && mOk; ++i) {
+                std::string key;
+                read(&key);
+                read(&(*values)[key]);
+            }
+        }
+        template<class K, class V> void read(std::map<K, V> *values) {
+            unsigned int size;
+            read(&size);
+            for (unsigned int i = 0; i < size && mOk; ++i) {
+                K key;
+                read(&key);
+                read(&(*values)[key]);
+            }
+        }
+
+    private:
+        bool available(std::size_t size) {
+            if (mOk && mData.size() - mPos < size)
+                mOk = false;
+            return mOk;
+        }
+
+        const std::string &mData;
+        std::size_t mPos;
+        bool mOk;
+    };
+
+    /** FNV-1a hash of the data */
+    unsigned long long fnv1a(const std::string &data)
+    {
+        unsigned long long hash = 14695981039346656037ULL;
+        for (std::string::const_iterator it = data.begin(); it != data.end(); ++it) {
+            hash ^= static_cast<unsigned char>(*it);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    /**
+     * path, size and content hash of a file, empty if the file can't be read.
+     * The modification time is not used, its resolution is too coarse to
+     * notice a file that is rewritten within the same second.
+     */
+    std::string fileStamp(const std::string &path)
+    {
+        std::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+        if (!fin.is_open())
+            return "";
+        std::ostringstream content;
+        content << fin.rdbuf();
+        const std::string data = content.str();
+        std::ostringstream ostr;
+        ostr << path << '\n' << data.size() << '\n' << std::hex << fnv1a(data) << '\n';
+        return ostr.str();
+    }
+
+    bool fileExists(const std::string &path)
+    {
+        std::ifstream fin(path.c_str());
+        return fin.is_open();
+    }
+
+    std::string getCacheFilename(const std::string &directory, const std::string &key)
+    {
+        const unsigned long long hash = fnv1a(key);
+        std::ostringstream ostr;
+        ostr << directory;
+        if (!directory.empty() && !endsWith(directory, '/') && !endsWith(directory, '\\'))
+            ostr << '/';
+        ostr << "cfg-" << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+        return ostr.str();
+    }
+}
+
+Library::Library() : mAllocId(0), mCacheable(true)
 {
 }
 
@@ -77,18 +434,17 @@ Library::Error Library::load(const char exename[], const char path[])
         return Error();
     }
 
-    std::string absolute_path;
-    // open file..
-    tinyxml2::XMLDocument doc;
-    tinyxml2::XMLError error = doc.LoadFile(path);
-    if (error == tinyxml2::XML_ERROR_FILE_NOT_FOUND) {
+    // find file..
+    std::string filename;
+    if (fileExists(path))
+        filename = path;
+    else {
         // failed to open file.. is there no extension?
         std::string fullfilename(path);
         if (Path::getFilenameExtension(fullfilename).empty()) {
             fullfilename += ".cfg";
-            error = doc.LoadFile(fullfilename.c_str());
-            if (error != tinyxml2::XML_ERROR_FILE_NOT_FOUND)
-                absolute_path = Path::getAbsoluteFilePath(fullfilename);
+            if (fileExists(fullfilename))
+                filename = fullfilename;
         }
 
         std::list<std::string> cfgfolders;
@@ -101,30 +457,202 @@ Library::Error Library::load(const char exename[], const char path[])
             cfgfolders.push_back(exepath);
         }
 
-        while (error == tinyxml2::XML_ERROR_FILE_NOT_FOUND && !cfgfolders.empty()) {
+        while (filename.empty() && !cfgfolders.empty()) {
             const std::string cfgfolder(cfgfolders.front());
             cfgfolders.pop_front();
             const char *sep = (!cfgfolder.empty() && endsWith(cfgfolder,'/') ? "" : "/");
-            const std::string filename(cfgfolder + sep + fullfilename);
-            error = doc.LoadFile(filename.c_str());
-            if (error != tinyxml2::XML_ERROR_FILE_NOT_FOUND)
-                absolute_path = Path::getAbsoluteFilePath(filename);
+            if (fileExists(cfgfolder + sep + fullfilename))
+                filename = cfgfolder + sep + fullfilename;
         }
-    } else
-        absolute_path = Path::getAbsoluteFilePath(path);
+    }
 
-    if (error == tinyxml2::XML_SUCCESS) {
-        if (mFiles.find(absolute_path) == mFiles.end()) {
-            Error err = load(doc);
-            if (err.errorcode == OK)
-                mFiles.insert(absolute_path);
-            return err;
-        }
+    if (filename.empty())
+        return Error(FILE_NOT_FOUND);
 
+    const std::string absolute_path = Path::getAbsoluteFilePath(filename);
+    if (mFiles.find(absolute_path) != mFiles.end())
         return Error(OK); // ignore duplicates
+
+    const std::string key = mLoadedFilesKey + fileStamp(absolute_path);
+    if (mCacheable && !mCacheDirectory.empty() && loadCache(key))
+        return Error(OK);
+
+    tinyxml2::XMLDocument doc;
+    if (doc.LoadFile(filename.c_str()) != tinyxml2::XML_SUCCESS)
+        return Error(BAD_XML);
+
+    const Error err = loadXml(doc);
+    if (err.errorcode != OK) {
+        // the tables might be partially loaded
+        mCacheable = false;
+        return err;
+    }
+    mFiles.insert(absolute_path);
+    mLoadedFilesKey = key;
+    if (mCacheable && !mCacheDirectory.empty())
+        saveCache(key);
+    return err;
+}
+
+void Library::writeCache(std::string *data, const std::string &key) const
+{
+    CacheWriter writer(data);
+    writer.write(std::string(cacheMagic));
+    writer.write(cacheFormat);
+    writer.write(std::string(CPPCHECK_VERSION_STRING));
+    writer.write(key);
+    writer.write(functionwarn);
+    writer.write(containers);
+    writer.write(functions);
+    writer.write(returnuninitdata);
+    writer.write(defines);
+    writer.write(mAllocId);
+    writer.write(mFiles);
+    writer.write(mAlloc);
+    writer.write(mDealloc);
+    writer.write(mNoReturn);
+    writer.write(mReturnValue);
+    writer.write(mReturnValueType);
+    writer.write(mReturnValueContainer);
+    writer.write(mReportErrors);
+    writer.write(mProcessAfterCode);
+    writer.write(mMarkupExtensions);
+    writer.write(mKeywords);
+    writer.write(static_cast<unsigned int>(mExecutableBlocks.size()));
+    for (std::map<std::string, CodeBlock>::const_iterator it = mExecutableBlocks.begin(); it != mExecutableBlocks.end(); ++it) {
+        writer.write(it->first);
+        writer.write(it->second.start());
+        writer.write(it->second.end());
+        writer.write(it->second.offset());
+        writer.write(it->second.blocks());
+    }
+    writer.write(static_cast<unsigned int>(mExporters.size()));
+    for (std::map<std::string, ExportedFunctions>::const_iterator it = mExporters.begin(); it != mExporters.end(); ++it) {
+        writer.write(it->first);
+        writer.write(it->second.prefixes());
+        writer.write(it->second.suffixes());
+    }
+    writer.write(mImporters);
+    writer.write(mReflection);
+    writer.write(mPodTypes);
+    writer.write(mPlatformTypes);
+    writer.write(mPlatforms);
+}
+
+bool Library::readCache(const std::string &data, const std::string &key)
+{
+    CacheReader reader(data);
+    std::string magic, version, cachedKey;
+    unsigned int format;
+    reader.read(&magic);
+    reader.read(&format);
+    reader.read(&version);
+    reader.read(&cachedKey);
+    if (!reader.ok() || magic != cacheMagic || format != cacheFormat || version != CPPCHECK_VERSION_STRING || cachedKey != key)
+        return false;
+
+    reader.read(&functionwarn);
+    reader.read(&containers);
+    reader.read(&functions);
+    reader.read(&returnuninitdata);
+    reader.read(&defines);
+    reader.read(&mAllocId);
+    reader.read(&mFiles);
+    reader.read(&mAlloc);
+    reader.read(&mDealloc);
+    reader.read(&mNoReturn);
+    reader.read(&mReturnValue);
+    reader.read(&mReturnValueType);
+    reader.read(&mReturnValueContainer);
+    reader.read(&mReportErrors);
+    reader.read(&mProcessAfterCode);
+    reader.read(&mMarkupExtensions);
+    reader.read(&mKeywords);
+    unsigned int size;
+    reader.read(&size);
+    for (unsigned int i = 0; i < size && reader.ok(); ++i) {
+        std::string name, start, end;
+        int offset;
+        std::set<std::string> blocks;
+        reader.read(&name);
+        reader.read(&start);
+        reader.read(&end);
+        reader.read(&offset);
+        reader.read(&blocks);
+        CodeBlock &codeblock = mExecutableBlocks[name];
+        codeblock.setStart(start.c_str());
+        codeblock.setEnd(end.c_str());
+        codeblock.setOffset(offset);
+        for (std::set<std::string>::const_iterator it = blocks.begin(); it != blocks.end(); ++it)
+            codeblock.addBlock(it->c_str());
+    }
+    reader.read(&size);
+    for (unsigned int i = 0; i < size && reader.ok(); ++i) {
+        std::string name;
+        std::set<std::string> prefixes, suffixes;
+        reader.read(&name);
+        reader.read(&prefixes);
+        reader.read(&suffixes);
+        ExportedFunctions &exporter = mExporters[name];
+        for (std::set<std::string>::const_iterator it = prefixes.begin(); it != prefixes.end(); ++it)
+            exporter.addPrefix(*it);
+        for (std::set<std::string>::const_iterator it = suffixes.begin(); it != suffixes.end(); ++it)
+            exporter.addSuffix(*it);
     }
+    reader.read(&mImporters);
+    reader.read(&mReflection);
+    reader.read(&mPodTypes);
+    reader.read(&mPlatformTypes);
+    reader.read(&mPlatforms);
+    return reader.ok() && reader.atEnd();
+}
 
-    return Error(error == tinyxml2::XML_ERROR_FILE_NOT_FOUND ? FILE_NOT_FOUND : BAD_XML);
+std::string Library::cacheFilename() const
+{
+    if (!mCacheable || mCacheDirectory.empty() || mLoadedFilesKey.empty())
+        return "";
+    return getCacheFilename(mCacheDirectory, mLoadedFilesKey);
+}
+
+bool Library::loadCache(const std::string &key)
+{
+    std::ifstream fin(getCacheFilename(mCacheDirectory, key).c_str(), std::ios::in | std::ios::binary);
+    if (!fin.is_open())
+        return false;
+    const std::string data((std::istreambuf_iterator<char>(fin)), std::istreambuf_iterator<char>());
+
+    Library lib;
+    if (!lib.readCache(data, key))
+        return false;
+    lib.mCacheDirectory = mCacheDirectory;
+    lib.mLoadedFilesKey = key;
+    *this = std::move(lib);
+    return true;
+}
+
+void Library::saveCache(const std::string &key) const
+{
+    std::string data;
+    writeCache(&data, key);
+
+    // write to a temporary file first so other processes never read a partial entry
+    const std::string filename = getCacheFilename(mCacheDirectory, key);
+    std::ostringstream tempname;
+    tempname << filename << '.' << std::chrono::high_resolution_clock::now().time_since_epoch().count() << ".tmp";
+    {
+        std::ofstream fout(tempname.str().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!fout.is_open())
+            return;
+        fout.write(data.data(), data.size());
+        if (!fout.good()) {
+            fout.close();
+            std::remove(tempname.str().c_str());
+            return;
+        }
+    }
+    std::remove(filename.c_str());
+    if (std::rename(tempname.str().c_str(), filename.c_str()) != 0)
+        std::remove(tempname.str().c_str());
 }
 
 bool Library::loadxmldata(const char xmldata[], std::size_t len)
@@ -134,6 +662,12 @@ bool Library::loadxmldata(const char xmldata[], std::size_t len)
 }
 
 Library::Error Library::load(const tinyxml2::XMLDocument &doc)
+{
+    mCacheable = false;
+    return loadXml(doc);
+}
+
+Library::Error Library::loadXml(const tinyxml2::XMLDocument &doc)
 {
     const tinyxml2::XMLElement * const rootnode = doc.FirstChildElement();
 
@@ -160,7 +694,7 @@ Library::Error Library::load(const tinyxml2::XMLDocument &doc)
             int allocationId = 0;
             for (const tinyxml2::XMLElement *memorynode = node->FirstChildElement(); memorynode; memorynode = memorynode->NextSiblingElement()) {
                 if (strcmp(memorynode->Name(),"dealloc")==0) {
-                    const std::map<std::string, AllocFunc>::const_iterator it = mDealloc.find(memorynode->GetText());
+                    const StringHashMap<AllocFunc>::const_iterator it = mDealloc.find(memorynode->GetText());
                     if (it != mDealloc.end()) {
                         allocationId = it->second.groupId;
                         break;
@@ -803,6 +1337,9 @@ std::string Library::getFunctionName(const Token *ftok, bool *error) const
 
 std::string Library::getFunctionName(const Token *ftok) const
 {
+    if (const ResolvedCall *call = getResolvedCall(ftok))
+        return call->name;
+
     if (!Token::Match(ftok, "%name% (") && (ftok->strAt(-1) != "&" || ftok->previous()->astOperand2()))
         return "";
 
@@ -833,7 +1370,7 @@ bool Library::isnullargbad(const Token *ftok, int argnr) const
     if (!arg) {
         // scan format string argument should not be null
         const std::string funcname = getFunctionName(ftok);
-        const std::map<std::string, Function>::const_iterator it = functions.find(funcname);
+        const StringHashMap<Function>::const_iterator it = functions.find(funcname);
         if (it != functions.cend() && it->second.formatstr && it->second.formatstr_scan)
             return true;
     }
@@ -846,7 +1383,7 @@ bool Library::isuninitargbad(const Token *ftok, int argnr) const
     if (!arg) {
         // non-scan format string argument should not be uninitialized
         const std::string funcname = getFunctionName(ftok);
-        const std::map<std::string, Function>::const_iterator it = functions.find(funcname);
+        const StringHashMap<Function>::const_iterator it = functions.find(funcname);
         if (it != functions.cend() && it->second.formatstr && !it->second.formatstr_scan)
             return true;
     }
@@ -885,16 +1422,14 @@ int Library::dealloc(const Token *tok, int arg) const
 
 const Library::ArgumentChecks * Library::getarg(const Token *ftok, int argnr) const
 {
-    if (isNotLibraryFunction(ftok))
-        return nullptr;
-    const std::map<std::string, Function>::const_iterator it1 = functions.find(getFunctionName(ftok));
-    if (it1 == functions.cend())
+    const Function *function = getFunction(ftok);
+    if (!function)
         return nullptr;
-    const std::map<int,ArgumentChecks>::const_iterator it2 = it1->second.argumentChecks.find(argnr);
-    if (it2 != it1->second.argumentChecks.cend())
+    const std::map<int,ArgumentChecks>::const_iterator it2 = function->argumentChecks.find(argnr);
+    if (it2 != function->argumentChecks.cend())
         return &it2->second;
-    const std::map<int,ArgumentChecks>::const_iterator it3 = it1->second.argumentChecks.find(-1);
-    if (it3 != it1->second.argumentChecks.cend())
+    const std::map<int,ArgumentChecks>::const_iterator it3 = function->argumentChecks.find(-1);
+    if (it3 != function->argumentChecks.cend())
         return &it3->second;
     return nullptr;
 }
@@ -988,6 +1523,9 @@ bool Library::isContainerYield(const Token * const cond, Library::Container::Yie
 // returns true if ftok is not a library function
 bool Library::isNotLibraryFunction(const Token *ftok) const
 {
+    if (const ResolvedCall *call = getResolvedCall(ftok))
+        return call->notLibraryFunction;
+
     if (ftok->function() && ftok->function()->nestedIn && ftok->function()->nestedIn->type != Scope::eGlobal)
         return true;
 
@@ -998,10 +1536,40 @@ bool Library::isNotLibraryFunction(const Token *ftok) const
     return !matchArguments(ftok, getFunctionName(ftok));
 }
 
+Library::ResolvedCall Library::resolveCall(const Token *ftok) const
+{
+    ResolvedCall call;
+    call.name = getFunctionName(ftok);
+    call.notLibraryFunction = isNotLibraryFunction(ftok);
+    if (!call.notLibraryFunction) {
+        const StringHashMap<Function>::const_iterator it = functions.find(call.name);
+        if (it != functions.cend())
+            call.function = &it->second;
+    }
+    return call;
+}
+
+const Library::ResolvedCall *Library::getResolvedCall(const Token *ftok) const
+{
+    if (!ftok || !ftok->scope() || !ftok->scope()->check)
+        return nullptr;
+    return ftok->scope()->check->resolvedLibraryCall(ftok, this);
+}
+
+const Library::Function *Library::getFunction(const Token *ftok) const
+{
+    if (const ResolvedCall *call = getResolvedCall(ftok))
+        return call->function;
+    if (isNotLibraryFunction(ftok))
+        return nullptr;
+    const StringHashMap<Function>::const_iterator it = functions.find(getFunctionName(ftok));
+    return it != functions.cend() ? &it->second : nullptr;
+}
+
 bool Library::matchArguments(const Token *ftok, const std::string &functionName) const
 {
     const int callargs = numberOfArguments(ftok);
-    const std::map<std::string, Function>::const_iterator it = functions.find(functionName);
+    const StringHashMap<Function>::const_iterator it = functions.find(functionName);
     if (it == functions.cend())
         return (callargs == 0);
     int args = 0;
@@ -1022,7 +1590,7 @@ const Library::WarnInfo* Library::getWarnInfo(const Token* ftok) const
 {
     if (isNotLibraryFunction(ftok))
         return nullptr;
-    std::map<std::string, WarnInfo>::const_iterator i = functionwarn.find(getFunctionName(ftok));
+    StringHashMap<WarnInfo>::const_iterator i = functionwarn.find(getFunctionName(ftok));
     if (i == functionwarn.cend())
         return nullptr;
     return &i->second;
@@ -1030,13 +1598,8 @@ const Library::WarnInfo* Library::getWarnInfo(const Token* ftok) const
 
 bool Library::formatstr_function(const Token* ftok) const
 {
-    if (isNotLibraryFunction(ftok))
-        return false;
-
-    const std::map<std::string, Function>::const_iterator it = functions.find(getFunctionName(ftok));
-    if (it != functions.cend())
-        return it->second.formatstr;
-    return false;
+    const Function *function = getFunction(ftok);
+    return function && function->formatstr;
 }
 
 int Library::formatstr_argno(const Token* ftok) const
@@ -1062,19 +1625,15 @@ bool Library::formatstr_secure(const Token* ftok) const
 
 bool Library::isUseRetVal(const Token* ftok) const
 {
-    if (isNotLibraryFunction(ftok))
-        return false;
-    const std::map<std::string, Function>::const_iterator it = functions.find(getFunctionName(ftok));
-    if (it != functions.cend())
-        return it->second.useretval;
-    return false;
+    const Function *function = getFunction(ftok);
+    return function && function->useretval;
 }
 
 const std::string& Library::returnValue(const Token *ftok) const
 {
     if (isNotLibraryFunction(ftok))
         return emptyString;
-    const std::map<std::string, std::string>::const_iterator it = mReturnValue.find(getFunctionName(ftok));
+    const StringHashMap<std::string>::const_iterator it = mReturnValue.find(getFunctionName(ftok));
     return it != mReturnValue.end() ? it->second : emptyString;
 }
 
@@ -1082,7 +1641,7 @@ const std::string& Library::returnValueType(const Token *ftok) const
 {
     if (isNotLibraryFunction(ftok))
         return emptyString;
-    const std::map<std::string, std::string>::const_iterator it = mReturnValueType.find(getFunctionName(ftok));
+    const StringHashMap<std::string>::const_iterator it = mReturnValueType.find(getFunctionName(ftok));
     return it != mReturnValueType.end() ? it->second : emptyString;
 }
 
@@ -1090,13 +1649,13 @@ int Library::returnValueContainer(const Token *ftok) const
 {
     if (isNotLibraryFunction(ftok))
         return -1;
-    const std::map<std::string, int>::const_iterator it = mReturnValueContainer.find(getFunctionName(ftok));
+    const StringHashMap<int>::const_iterator it = mReturnValueContainer.find(getFunctionName(ftok));
     return it != mReturnValueContainer.end() ? it->second : -1;
 }
 
 bool Library::hasminsize(const std::string &functionName) const
 {
-    const std::map<std::string, Function>::const_iterator it1 = functions.find(functionName);
+    const StringHashMap<Function>::const_iterator it1 = functions.find(functionName);
     if (it1 == functions.cend())
         return false;
     for (std::map<int, ArgumentChecks>::const_iterator it2 = it1->second.argumentChecks.cbegin(); it2 != it1->second.argumentChecks.cend(); ++it2) {
@@ -1108,28 +1667,28 @@ bool Library::hasminsize(const std::string &functionName) const
 
 bool Library::ignorefunction(const std::string& functionName) const
 {
-    const std::map<std::string, Function>::const_iterator it = functions.find(functionName);
+    const StringHashMap<Function>::const_iterator it = functions.find(functionName);
     if (it != functions.cend())
         return it->second.ignore;
     return false;
 }
 bool Library::isUse(const std::string& functionName) const
 {
-    const std::map<std::string, Function>::const_iterator it = functions.find(functionName);
+    const StringHashMap<Function>::const_iterator it = functions.find(functionName);
     if (it != functions.cend())
         return it->second.use;
     return false;
 }
 bool Library::isLeakIgnore(const std::string& functionName) const
 {
-    const  std::map<std::string, Function>::const_iterator it = functions.find(functionName);
+    const  StringHashMap<Function>::const_iterator it = functions.find(functionName);
     if (it != functions.cend())
         return it->second.leakignore;
     return false;
 }
 bool Library::isFunctionConst(const std::string& functionName, bool pure) const
 {
-    const std::map<std::string, Function>::const_iterator it = functions.find(functionName);
+    const StringHashMap<Function>::const_iterator it = functions.find(functionName);
     if (it != functions.cend())
         return pure ? it->second.ispure : it->second.isconst;
     return false;
@@ -1138,10 +1697,8 @@ bool Library::isFunctionConst(const Token *ftok) const
 {
     if (ftok->function() && ftok->function()->isAttributeConst())
         return true;
-    if (isNotLibraryFunction(ftok))
-        return false;
-    const std::map<std::string, Function>::const_iterator it = functions.find(getFunctionName(ftok));
-    return (it != functions.end() && it->second.isconst);
+    const Function *function = getFunction(ftok);
+    return function && function->isconst;
 }
 bool Library::isnoreturn(const Token *ftok) const
 {
@@ -1149,7 +1706,7 @@ bool Library::isnoreturn(const Token *ftok) const
         return true;
     if (isNotLibraryFunction(ftok))
         return false;
-    const std::map<std::string, bool>::const_iterator it = mNoReturn.find(getFunctionName(ftok));
+    const StringHashMap<bool>::const_iterator it = mNoReturn.find(getFunctionName(ftok));
     return (it != mNoReturn.end() && it->second);
 }
 
@@ -1159,7 +1716,7 @@ bool Library::isnotnoreturn(const Token *ftok) const
         return false;
     if (isNotLibraryFunction(ftok))
         return false;
-    const std::map<std::string, bool>::const_iterator it = mNoReturn.find(getFunctionName(ftok));
+    const StringHashMap<bool>::const_iterator it = mNoReturn.find(getFunctionName(ftok));
     return (it != mNoReturn.end() && !it->second);
 }
 
@@ -25,6 +25,7 @@
 #include "errorlogger.h"
 #include "mathlib.h"
 #include "standards.h"
+#include "stringhashmap.h"
 
 #include <cstddef>
 #include <map>
@@ -67,6 +68,22 @@ public:
     Error load(const char exename [], const char path []);
     Error load(const tinyxml2::XMLDocument &doc);
 
+    /**
+     * Directory for the binary cache of loaded .cfg files, empty (default) means
+     * that there is no cache. When a .cfg file is loaded by filename the library
+     * tables are written to the cache, and the next time the same files are loaded
+     * in the same order the tables are read from the cache instead. An entry is
+     * not used anymore when a .cfg file is modified.
+     */
+    void setCacheDirectory(const std::string &dir) {
+        mCacheDirectory = dir;
+    }
+    const std::string &cacheDirectory() const {
+        return mCacheDirectory;
+    }
+    /** cache file for the currently loaded files, empty if there is no cache */
+    std::string cacheFilename() const;
+
     /** this is primarily meant for unit tests. it only returns true/false */
     bool loadxmldata(const char xmldata[], std::size_t len);
 
@@ -151,7 +168,7 @@ public:
         Standards standards;
         Severity::SeverityType severity;
     };
-    std::map<std::string, WarnInfo> functionwarn;
+    StringHashMap<WarnInfo> functionwarn;
 
     const WarnInfo* getWarnInfo(const Token* ftok) const;
 
@@ -276,7 +293,23 @@ public:
         Function() : use(false), leakignore(false), isconst(false), ispure(false), useretval(false), ignore(false), formatstr(false), formatstr_scan(false), formatstr_secure(false) {}
     };
 
-    std::map<std::string, Function> functions;
+    StringHashMap<Function> functions;
+
+    /** Library function of a function call, see resolveCall() */
+    struct ResolvedCall {
+        ResolvedCall() : notLibraryFunction(true), function(nullptr) {}
+        std::string name;
+        bool notLibraryFunction;
+        /** configuration of the function, nullptr if it is not a configured library function */
+        const Function *function;
+    };
+
+    /**
+     * Resolve function call. The symbol database resolves each call once and the
+     * Token based accessors use that result.
+     */
+    ResolvedCall resolveCall(const Token *ftok) const;
+
     bool isUse(const std::string& functionName) const;
     bool isLeakIgnore(const std::string& functionName) const;
     bool isFunctionConst(const std::string& functionName, bool pure) const;
@@ -376,7 +409,7 @@ public:
         char           sign;
     };
     const struct PodType *podtype(const std::string &name) const {
-        const std::map<std::string, struct PodType>::const_iterator it = mPodTypes.find(name);
+        const StringHashMap<PodType>::const_iterator it = mPodTypes.find(name);
         return (it != mPodTypes.end()) ? &(it->second) : nullptr;
     }
 
@@ -412,10 +445,10 @@ public:
 
     struct Platform {
         const PlatformType *platform_type(const std::string &name) const {
-            const std::map<std::string, struct PlatformType>::const_iterator it = mPlatformTypes.find(name);
+            const StringHashMap<PlatformType>::const_iterator it = mPlatformTypes.find(name);
             return (it != mPlatformTypes.end()) ? &(it->second) : nullptr;
         }
-        std::map<std::string, PlatformType> mPlatformTypes;
+        StringHashMap<PlatformType> mPlatformTypes;
     };
 
     const PlatformType *platform_type(const std::string &name, const std::string & platform) const {
@@ -426,7 +459,7 @@ public:
                 return type;
         }
 
-        const std::map<std::string, PlatformType>::const_iterator it2 = mPlatformTypes.find(name);
+        const StringHashMap<PlatformType>::const_iterator it2 = mPlatformTypes.find(name);
         return (it2 != mPlatformTypes.end()) ? &(it2->second) : nullptr;
     }
 
@@ -455,6 +488,12 @@ private:
         bool isSuffix(const std::string& suffix) const {
             return (mSuffixes.find(suffix) != mSuffixes.end());
         }
+        const std::set<std::string> &prefixes() const {
+            return mPrefixes;
+        }
+        const std::set<std::string> &suffixes() const {
+            return mSuffixes;
+        }
 
     private:
         std::set<std::string> mPrefixes;
@@ -488,6 +527,9 @@ private:
         bool isBlock(const std::string& blockName) const {
             return mBlocks.find(blockName) != mBlocks.end();
         }
+        const std::set<std::string> &blocks() const {
+            return mBlocks;
+        }
 
     private:
         std::string mStart;
@@ -497,12 +539,12 @@ private:
     };
     int mAllocId;
     std::set<std::string> mFiles;
-    std::map<std::string, AllocFunc> mAlloc; // allocation functions
-    std::map<std::string, AllocFunc> mDealloc; // deallocation functions
-    std::map<std::string, bool> mNoReturn; // is function noreturn?
-    std::map<std::string, std::string> mReturnValue;
-    std::map<std::string, std::string> mReturnValueType;
-    std::map<std::string, int> mReturnValueContainer;
+    StringHashMap<AllocFunc> mAlloc; // allocation functions
+    StringHashMap<AllocFunc> mDealloc; // deallocation functions
+    StringHashMap<bool> mNoReturn; // is function noreturn?
+    StringHashMap<std::string> mReturnValue;
+    StringHashMap<std::string> mReturnValueType;
+    StringHashMap<int> mReturnValueContainer;
     std::map<std::string, bool> mReportErrors;
     std::map<std::string, bool> mProcessAfterCode;
     std::set<std::string> mMarkupExtensions; // file extensions of markup files
@@ -511,16 +553,38 @@ private:
     std::map<std::string, ExportedFunctions> mExporters; // keywords that export variables/functions to libraries (meta-code/macros)
     std::map<std::string, std::set<std::string> > mImporters; // keywords that import variables/functions
     std::map<std::string, int> mReflection; // invocation of reflection
-    std::map<std::string, struct PodType> mPodTypes; // pod types
-    std::map<std::string, PlatformType> mPlatformTypes; // platform independent typedefs
+    StringHashMap<PodType> mPodTypes; // pod types
+    StringHashMap<PlatformType> mPlatformTypes; // platform independent typedefs
     std::map<std::string, Platform> mPlatforms; // platform dependent typedefs
 
+    std::string mCacheDirectory;
+    /** cache key: path, size and content hash of each loaded file */
+    std::string mLoadedFilesKey;
+    /** false if the tables were modified by something else than a file load */
+    bool mCacheable;
+
+    Error loadXml(const tinyxml2::XMLDocument &doc);
+
+    /** write the library tables in binary cache format */
+    void writeCache(std::string *data, const std::string &key) const;
+    /** read library tables from binary cache data, false if data is invalid or has another key */
+    bool readCache(const std::string &data, const std::string &key);
+    bool loadCache(const std::string &key);
+    void saveCache(const std::string &key) const;
+
     const ArgumentChecks * getarg(const Token *ftok, int argnr) const;
 
     std::string getFunctionName(const Token *ftok, bool *error) const;
 
-    static const AllocFunc* getAllocDealloc(const std::map<std::string, AllocFunc> &data, const std::string &name) {
-        const std::map<std::string, AllocFunc>::const_iterator it = data.find(name);
+    /** call resolved by the symbol database, nullptr if it is not cached */
+    const ResolvedCall *getResolvedCall(const Token *ftok) const;
+
+    /** configuration of library function call, nullptr if ftok is not a configured library function */
+    const Function *getFunction(const Token *ftok) const;
+
+    template<class Name>
+    static const AllocFunc* getAllocDealloc(const StringHashMap<AllocFunc> &data, const Name &name) {
+        const StringHashMap<AllocFunc>::const_iterator it = data.find(name);
         return (it == data.end()) ? nullptr : &it->second;
     }
 };
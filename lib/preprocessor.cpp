@@ -19,6 +19,7 @@
 
 #include "preprocessor.h"
 
+#include "dumpwriter.h"
 #include "errorlogger.h"
 #include "library.h"
 #include "path.h"
@@ -831,20 +832,25 @@ void Preprocessor::getErrorMessages(ErrorLogger *errorLogger, const Settings *se
 
 void Preprocessor::dump(std::ostream &out) const
 {
-    // Create a xml directive dump.
+    XmlDumpWriter writer(out, 1);
+    dump(writer);
+}
+
+void Preprocessor::dump(DumpWriter &out) const
+{
+    // Create a directive dump.
     // The idea is not that this will be readable for humans. It's a
     // data dump that 3rd party tools could load and get useful info from.
-    out << "  <directivelist>" << std::endl;
+    out.startElement("directivelist");
 
     for (const Directive &dir : mDirectives) {
-        out << "    <directive "
-            << "file=\"" << ErrorLogger::toxml(dir.file) << "\" "
-            << "linenr=\"" << dir.linenr << "\" "
-            // str might contain characters such as '"', '<' or '>' which
-            // could result in invalid XML, so run it through toxml().
-            << "str=\"" << ErrorLogger::toxml(dir.str) << "\"/>" << std::endl;
-    }
-    out << "  </directivelist>" << std::endl;
+        out.startElement("directive");
+        out.attribute("file", dir.file);
+        out.attribute("linenr", dir.linenr);
+        out.attribute("str", dir.str);
+        out.endElement();
+    }
+    out.endElement();
 }
 
 static const std::uint32_t crc32Table[] = {
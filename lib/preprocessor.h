@@ -31,6 +31,7 @@
 #include <string>
 #include <vector>
 
+class DumpWriter;
 class ErrorLogger;
 class Settings;
 
@@ -199,6 +200,7 @@ public:
      * dump all directives present in source file
      */
     void dump(std::ostream &out) const;
+    void dump(DumpWriter &out) const;
 
     void reportOutput(const simplecpp::OutputList &outputList, bool showerror);
 
@@ -0,0 +1,564 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rulematcher.h"
+
+#include <cctype>
+#include <cstring>
+#include <queue>
+
+MultiStringMatcher::MultiStringMatcher(const std::vector<std::string> &strings)
+    : mClasses(1), mStringCount(strings.size())
+{
+    // Characters that occur in the strings get their own class. All other
+    // characters only lead back to the start state.
+    std::memset(mClassOf, 0, sizeof(mClassOf));
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        for (std::size_t j = 0; j < strings[i].size(); ++j) {
+            unsigned char &cls = mClassOf[static_cast<unsigned char>(strings[i][j])];
+            if (cls == 0 && mClasses < 256)
+                cls = static_cast<unsigned char>(mClasses++);
+        }
+    }
+
+    // Build the trie. 0 is the start state and, before the failure
+    // transitions are added, also means "no transition".
+    mNext.assign(mClasses, 0);
+    mOutput.resize(1);
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        if (strings[i].empty()) {
+            mEmpty.push_back(i);
+            continue;
+        }
+        unsigned int state = 0;
+        for (std::size_t j = 0; j < strings[i].size(); ++j) {
+            const unsigned int cls = mClassOf[static_cast<unsigned char>(strings[i][j])];
+            if (mNext[state * mClasses + cls] == 0) {
+                mNext[state * mClasses + cls] = static_cast<unsigned int>(mOutput.size());
+                mNext.resize(mNext.size() + mClasses, 0);
+                mOutput.resize(mOutput.size() + 1);
+            }
+            state = mNext[state * mClasses + cls];
+        }
+        mOutput[state].push_back(i);
+    }
+
+    // Add the failure transitions breadth first, so the table becomes a DFA
+    std::vector<unsigned int> fail(mOutput.size(), 0);
+    std::queue<unsigned int> states;
+    for (unsigned int cls = 0; cls < mClasses; ++cls) {
+        if (mNext[cls] != 0)
+            states.push(mNext[cls]);
+    }
+    while (!states.empty()) {
+        const unsigned int state = states.front();
+        states.pop();
+        for (unsigned int cls = 0; cls < mClasses; ++cls) {
+            unsigned int &next = mNext[state * mClasses + cls];
+            const unsigned int failNext = mNext[fail[state] * mClasses + cls];
+            if (next == 0) {
+                next = failNext;
+                continue;
+            }
+            fail[next] = failNext;
+            mOutput[next].insert(mOutput[next].end(), mOutput[failNext].begin(), mOutput[failNext].end());
+            states.push(next);
+        }
+    }
+}
+
+std::vector<bool> MultiStringMatcher::find(const std::string &text) const
+{
+    std::vector<bool> found(mStringCount, false);
+    for (std::size_t i = 0; i < mEmpty.size(); ++i)
+        found[mEmpty[i]] = true;
+    std::size_t remaining = mStringCount - mEmpty.size();
+    unsigned int state = 0;
+    for (std::size_t pos = 0; pos < text.size() && remaining > 0; ++pos) {
+        state = mNext[state * mClasses + mClassOf[static_cast<unsigned char>(text[pos])]];
+        const std::vector<std::size_t> &output = mOutput[state];
+        for (std::size_t i = 0; i < output.size(); ++i) {
+            if (!found[output[i]]) {
+                found[output[i]] = true;
+                --remaining;
+            }
+        }
+    }
+    return found;
+}
+
+/** Skip a character class, pos is at the '[' and is moved past the ']' */
+static bool skipCharacterClass(const std::string &pattern, std::string::size_type &pos)
+{
+    ++pos;
+    if (pos < pattern.size() && pattern[pos] == '^')
+        ++pos;
+    // a ']' first in the class is a literal
+    if (pos < pattern.size() && pattern[pos] == ']')
+        ++pos;
+    while (pos < pattern.size() && pattern[pos] != ']') {
+        if (pattern[pos] == '\\')
+            ++pos;
+        else if (pattern[pos] == '[' && pos + 1 < pattern.size() && pattern[pos + 1] == ':') {
+            // [:alpha:]
+            const std::string::size_type end = pattern.find(":]", pos + 2);
+            if (end == std::string::npos)
+                return false;
+            pos = end + 1;
+        }
+        ++pos;
+    }
+    if (pos >= pattern.size())
+        return false;
+    ++pos;
+    return true;
+}
+
+/** Skip a group, pos is at the '(' and is moved past the ')' */
+static bool skipGroup(const std::string &pattern, std::string::size_type &pos)
+{
+    int depth = 0;
+    while (pos < pattern.size()) {
+        const char c = pattern[pos];
+        if (c == '\\')
+            pos += 2;
+        else if (c == '[') {
+            if (!skipCharacterClass(pattern, pos))
+                return false;
+        } else {
+            ++pos;
+            if (c == '(')
+                ++depth;
+            else if (c == ')' && --depth == 0)
+                return true;
+        }
+    }
+    return false;
+}
+
+/** Parse a {n}, {n,} or {n,m} quantifier at pos, returns false if it is not a quantifier */
+static bool parseRepeat(const std::string &pattern, std::string::size_type &pos, bool *optional)
+{
+    std::string::size_type end = pos + 1;
+    while (end < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[end])))
+        ++end;
+    if (end == pos + 1)
+        return false;
+    const bool zero = pattern.find_first_not_of('0', pos + 1) >= end;
+    if (end < pattern.size() && pattern[end] == ',') {
+        ++end;
+        while (end < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[end])))
+            ++end;
+    }
+    if (end >= pattern.size() || pattern[end] != '}')
+        return false;
+    pos = end + 1;
+    *optional = zero;
+    return true;
+}
+
+std::string RuleMatcher::requiredLiteral(const std::string &pattern)
+{
+    // Options, lookarounds and conditions can change what a literal means
+    if (pattern.find("(?") != std::string::npos)
+        return std::string();
+
+    std::string best;
+    std::string current;
+    // can a quantifier remove the last character of current?
+    bool lastIsLiteral = false;
+
+    std::string::size_type pos = 0;
+    while (pos < pattern.size()) {
+        const char c = pattern[pos];
+        if (c == '\\') {
+            if (pos + 1 >= pattern.size())
+                return std::string();
+            const char e = pattern[pos + 1];
+            if (std::isalnum(static_cast<unsigned char>(e))) {
+                // \w, \b, \1, \x41, \Q...\E and so on
+                if (std::strchr("dDsSwWbBAzZhHvVR", e) == nullptr)
+                    return std::string();
+                if (current.size() > best.size())
+                    best = current;
+                current.clear();
+                lastIsLiteral = false;
+            } else {
+                current += e;
+                lastIsLiteral = true;
+            }
+            pos += 2;
+            continue;
+        }
+
+        bool optional = false;
+        switch (c) {
+        case '|':
+        case ')':
+            // Alternatives have no common required literal
+            return std::string();
+        case '[':
+            if (!skipCharacterClass(pattern, pos))
+                return std::string();
+            break;
+        case '(':
+            if (!skipGroup(pattern, pos))
+                return std::string();
+            break;
+        case '.':
+        case '^':
+        case '$':
+            ++pos;
+            break;
+        case '*':
+        case '?':
+        case '+':
+            optional = (c != '+');
+            ++pos;
+            // lazy or possessive quantifier
+            if (pos < pattern.size() && (pattern[pos] == '?' || pattern[pos] == '+'))
+                ++pos;
+            break;
+        case '{':
+            if (parseRepeat(pattern, pos, &optional)) {
+                if (pos < pattern.size() && (pattern[pos] == '?' || pattern[pos] == '+'))
+                    ++pos;
+                break;
+            }
+            current += c;
+            lastIsLiteral = true;
+            ++pos;
+            continue;
+        default:
+            current += c;
+            lastIsLiteral = true;
+            ++pos;
+            continue;
+        }
+
+        // The literal ends here. An optional quantifier also removes its last character.
+        if (optional && lastIsLiteral)
+            current.erase(current.size() - 1);
+        if (current.size() > best.size())
+            best = current;
+        current.clear();
+        lastIsLiteral = false;
+    }
+    if (current.size() > best.size())
+        best = current;
+    return best;
+}
+
+#ifdef HAVE_RULES
+
+#define PCRE_STATIC
+#include <pcre.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+static const char * pcreErrorCodeToString(const int pcreExecRet)
+{
+    switch (pcreExecRet) {
+    case PCRE_ERROR_NULL:
+        return "Either code or subject was passed as NULL, or ovector was NULL "
+               "and ovecsize was not zero (PCRE_ERROR_NULL)";
+    case PCRE_ERROR_BADOPTION:
+        return "An unrecognized bit was set in the options argument (PCRE_ERROR_BADOPTION)";
+    case PCRE_ERROR_BADMAGIC:
+        return "PCRE stores a 4-byte \"magic number\" at the start of the compiled code, "
+               "to catch the case when it is passed a junk pointer and to detect when a "
+               "pattern that was compiled in an environment of one endianness is run in "
+               "an environment with the other endianness. This is the error that PCRE "
+               "gives when the magic number is not present (PCRE_ERROR_BADMAGIC)";
+    case PCRE_ERROR_UNKNOWN_NODE:
+        return "While running the pattern match, an unknown item was encountered in the "
+               "compiled pattern. This error could be caused by a bug in PCRE or by "
+               "overwriting of the compiled pattern (PCRE_ERROR_UNKNOWN_NODE)";
+    case PCRE_ERROR_NOMEMORY:
+        return "If a pattern contains back references, but the ovector that is passed "
+               "to pcre_exec() is not big enough to remember the referenced substrings, "
+               "PCRE gets a block of memory at the start of matching to use for this purpose. "
+               "If the call via pcre_malloc() fails, this error is given. The memory is "
+               "automatically freed at the end of matching. This error is also given if "
+               "pcre_stack_malloc() fails in pcre_exec(). "
+               "This can happen only when PCRE has been compiled with "
+               "--disable-stack-for-recursion (PCRE_ERROR_NOMEMORY)";
+    case PCRE_ERROR_NOSUBSTRING:
+        return "This error is used by the pcre_copy_substring(), pcre_get_substring(), "
+               "and pcre_get_substring_list() functions (see below). "
+               "It is never returned by pcre_exec() (PCRE_ERROR_NOSUBSTRING)";
+    case PCRE_ERROR_MATCHLIMIT:
+        return "The backtracking limit, as specified by the match_limit field in a pcre_extra "
+               "structure (or defaulted) was reached. "
+               "See the description above (PCRE_ERROR_MATCHLIMIT)";
+    case PCRE_ERROR_CALLOUT:
+        return "This error is never generated by pcre_exec() itself. "
+               "It is provided for use by callout functions that want to yield a distinctive "
+               "error code. See the pcrecallout documentation for details (PCRE_ERROR_CALLOUT)";
+    case PCRE_ERROR_BADUTF8:
+        return "A string that contains an invalid UTF-8 byte sequence was passed as a subject, "
+               "and the PCRE_NO_UTF8_CHECK option was not set. If the size of the output vector "
+               "(ovecsize) is at least 2, the byte offset to the start of the the invalid UTF-8 "
+               "character is placed in the first element, and a reason code is placed in the "
+               "second element. The reason codes are listed in the following section. For "
+               "backward compatibility, if PCRE_PARTIAL_HARD is set and the problem is a truncated "
+               "UTF-8 character at the end of the subject (reason codes 1 to 5), "
+               "PCRE_ERROR_SHORTUTF8 is returned instead of PCRE_ERROR_BADUTF8";
+    case PCRE_ERROR_BADUTF8_OFFSET:
+        return "The UTF-8 byte sequence that was passed as a subject was checked and found to "
+               "be valid (the PCRE_NO_UTF8_CHECK option was not set), but the value of "
+               "startoffset did not point to the beginning of a UTF-8 character or the end of "
+               "the subject (PCRE_ERROR_BADUTF8_OFFSET)";
+    case PCRE_ERROR_PARTIAL:
+        return "The subject string did not match, but it did match partially. See the "
+               "pcrepartial documentation for details of partial matching (PCRE_ERROR_PARTIAL)";
+    case PCRE_ERROR_BADPARTIAL:
+        return "This code is no longer in use. It was formerly returned when the PCRE_PARTIAL "
+               "option was used with a compiled pattern containing items that were not supported "
+               "for partial matching. From release 8.00 onwards, there are no restrictions on "
+               "partial matching (PCRE_ERROR_BADPARTIAL)";
+    case PCRE_ERROR_INTERNAL:
+        return "An unexpected internal error has occurred. This error could be caused by a bug "
+               "in PCRE or by overwriting of the compiled pattern (PCRE_ERROR_INTERNAL)";
+    case PCRE_ERROR_BADCOUNT:
+        return"This error is given if the value of the ovecsize argument is negative "
+              "(PCRE_ERROR_BADCOUNT)";
+    case PCRE_ERROR_RECURSIONLIMIT :
+        return "The internal recursion limit, as specified by the match_limit_recursion "
+               "field in a pcre_extra structure (or defaulted) was reached. "
+               "See the description above (PCRE_ERROR_RECURSIONLIMIT)";
+    case PCRE_ERROR_DFA_UITEM:
+        return "PCRE_ERROR_DFA_UITEM";
+    case PCRE_ERROR_DFA_UCOND:
+        return "PCRE_ERROR_DFA_UCOND";
+    case PCRE_ERROR_DFA_WSSIZE:
+        return "PCRE_ERROR_DFA_WSSIZE";
+    case PCRE_ERROR_DFA_RECURSE:
+        return "PCRE_ERROR_DFA_RECURSE";
+    case PCRE_ERROR_NULLWSLIMIT:
+        return "PCRE_ERROR_NULLWSLIMIT";
+    case PCRE_ERROR_BADNEWLINE:
+        return "An invalid combination of PCRE_NEWLINE_xxx options was "
+               "given (PCRE_ERROR_BADNEWLINE)";
+    case PCRE_ERROR_BADOFFSET:
+        return "The value of startoffset was negative or greater than the length "
+               "of the subject, that is, the value in length (PCRE_ERROR_BADOFFSET)";
+    case PCRE_ERROR_SHORTUTF8:
+        return "This error is returned instead of PCRE_ERROR_BADUTF8 when the subject "
+               "string ends with a truncated UTF-8 character and the PCRE_PARTIAL_HARD option is set. "
+               "Information about the failure is returned as for PCRE_ERROR_BADUTF8. "
+               "It is in fact sufficient to detect this case, but this special error code for "
+               "PCRE_PARTIAL_HARD precedes the implementation of returned information; "
+               "it is retained for backwards compatibility (PCRE_ERROR_SHORTUTF8)";
+    case PCRE_ERROR_RECURSELOOP:
+        return "This error is returned when pcre_exec() detects a recursion loop "
+               "within the pattern. Specifically, it means that either the whole pattern "
+               "or a subpattern has been called recursively for the second time at the same "
+               "position in the subject string. Some simple patterns that might do this "
+               "are detected and faulted at compile time, but more complicated cases, "
+               "in particular mutual recursions between two different subpatterns, "
+               "cannot be detected until run time (PCRE_ERROR_RECURSELOOP)";
+    case PCRE_ERROR_JIT_STACKLIMIT:
+        return "This error is returned when a pattern that was successfully studied "
+               "using a JIT compile option is being matched, but the memory available "
+               "for the just-in-time processing stack is not large enough. See the pcrejit "
+               "documentation for more details (PCRE_ERROR_JIT_STACKLIMIT)";
+    case PCRE_ERROR_BADMODE:
+        return "This error is given if a pattern that was compiled by the 8-bit library "
+               "is passed to a 16-bit or 32-bit library function, or vice versa (PCRE_ERROR_BADMODE)";
+    case PCRE_ERROR_BADENDIANNESS:
+        return "This error is given if a pattern that was compiled and saved is reloaded on a "
+               "host with different endianness. The utility function pcre_pattern_to_host_byte_order() "
+               "can be used to convert such a pattern so that it runs on the new host (PCRE_ERROR_BADENDIANNESS)";
+    case PCRE_ERROR_DFA_BADRESTART:
+        return "PCRE_ERROR_DFA_BADRESTART";
+#if PCRE_MAJOR >= 8 && PCRE_MINOR >= 32
+    case PCRE_ERROR_BADLENGTH:
+        return "This error is given if pcre_exec() is called with a negative value for the length argument (PCRE_ERROR_BADLENGTH)";
+    case PCRE_ERROR_JIT_BADOPTION:
+        return "This error is returned when a pattern that was successfully studied using a JIT compile "
+               "option is being matched, but the matching mode (partial or complete match) does not correspond "
+               "to any JIT compilation mode. When the JIT fast path function is used, this error may be "
+               "also given for invalid options. See the pcrejit documentation for more details (PCRE_ERROR_JIT_BADOPTION)";
+#endif
+    }
+    return "";
+}
+
+/** A compiled rule pattern */
+class RuleMatcher::Pattern {
+public:
+    explicit Pattern(const Settings::Rule &r) : rule(r), re(nullptr), extra(nullptr), literal(0) {}
+    ~Pattern() {
+        if (re)
+            pcre_free(re);
+#ifdef PCRE_CONFIG_JIT
+        // Free up the EXTRA PCRE value (may be NULL at this point)
+        if (extra)
+            pcre_free_study(extra);
+#endif
+    }
+
+    Settings::Rule rule;
+    pcre *re;
+    pcre_extra *extra;
+    /** compile or study error, reported every time the rule is executed */
+    std::string error;
+    std::string errorId;
+    /** index of the required literal in mLiterals */
+    std::size_t literal;
+};
+
+RuleMatcher::RuleMatcher(const std::list<Settings::Rule> &rules) : mRules(rules), mLiterals(nullptr)
+{
+    std::vector<std::string> literals;
+    for (std::list<Settings::Rule>::const_iterator it = rules.begin(); it != rules.end(); ++it) {
+        const Settings::Rule &rule = *it;
+        if (rule.pattern.empty() || rule.id.empty() || rule.severity == Severity::none)
+            continue;
+
+        Pattern * const pattern = new Pattern(rule);
+        mPatterns.push_back(pattern);
+        // Patterns that failed to compile get an empty literal, so their error is reported
+        pattern->literal = literals.size();
+        literals.push_back(std::string());
+
+        const char *pcreCompileErrorStr = nullptr;
+        int erroffset = 0;
+        pattern->re = pcre_compile(rule.pattern.c_str(),0,&pcreCompileErrorStr,&erroffset,nullptr);
+        if (!pattern->re) {
+            if (pcreCompileErrorStr) {
+                pattern->error = "pcre_compile failed: " + std::string(pcreCompileErrorStr);
+                pattern->errorId = "pcre_compile";
+            }
+            continue;
+        }
+
+        // Optimize the regex, but only if PCRE_CONFIG_JIT is available
+#ifdef PCRE_CONFIG_JIT
+        const char *pcreStudyErrorStr = nullptr;
+        pattern->extra = pcre_study(pattern->re, PCRE_STUDY_JIT_COMPILE, &pcreStudyErrorStr);
+        // pcre_study() returns NULL for both errors and when it can not optimize the regex.
+        // The last argument is how one checks for errors.
+        // It is NULL if everything works, and points to an error string otherwise.
+        if (pcreStudyErrorStr) {
+            pattern->error = "pcre_study failed: " + std::string(pcreStudyErrorStr);
+            pattern->errorId = "pcre_study";
+            // pcre_compile() worked, but pcre_study() returned an error. Free the resources allocated by pcre_compile().
+            pcre_free(pattern->re);
+            pattern->re = nullptr;
+            continue;
+        }
+#endif
+        literals.back() = requiredLiteral(rule.pattern);
+    }
+    mLiterals = new MultiStringMatcher(literals);
+}
+
+RuleMatcher::~RuleMatcher()
+{
+    for (std::vector<Pattern *>::const_iterator it = mPatterns.begin(); it != mPatterns.end(); ++it)
+        delete *it;
+    delete mLiterals;
+}
+
+bool RuleMatcher::hasRules(const std::string &tokenlist) const
+{
+    for (std::vector<Pattern *>::const_iterator it = mPatterns.begin(); it != mPatterns.end(); ++it) {
+        if ((*it)->rule.tokenlist == tokenlist)
+            return true;
+    }
+    return false;
+}
+
+void RuleMatcher::execute(const Pattern &pattern, const std::string &subject, std::vector<Result> *results) const
+{
+    Result result;
+    result.rule = &pattern.rule;
+
+    if (!pattern.re) {
+        if (!pattern.errorId.empty()) {
+            result.error = pattern.error;
+            result.errorId = pattern.errorId;
+            results->push_back(result);
+        }
+        return;
+    }
+
+    int pos = 0;
+    int ovector[30]= {0};
+    while (pos < (int)subject.size()) {
+        const int pcreExecRet = pcre_exec(pattern.re, pattern.extra, subject.c_str(), (int)subject.size(), pos, 0, ovector, 30);
+        if (pcreExecRet < 0) {
+            const std::string errorMessage = pcreErrorCodeToString(pcreExecRet);
+            if (!errorMessage.empty()) {
+                result.error = "pcre_exec failed: " + errorMessage;
+                result.errorId = "pcre_exec";
+                results->push_back(result);
+            }
+            break;
+        }
+        result.begin = (std::size_t)ovector[0];
+        result.end = (std::size_t)ovector[1];
+        results->push_back(result);
+
+        // jump to the end of the match for the next pcre_exec
+        pos = ovector[1];
+    }
+}
+
+std::vector<RuleMatcher::Result> RuleMatcher::match(const std::string &tokenlist, const std::string &subject, unsigned int threads) const
+{
+    // One scan of the subject for the literals of all patterns
+    const std::vector<bool> literals = mLiterals->find(subject);
+
+    std::vector<const Pattern *> patterns;
+    for (std::vector<Pattern *>::const_iterator it = mPatterns.begin(); it != mPatterns.end(); ++it) {
+        if ((*it)->rule.tokenlist == tokenlist && literals[(*it)->literal])
+            patterns.push_back(*it);
+    }
+
+    std::vector<std::vector<Result> > resultsPerPattern(patterns.size());
+    threads = std::min<std::size_t>(threads, patterns.size());
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < patterns.size(); ++i)
+            execute(*patterns[i], subject, &resultsPerPattern[i]);
+    } else {
+        std::atomic<std::size_t> next(0);
+        const auto worker = [&]() {
+            for (std::size_t i = next++; i < patterns.size(); i = next++)
+                execute(*patterns[i], subject, &resultsPerPattern[i]);
+        };
+        // the calling thread is one of the workers
+        std::vector<std::thread> workers;
+        for (unsigned int t = 1; t < threads; ++t)
+            workers.emplace_back(worker);
+        worker();
+        for (std::size_t t = 0; t < workers.size(); ++t)
+            workers[t].join();
+    }
+
+    std::vector<Result> results;
+    for (std::size_t i = 0; i < resultsPerPattern.size(); ++i)
+        results.insert(results.end(), resultsPerPattern[i].begin(), resultsPerPattern[i].end());
+    return results;
+}
+
+#endif // HAVE_RULES
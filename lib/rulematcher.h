@@ -0,0 +1,137 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef rulematcherH
+#define rulematcherH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+#include "settings.h"
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Finds which of a set of strings occur in a text, with one scan of the text.
+ *
+ * This is an Aho-Corasick automaton. The scan time depends on the length
+ * of the text but not on the number of strings.
+ */
+class CPPCHECKLIB MultiStringMatcher {
+public:
+    explicit MultiStringMatcher(const std::vector<std::string> &strings);
+
+    /** Which strings occur in the text, indexed like the strings given to the constructor */
+    std::vector<bool> find(const std::string &text) const;
+
+private:
+    /** number of character classes, characters that are not in any string share class 0 */
+    unsigned int mClasses;
+    unsigned char mClassOf[256];
+    /** transition table, mClasses entries per state */
+    std::vector<unsigned int> mNext;
+    /** strings that end in each state */
+    std::vector<std::vector<std::size_t> > mOutput;
+    std::size_t mStringCount;
+    /** empty strings, they occur in all texts */
+    std::vector<std::size_t> mEmpty;
+};
+
+/**
+ * @brief The compiled patterns of the --rule and --rule-file rules.
+ *
+ * All patterns are compiled and studied (JIT) once, when the matcher is
+ * created by Settings::compileRules(). The matcher is immutable after
+ * that, so it is shared by all copies of the Settings and its patterns
+ * can be executed from several threads at the same time.
+ *
+ * Each pattern is checked for a literal string that every match must
+ * contain. The subject is scanned once for the literals of all
+ * patterns, and a pattern is only executed if its literal occurs.
+ */
+class CPPCHECKLIB RuleMatcher {
+public:
+    /**
+     * Longest literal string that occurs in every match of a regular
+     * expression. This is conservative: an empty string is returned if
+     * the expression is not understood.
+     */
+    static std::string requiredLiteral(const std::string &pattern);
+
+#ifdef HAVE_RULES
+    /** A match of a rule, or an error of a rule */
+    struct Result {
+        Result() : rule(nullptr), begin(0), end(0) {}
+
+        const Settings::Rule *rule;
+        /** position of the match in the subject */
+        std::size_t begin;
+        std::size_t end;
+        /** pcre error message and error id, empty for matches */
+        std::string error;
+        std::string errorId;
+    };
+
+    explicit RuleMatcher(const std::list<Settings::Rule> &rules);
+    ~RuleMatcher();
+
+    RuleMatcher(const RuleMatcher &) = delete;
+    RuleMatcher &operator=(const RuleMatcher &) = delete;
+
+    /** Was the matcher created from these rules? Otherwise it must be created again. */
+    bool compiledFrom(const std::list<Settings::Rule> &rules) const {
+        return mRules == rules;
+    }
+
+    /** Are there rules for the given token list ("raw", "normal" or "simple")? */
+    bool hasRules(const std::string &tokenlist) const;
+
+    /**
+     * Execute the rules of a token list on the subject string. Rules
+     * whose required literal does not occur in the subject are skipped.
+     * The results are ordered by rule and then by position, also when the
+     * rules are executed in parallel.
+     * @param tokenlist "raw", "normal" or "simple"
+     * @param subject the tokens separated by spaces
+     * @param threads maximum number of threads, including the calling thread
+     */
+    std::vector<Result> match(const std::string &tokenlist, const std::string &subject, unsigned int threads) const;
+
+private:
+    class Pattern;
+
+    void execute(const Pattern &pattern, const std::string &subject, std::vector<Result> *results) const;
+
+    std::vector<Pattern *> mPatterns;
+    /** the rules the matcher was created from */
+    std::list<Settings::Rule> mRules;
+    /** required literals of the patterns */
+    MultiStringMatcher *mLiterals;
+#endif // HAVE_RULES
+};
+
+/// @}
+
+//---------------------------------------------------------------------------
+#endif // rulematcherH
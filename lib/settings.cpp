@@ -18,6 +18,7 @@
 
 #include "settings.h"
 
+#include "rulematcher.h"
 #include "valueflow.h"
 
 bool Settings::mTerminated;
@@ -28,10 +29,13 @@ Settings::Settings()
       debugnormal(false),
       debugwarnings(false),
       dump(false),
+      dumpFormat(DUMP_XML),
+      addonPython("python"),
       exceptionHandling(false),
       inconclusive(false),
       jointSuppressionReport(false),
       experimental(false),
+      memleakEngine(MEMLEAK_SIMPLIFY),
       quiet(false),
       inlineSuppressions(false),
       verbose(false),
@@ -39,11 +43,17 @@ Settings::Settings()
       relativePaths(false),
       xml(false), xml_version(2),
       jobs(1),
+      ruleJobs(1),
       loadAverage(0),
       exitCode(0),
       showtime(SHOWTIME_NONE),
       preprocessOnly(false),
       maxConfigs(12),
+      maxTimePerFile(0),
+      maxMemoryPerFile(0),
+      maxMemory(0),
+      maxValueFlowTokens(100000),
+      maxValueFlowDepth(64),
       enforcedLang(None),
       reportProgress(false),
       checkConfiguration(false),
@@ -135,3 +145,10 @@ bool Settings::isEnabled(const ValueFlow::Value *value, bool inconclusiveCheck)
         return false;
     return true;
 }
+
+#ifdef HAVE_RULES
+void Settings::compileRules()
+{
+    ruleMatcher = std::make_shared<RuleMatcher>(rules);
+}
+#endif
@@ -30,7 +30,10 @@
 #include "suppressions.h"
 #include "timer.h"
 
+#include <cstddef>
 #include <list>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -39,6 +42,8 @@
 namespace ValueFlow {
     class Value;
 }
+class CheckConfig;
+class RuleMatcher;
 
 /// @addtogroup Core
 /// @{
@@ -87,6 +92,21 @@ public:
     bool dump;
     std::string dumpFile;
 
+    /** @brief Format of the dump files (--dump-format=xml|binary) */
+    enum DumpFormat {
+        DUMP_XML,   ///< xml document
+        DUMP_BINARY ///< length-prefixed records, see BinaryDumpWriter
+    } dumpFormat;
+
+    /**
+     * @brief Addon scripts (--addon). They are executed for each file,
+     * the dump is passed to them through a pipe unless --dump is given.
+     */
+    std::list<std::string> addons;
+
+    /** @brief Python interpreter for the addons (--addon-python) */
+    std::string addonPython;
+
     /** @brief Is --exception-handling given */
     bool exceptionHandling;
 
@@ -106,6 +126,13 @@ public:
      */
     bool experimental;
 
+    /** @brief Engine that finds leaks in CheckMemoryLeakInFunction (--memleak-engine=simplify|cfg|compare) */
+    enum MemleakEngine {
+        MEMLEAK_SIMPLIFY, ///< rewrite the code with simplifycode() until nothing changes
+        MEMLEAK_CFG,      ///< propagate the allocation state through a control flow graph
+        MEMLEAK_COMPARE   ///< report simplifycode() results, debug message when the engines disagree
+    } memleakEngine;
+
     /** @brief Is --quiet given? */
     bool quiet;
 
@@ -150,6 +177,10 @@ public:
         time. Default is 1. (-j N) */
     unsigned int jobs;
 
+    /** @brief How many threads execute the rules of one file at the
+        same time. At most jobs, default is 1. */
+    unsigned int ruleJobs;
+
     /** @brief Load average value */
     unsigned int loadAverage;
 
@@ -179,9 +210,38 @@ public:
         Default is 12. (--max-configs=N) */
     unsigned int maxConfigs;
 
+    /** @brief Time budget in seconds for checking one file, 0 if there
+        is no budget. When it is exceeded, the file is checked in cheaper
+        modes. (--max-time-per-file=N) */
+    unsigned int maxTimePerFile;
+
+    /** @brief Memory budget in bytes for checking one file, 0 if there
+        is no budget. When it is exceeded, the file is checked in cheaper
+        modes. (--max-memory-per-file=MB) */
+    std::size_t maxMemoryPerFile;
+
+    /** @brief Memory budget in bytes for the files that are checked at
+        the same time, 0 if there is no budget. (--max-memory=MB) */
+    std::size_t maxMemory;
+
+    /** @brief Maximum number of tokens the ValueFlow forward or reverse
+        analysis of one variable may visit, 0 if there is no limit.
+        Default is 100000. (--max-valueflow-tokens=N) */
+    unsigned int maxValueFlowTokens;
+
+    /** @brief Maximum depth of nested branches the ValueFlow forward
+        analysis of one variable follows, 0 if there is no limit.
+        Default is 64. (--max-valueflow-depth=N) */
+    unsigned int maxValueFlowDepth;
+
     /** @brief the configure used in the user define CHECK_CLASS.
         (--conf=check.yaml)*/
     YAML::Node userRuleConfigure;
+
+    /** @brief The configurations of the checks, parsed once from
+        userRuleConfigure by Check::loadConfigs(). Indexed by check name. */
+    std::map<std::string, std::shared_ptr<const CheckConfig> > checkConfigs;
+
     /**
      * @brief Returns true if given id is in the list of
      * enabled extra checks (--enable)
@@ -260,6 +320,11 @@ public:
             , severity(Severity::style) { // default severity
         }
 
+        bool operator==(const Rule &other) const {
+            return tokenlist == other.tokenlist && pattern == other.pattern && id == other.id &&
+                   summary == other.summary && severity == other.severity;
+        }
+
         std::string tokenlist;
         std::string pattern;
         std::string id;
@@ -272,6 +337,14 @@ public:
      */
     std::list<Rule> rules;
 
+#ifdef HAVE_RULES
+    /** The compiled rules, shared by all copies of the settings */
+    std::shared_ptr<const RuleMatcher> ruleMatcher;
+
+    /** Compile the patterns of the rules, this is done once after the rules are loaded */
+    void compileRules();
+#endif
+
     /** Is the 'configuration checking' wanted? */
     bool checkConfiguration;
 
@@ -0,0 +1,251 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef smallvectorH
+#define smallvectorH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Sequence container with room for N elements inside the container.
+ *
+ * Up to N elements are stored in the container itself, so a container
+ * that is allocated on the heap holds them in the same allocation. When
+ * there are more, all elements are moved to a separate buffer that grows
+ * like a std::vector. The buffer pointer shares its memory with the inline
+ * elements. Iterators, pointers and references are invalidated when
+ * elements are added or removed.
+ */
+template<class T, std::size_t N>
+class SmallVector {
+public:
+    typedef T value_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef std::size_t size_type;
+    typedef T *iterator;
+    typedef const T *const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    SmallVector() : mSize(0), mCapacity(N) {}
+
+    SmallVector(std::size_t n, const T &t) : mSize(0), mCapacity(N) {
+        reserve(n);
+        while (mSize < n)
+            push_back(t);
+    }
+
+    template<class InputIterator>
+    SmallVector(InputIterator first, InputIterator last) : mSize(0), mCapacity(N) {
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    SmallVector(const SmallVector &other) : mSize(0), mCapacity(N) {
+        reserve(other.mSize);
+        for (const T &t : other)
+            push_back(t);
+    }
+
+    ~SmallVector() {
+        clear();
+        if (!isInline())
+            ::operator delete(mHeap);
+    }
+
+    SmallVector &operator=(const SmallVector &other) {
+        if (this != &other) {
+            clear();
+            reserve(other.mSize);
+            for (const T &t : other)
+                push_back(t);
+        }
+        return *this;
+    }
+
+    bool operator==(const SmallVector &other) const {
+        return mSize == other.mSize && std::equal(begin(), end(), other.begin());
+    }
+    bool operator!=(const SmallVector &other) const {
+        return !(*this == other);
+    }
+
+    std::size_t size() const {
+        return mSize;
+    }
+    bool empty() const {
+        return mSize == 0;
+    }
+    std::size_t capacity() const {
+        return mCapacity;
+    }
+    /** Are the elements stored inside the container? */
+    bool isInline() const {
+        return mCapacity == N;
+    }
+
+    iterator begin() {
+        return data();
+    }
+    iterator end() {
+        return data() + mSize;
+    }
+    const_iterator begin() const {
+        return data();
+    }
+    const_iterator end() const {
+        return data() + mSize;
+    }
+    const_iterator cbegin() const {
+        return begin();
+    }
+    const_iterator cend() const {
+        return end();
+    }
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    T &operator[](std::size_t i) {
+        return data()[i];
+    }
+    const T &operator[](std::size_t i) const {
+        return data()[i];
+    }
+    T &front() {
+        return data()[0];
+    }
+    const T &front() const {
+        return data()[0];
+    }
+    T &back() {
+        return data()[mSize - 1];
+    }
+    const T &back() const {
+        return data()[mSize - 1];
+    }
+
+    void reserve(std::size_t n) {
+        if (n <= mCapacity)
+            return;
+        T *heap = static_cast<T *>(::operator new(n * sizeof(T)));
+        T *old = data();
+        for (std::size_t i = 0; i < mSize; ++i) {
+            new (&heap[i]) T(std::move(old[i]));
+            old[i].~T();
+        }
+        if (!isInline())
+            ::operator delete(old);
+        mHeap = heap;
+        mCapacity = static_cast<unsigned int>(n);
+    }
+
+    void push_back(const T &t) {
+        emplace_back(t);
+    }
+
+    template<class... Args>
+    void emplace_back(Args &&... args) {
+        if (mSize == mCapacity) {
+            // the argument might be an element of this container
+            T t(std::forward<Args>(args)...);
+            reserve(2 * mCapacity);
+            new (data() + mSize) T(std::move(t));
+        } else {
+            new (data() + mSize) T(std::forward<Args>(args)...);
+        }
+        ++mSize;
+    }
+
+    iterator insert(const_iterator pos, const T &t) {
+        const std::size_t index = pos - begin();
+        push_back(t);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    void pop_back() {
+        data()[--mSize].~T();
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        const std::size_t index = first - begin();
+        const std::size_t count = last - first;
+        std::move(begin() + index + count, end(), begin() + index);
+        for (std::size_t i = 0; i < count; ++i)
+            pop_back();
+        return begin() + index;
+    }
+
+    /** Remove the elements for which the predicate is true */
+    template<class Predicate>
+    void remove_if(Predicate pred) {
+        erase(std::remove_if(begin(), end(), pred), end());
+    }
+
+    void clear() {
+        while (mSize > 0)
+            pop_back();
+    }
+
+private:
+    T *data() {
+        return isInline() ? reinterpret_cast<T *>(&mInline) : mHeap;
+    }
+    const T *data() const {
+        return isInline() ? reinterpret_cast<const T *>(&mInline) : mHeap;
+    }
+
+    unsigned int mSize;
+    /** N while the elements are inline */
+    unsigned int mCapacity;
+    union {
+        typename std::aligned_storage<N * sizeof(T), alignof(T)>::type mInline;
+        T *mHeap;
+    };
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // smallvectorH
@@ -0,0 +1,248 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef stablevectorH
+#define stablevectorH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Sequence container for objects that are pointed to from elsewhere.
+ *
+ * Elements are stored in chunks that are never moved, so pointers,
+ * references and iterators to elements stay valid when elements are
+ * added, like in a std::list. Chunk k holds 2^k elements, so a container
+ * with n elements needs about log2(n) allocations and its elements are
+ * mostly next to each other in memory. An empty container allocates
+ * nothing.
+ *
+ * Elements can only be added and removed at the end.
+ */
+template<class T>
+class StableVector {
+public:
+    typedef T value_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef std::size_t size_type;
+
+    template<class V, class Owner>
+    class Iterator {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef V value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V *pointer;
+        typedef V &reference;
+
+        Iterator() : mOwner(nullptr), mChunk(0), mOffset(0) {}
+        Iterator(Owner *owner, std::size_t chunk, std::size_t offset) : mOwner(owner), mChunk(chunk), mOffset(offset) {}
+        /** iterator to const_iterator */
+        template<class V2, class Owner2>
+        Iterator(const Iterator<V2, Owner2> &other) : mOwner(other.mOwner), mChunk(other.mChunk), mOffset(other.mOffset) {}
+
+        V &operator*() const {
+            return mOwner->mChunks[mChunk][mOffset];
+        }
+        V *operator->() const {
+            return &mOwner->mChunks[mChunk][mOffset];
+        }
+
+        Iterator &operator++() {
+            if (++mOffset == (std::size_t(1) << mChunk)) {
+                ++mChunk;
+                mOffset = 0;
+            }
+            return *this;
+        }
+        Iterator operator++(int) {
+            const Iterator it(*this);
+            ++*this;
+            return it;
+        }
+        Iterator &operator--() {
+            if (mOffset == 0) {
+                --mChunk;
+                mOffset = (std::size_t(1) << mChunk) - 1;
+            } else
+                --mOffset;
+            return *this;
+        }
+        Iterator operator--(int) {
+            const Iterator it(*this);
+            --*this;
+            return it;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return mChunk == other.mChunk && mOffset == other.mOffset;
+        }
+        bool operator!=(const Iterator &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        template<class V2, class Owner2> friend class Iterator;
+
+        Owner *mOwner;
+        std::size_t mChunk;
+        std::size_t mOffset;
+    };
+
+    typedef Iterator<T, StableVector> iterator;
+    typedef Iterator<const T, const StableVector> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    StableVector() : mSize(0), mEndChunk(0), mEndOffset(0) {}
+
+    StableVector(const StableVector &other) : mSize(0), mEndChunk(0), mEndOffset(0) {
+        for (const T &t : other)
+            push_back(t);
+    }
+
+    StableVector(StableVector &&other) : mSize(0), mEndChunk(0), mEndOffset(0) {
+        swap(other);
+    }
+
+    ~StableVector() {
+        clear();
+    }
+
+    StableVector &operator=(StableVector other) {
+        swap(other);
+        return *this;
+    }
+
+    void swap(StableVector &other) {
+        mChunks.swap(other.mChunks);
+        std::swap(mSize, other.mSize);
+        std::swap(mEndChunk, other.mEndChunk);
+        std::swap(mEndOffset, other.mEndOffset);
+    }
+
+    std::size_t size() const {
+        return mSize;
+    }
+    bool empty() const {
+        return mSize == 0;
+    }
+
+    iterator begin() {
+        return iterator(this, 0, 0);
+    }
+    iterator end() {
+        return iterator(this, mEndChunk, mEndOffset);
+    }
+    const_iterator begin() const {
+        return const_iterator(this, 0, 0);
+    }
+    const_iterator end() const {
+        return const_iterator(this, mEndChunk, mEndOffset);
+    }
+    const_iterator cbegin() const {
+        return begin();
+    }
+    const_iterator cend() const {
+        return end();
+    }
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    T &front() {
+        return mChunks[0][0];
+    }
+    const T &front() const {
+        return mChunks[0][0];
+    }
+    T &back() {
+        return *--end();
+    }
+    const T &back() const {
+        return *--end();
+    }
+
+    void push_back(const T &t) {
+        emplace_back(t);
+    }
+
+    template<class... Args>
+    void emplace_back(Args &&... args) {
+        if (mEndChunk == mChunks.size()) {
+            mChunks.reserve(mChunks.size() + 1);
+            mChunks.push_back(static_cast<T *>(::operator new(sizeof(T) << mEndChunk)));
+        }
+        new (&mChunks[mEndChunk][mEndOffset]) T(std::forward<Args>(args)...);
+        ++mSize;
+        if (++mEndOffset == (std::size_t(1) << mEndChunk)) {
+            ++mEndChunk;
+            mEndOffset = 0;
+        }
+    }
+
+    void pop_back() {
+        if (mEndOffset == 0) {
+            --mEndChunk;
+            mEndOffset = (std::size_t(1) << mEndChunk) - 1;
+        } else
+            --mEndOffset;
+        mChunks[mEndChunk][mEndOffset].~T();
+        --mSize;
+    }
+
+    void clear() {
+        while (mSize > 0)
+            pop_back();
+        for (std::size_t i = 0; i < mChunks.size(); ++i)
+            ::operator delete(mChunks[i]);
+        mChunks.clear();
+    }
+
+private:
+    /** chunk k has room for 2^k elements */
+    std::vector<T *> mChunks;
+    std::size_t mSize;
+    /** position after the last element */
+    std::size_t mEndChunk;
+    std::size_t mEndOffset;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // stablevectorH
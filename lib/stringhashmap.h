@@ -0,0 +1,218 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef stringhashmapH
+#define stringhashmapH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Hash map with std::string keys for lookup tables that are filled once and queried often.
+ *
+ * The table uses open addressing with linear probing. Each slot holds the
+ * hash and the index of an entry, so most probes are decided without
+ * touching the key. Keys can be looked up as const char * or as
+ * (pointer, length) without creating a temporary std::string, and a hash
+ * computed with hash() can be reused for several lookups.
+ *
+ * Entries are kept in insertion order in a std::deque. References to
+ * entries stay valid when more entries are inserted. Entries can't be
+ * erased.
+ */
+template<class T>
+class StringHashMap {
+public:
+    typedef std::pair<const std::string, T> value_type;
+    typedef typename std::deque<value_type>::iterator iterator;
+    typedef typename std::deque<value_type>::const_iterator const_iterator;
+
+    StringHashMap() : mMask(0) {}
+
+    StringHashMap(const StringHashMap &other) : mEntries(other.mEntries), mSlots(other.mSlots), mMask(other.mMask) {}
+
+    StringHashMap(StringHashMap &&other) : mMask(0) {
+        swap(other);
+    }
+
+    StringHashMap &operator=(StringHashMap other) {
+        swap(other);
+        return *this;
+    }
+
+    void swap(StringHashMap &other) {
+        mEntries.swap(other.mEntries);
+        mSlots.swap(other.mSlots);
+        std::swap(mMask, other.mMask);
+    }
+
+    /** FNV-1a hash of a key */
+    static std::size_t hash(const char *key, std::size_t len) {
+        std::size_t h = 2166136261U;
+        for (std::size_t i = 0; i < len; ++i) {
+            h ^= static_cast<unsigned char>(key[i]);
+            h *= 16777619U;
+        }
+        return h;
+    }
+
+    std::size_t size() const {
+        return mEntries.size();
+    }
+    bool empty() const {
+        return mEntries.empty();
+    }
+    void clear() {
+        mEntries.clear();
+        mSlots.clear();
+        mMask = 0;
+    }
+
+    iterator begin() {
+        return mEntries.begin();
+    }
+    iterator end() {
+        return mEntries.end();
+    }
+    const_iterator begin() const {
+        return mEntries.begin();
+    }
+    const_iterator end() const {
+        return mEntries.end();
+    }
+    const_iterator cbegin() const {
+        return mEntries.begin();
+    }
+    const_iterator cend() const {
+        return mEntries.end();
+    }
+
+    const_iterator find(const char *key, std::size_t len, std::size_t h) const {
+        const std::size_t index = lookup(key, len, h);
+        return index == NOT_FOUND ? mEntries.end() : mEntries.begin() + index;
+    }
+    iterator find(const char *key, std::size_t len, std::size_t h) {
+        const std::size_t index = lookup(key, len, h);
+        return index == NOT_FOUND ? mEntries.end() : mEntries.begin() + index;
+    }
+    const_iterator find(const std::string &key) const {
+        return find(key.data(), key.size(), hash(key.data(), key.size()));
+    }
+    iterator find(const std::string &key) {
+        return find(key.data(), key.size(), hash(key.data(), key.size()));
+    }
+    const_iterator find(const char key[]) const {
+        const std::size_t len = std::strlen(key);
+        return find(key, len, hash(key, len));
+    }
+    iterator find(const char key[]) {
+        const std::size_t len = std::strlen(key);
+        return find(key, len, hash(key, len));
+    }
+
+    std::size_t count(const std::string &key) const {
+        return find(key) == end() ? 0 : 1;
+    }
+
+    const T &at(const std::string &key) const {
+        const const_iterator it = find(key);
+        if (it == end())
+            throw std::out_of_range("StringHashMap::at");
+        return it->second;
+    }
+    T &at(const std::string &key) {
+        const iterator it = find(key);
+        if (it == end())
+            throw std::out_of_range("StringHashMap::at");
+        return it->second;
+    }
+
+    T &operator[](const std::string &key) {
+        const std::size_t h = hash(key.data(), key.size());
+        const std::size_t index = lookup(key.data(), key.size(), h);
+        if (index != NOT_FOUND)
+            return mEntries[index].second;
+        if (2 * (mEntries.size() + 1) > mSlots.size())
+            rehash(mSlots.empty() ? 16 : 2 * mSlots.size());
+        mEntries.push_back(value_type(key, T()));
+        insertSlot(h, mEntries.size() - 1);
+        return mEntries.back().second;
+    }
+
+private:
+    static const std::size_t NOT_FOUND = ~static_cast<std::size_t>(0);
+
+    struct Slot {
+        Slot() : hash(0), index(0) {}
+        std::size_t hash;
+        /** index + 1 of the entry, 0 for an empty slot */
+        std::size_t index;
+    };
+
+    std::size_t lookup(const char *key, std::size_t len, std::size_t h) const {
+        if (mSlots.empty())
+            return NOT_FOUND;
+        for (std::size_t pos = h & mMask;; pos = (pos + 1) & mMask) {
+            const Slot &slot = mSlots[pos];
+            if (slot.index == 0)
+                return NOT_FOUND;
+            if (slot.hash == h) {
+                const std::string &k = mEntries[slot.index - 1].first;
+                if (k.size() == len && std::memcmp(k.data(), key, len) == 0)
+                    return slot.index - 1;
+            }
+        }
+    }
+
+    void insertSlot(std::size_t h, std::size_t index) {
+        std::size_t pos = h & mMask;
+        while (mSlots[pos].index != 0)
+            pos = (pos + 1) & mMask;
+        mSlots[pos].hash = h;
+        mSlots[pos].index = index + 1;
+    }
+
+    void rehash(std::size_t slots) {
+        mSlots.assign(slots, Slot());
+        mMask = slots - 1;
+        for (std::size_t i = 0; i < mEntries.size(); ++i) {
+            const std::string &k = mEntries[i].first;
+            insertSlot(hash(k.data(), k.size()), i);
+        }
+    }
+
+    std::deque<value_type> mEntries;
+    std::vector<Slot> mSlots;
+    std::size_t mMask;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // stringhashmapH
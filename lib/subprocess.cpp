@@ -0,0 +1,281 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "subprocess.h"
+
+#include <cstddef>
+
+#ifdef _WIN32
+#include <thread>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+#endif
+
+#ifdef _WIN32
+
+/** Quote the argument so that the C runtime of the program splits the command line back into the same argument */
+static std::string quoteArgument(const std::string &arg)
+{
+    if (!arg.empty() && arg.find_first_of(" \t\n\v\"") == std::string::npos)
+        return arg;
+    std::string quoted = "\"";
+    for (std::string::size_type i = 0;; ++i) {
+        std::string::size_type backslashes = 0;
+        while (i < arg.size() && arg[i] == '\\') {
+            ++i;
+            ++backslashes;
+        }
+        if (i == arg.size()) {
+            // the closing quote must not be escaped
+            quoted.append(backslashes * 2, '\\');
+            break;
+        }
+        if (arg[i] == '\"')
+            quoted.append(backslashes * 2 + 1, '\\');
+        else
+            quoted.append(backslashes, '\\');
+        quoted += arg[i];
+    }
+    quoted += '\"';
+    return quoted;
+}
+
+static void readAll(HANDLE h, std::string &str)
+{
+    char buf[4096];
+    DWORD n;
+    while (ReadFile(h, buf, sizeof(buf), &n, nullptr) && n > 0)
+        str.append(buf, n);
+}
+
+int executeProcess(const std::vector<std::string> &args, const std::string &input, std::string &out, std::string &err)
+{
+    if (args.empty())
+        return -1;
+    std::string cmdline;
+    for (const std::string &arg : args) {
+        if (!cmdline.empty())
+            cmdline += ' ';
+        cmdline += quoteArgument(arg);
+    }
+
+    SECURITY_ATTRIBUTES sa;
+    sa.nLength = sizeof(sa);
+    sa.lpSecurityDescriptor = nullptr;
+    sa.bInheritHandle = TRUE;
+    HANDLE inRead, inWrite, outRead, outWrite, errRead, errWrite;
+    if (!CreatePipe(&inRead, &inWrite, &sa, 0))
+        return -1;
+    if (!CreatePipe(&outRead, &outWrite, &sa, 0)) {
+        CloseHandle(inRead);
+        CloseHandle(inWrite);
+        return -1;
+    }
+    if (!CreatePipe(&errRead, &errWrite, &sa, 0)) {
+        CloseHandle(inRead);
+        CloseHandle(inWrite);
+        CloseHandle(outRead);
+        CloseHandle(outWrite);
+        return -1;
+    }
+    // the program must only inherit its own ends of the pipes
+    SetHandleInformation(inWrite, HANDLE_FLAG_INHERIT, 0);
+    SetHandleInformation(outRead, HANDLE_FLAG_INHERIT, 0);
+    SetHandleInformation(errRead, HANDLE_FLAG_INHERIT, 0);
+
+    STARTUPINFOA si;
+    ZeroMemory(&si, sizeof(si));
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = inRead;
+    si.hStdOutput = outWrite;
+    si.hStdError = errWrite;
+    PROCESS_INFORMATION pi;
+    ZeroMemory(&pi, sizeof(pi));
+    const BOOL started = CreateProcessA(nullptr, &cmdline[0], nullptr, nullptr, TRUE, 0, nullptr, nullptr, &si, &pi);
+    CloseHandle(inRead);
+    CloseHandle(outWrite);
+    CloseHandle(errWrite);
+    if (!started) {
+        CloseHandle(inWrite);
+        CloseHandle(outRead);
+        CloseHandle(errRead);
+        return -1;
+    }
+
+    // write stdin and read stderr in threads, the pipes would block each other otherwise
+    std::thread writer([&]() {
+        const char *data = input.data();
+        std::size_t size = input.size();
+        DWORD n;
+        while (size > 0 && WriteFile(inWrite, data, (size > 0x10000) ? 0x10000 : static_cast<DWORD>(size), &n, nullptr)) {
+            data += n;
+            size -= n;
+        }
+        CloseHandle(inWrite);
+    });
+    std::thread errReader([&]() {
+        readAll(errRead, err);
+    });
+    readAll(outRead, out);
+    writer.join();
+    errReader.join();
+    CloseHandle(outRead);
+    CloseHandle(errRead);
+
+    WaitForSingleObject(pi.hProcess, INFINITE);
+    DWORD exitCode = 0;
+    const bool ok = GetExitCodeProcess(pi.hProcess, &exitCode) != 0;
+    CloseHandle(pi.hThread);
+    CloseHandle(pi.hProcess);
+    return ok ? static_cast<int>(exitCode) : -1;
+}
+
+#else
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+static void closeAll(int fds[], int count)
+{
+    for (int i = 0; i < count; ++i) {
+        if (fds[i] >= 0)
+            close(fds[i]);
+    }
+}
+
+int executeProcess(const std::vector<std::string> &args, const std::string &input, std::string &out, std::string &err)
+{
+    if (args.empty())
+        return -1;
+
+    // parent end, child end. stdin is a socket: when the program stops
+    // reading, send() fails with EPIPE instead of raising SIGPIPE.
+    int fds[6] = { -1, -1, -1, -1, -1, -1 };
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0 || pipe(fds + 2) != 0 || pipe(fds + 4) != 0) {
+        closeAll(fds, 6);
+        return -1;
+    }
+    int &inParent = fds[0], &inChild = fds[1];
+    int &outParent = fds[2], &outChild = fds[3];
+    int &errParent = fds[4], &errChild = fds[5];
+    // other threads that start programs must not inherit the descriptors
+    for (int fd : fds)
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    fcntl(inParent, F_SETFL, fcntl(inParent, F_GETFL) | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+    const int noSigPipe = 1;
+    setsockopt(inParent, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+    std::vector<char *> argv;
+    for (const std::string &arg : args)
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, inChild, 0);
+    posix_spawn_file_actions_adddup2(&actions, outChild, 1);
+    posix_spawn_file_actions_adddup2(&actions, errChild, 2);
+    pid_t pid;
+    const int spawnError = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(inChild);
+    close(outChild);
+    close(errChild);
+    inChild = outChild = errChild = -1;
+    if (spawnError != 0) {
+        closeAll(fds, 6);
+        return -1;
+    }
+
+    std::size_t written = 0;
+    if (input.empty()) {
+        close(inParent);
+        inParent = -1;
+    }
+    while (inParent >= 0 || outParent >= 0 || errParent >= 0) {
+        struct pollfd pfds[3];
+        nfds_t nfds = 0;
+        if (inParent >= 0) {
+            pfds[nfds].fd = inParent;
+            pfds[nfds++].events = POLLOUT;
+        }
+        if (outParent >= 0) {
+            pfds[nfds].fd = outParent;
+            pfds[nfds++].events = POLLIN;
+        }
+        if (errParent >= 0) {
+            pfds[nfds].fd = errParent;
+            pfds[nfds++].events = POLLIN;
+        }
+        if (poll(pfds, nfds, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        for (nfds_t i = 0; i < nfds; ++i) {
+            if (pfds[i].revents == 0)
+                continue;
+            if (pfds[i].fd == inParent) {
+                const ssize_t n = send(inParent, input.data() + written, input.size() - written, MSG_NOSIGNAL);
+                if (n > 0)
+                    written += n;
+                // done, or the program does not read more
+                if (written == input.size() || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                    close(inParent);
+                    inParent = -1;
+                }
+            } else {
+                int &fd = (pfds[i].fd == outParent) ? outParent : errParent;
+                std::string &str = (pfds[i].fd == outParent) ? out : err;
+                char buf[4096];
+                const ssize_t n = read(fd, buf, sizeof(buf));
+                if (n > 0)
+                    str.append(buf, n);
+                else if (n == 0 || errno != EINTR) {
+                    close(fd);
+                    fd = -1;
+                }
+            }
+        }
+    }
+    closeAll(fds, 6);
+
+    int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR)
+            return -1;
+    }
+    if (WIFEXITED(status))
+        return WEXITSTATUS(status);
+    return -1;
+}
+
+#endif
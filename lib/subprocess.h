@@ -0,0 +1,48 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef subprocessH
+#define subprocessH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <string>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Execute a program and wait until it exits.
+ *
+ * The program is started with the argument vector args, args[0] is
+ * looked up in PATH. No shell is involved, so the arguments are passed
+ * as they are. The input is written to the program's stdin, which is
+ * closed afterwards. Its stdout and stderr are read into out and err.
+ * The calling process is not affected when the program stops reading its
+ * stdin early, no signal handlers are changed.
+ *
+ * @return exit code of the program, -1 if it could not be executed
+ */
+int executeProcess(const std::vector<std::string> &args, const std::string &input, std::string &out, std::string &err);
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // subprocessH
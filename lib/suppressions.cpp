@@ -18,6 +18,7 @@
 
 #include "suppressions.h"
 
+#include "dumpwriter.h"
 #include "errorlogger.h"
 #include "mathlib.h"
 #include "path.h"
@@ -306,19 +307,25 @@ bool Suppressions::isSuppressedLocal(const Suppressions::ErrorMessage &errmsg)
 
 void Suppressions::dump(std::ostream & out)
 {
-    out << "  <suppressions>" << std::endl;
+    XmlDumpWriter writer(out, 1);
+    dump(writer);
+}
+
+void Suppressions::dump(DumpWriter &out) const
+{
+    out.startElement("suppressions");
     for (const Suppression &suppression : mSuppressions) {
-        out << "    <suppression";
-        out << " errorId=\"" << ErrorLogger::toxml(suppression.errorId) << '"';
+        out.startElement("suppression");
+        out.attribute("errorId", suppression.errorId);
         if (!suppression.fileName.empty())
-            out << " fileName=\"" << ErrorLogger::toxml(suppression.fileName) << '"';
+            out.attribute("fileName", suppression.fileName);
         if (suppression.lineNumber != Suppression::NO_LINE)
-            out << " lineNumber=\"" << suppression.lineNumber << '"';
+            out.attribute("lineNumber", suppression.lineNumber);
         if (!suppression.symbolName.empty())
-            out << " symbolName=\"" << ErrorLogger::toxml(suppression.symbolName) << '\"';
-        out << " />" << std::endl;
+            out.attribute("symbolName", suppression.symbolName);
+        out.endElement();
     }
-    out << "  </suppressions>" << std::endl;
+    out.endElement();
 }
 
 #include <iostream>
@@ -27,6 +27,8 @@
 #include <set>
 #include <string>
 
+class DumpWriter;
+
 /// @addtogroup Core
 /// @{
 
@@ -149,6 +151,7 @@ public:
      * @param out stream to write XML to
     */
     void dump(std::ostream &out);
+    void dump(DumpWriter &out) const;
 
     /**
      * @brief Returns list of unmatched local (per-file) suppressions.
@@ -19,6 +19,9 @@
 //---------------------------------------------------------------------------
 #include "symboldatabase.h"
 
+#include "astutils.h"
+#include "counters.h"
+#include "dumpwriter.h"
 #include "errorlogger.h"
 #include "platform.h"
 #include "settings.h"
@@ -33,10 +36,11 @@
 #include <climits>
 #include <iomanip>
 #include <iostream>
+#include <unordered_set>
 //---------------------------------------------------------------------------
 
 SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger)
-    : mTokenizer(tokenizer), mSettings(settings), mErrorLogger(errorLogger)
+    : mTokenizer(tokenizer), mSettings(settings), mErrorLogger(errorLogger), mDefUseIndex(nullptr)
 {
     mIsCpp = isCPP();
 
@@ -254,13 +258,13 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
 
                 if (new_scope->type == Scope::eEnum) {
                     tok2 = new_scope->addEnum(tok, mTokenizer->isCPP());
-                    scope->nestedList.push_back(new_scope);
+                    addNestedRecord(scope, new_scope);
 
                     if (!tok2)
                         mTokenizer->syntaxError(tok);
                 } else {
                     // make the new scope the current scope
-                    scope->nestedList.push_back(new_scope);
+                    addNestedRecord(scope, new_scope);
                     scope = new_scope;
                 }
 
@@ -290,7 +294,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
             }
 
             // make the new scope the current scope
-            scope->nestedList.push_back(new_scope);
+            addNestedRecord(scope, new_scope);
             scope = &scopeList.back();
 
             tok = tok2;
@@ -379,7 +383,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
             }
 
             // make the new scope the current scope
-            scope->nestedList.push_back(new_scope);
+            addNestedRecord(scope, new_scope);
             scope = new_scope;
 
             tok = tok2;
@@ -413,7 +417,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
             }
 
             // make the new scope the current scope
-            scope->nestedList.push_back(new_scope);
+            addNestedRecord(scope, new_scope);
             scope = new_scope;
 
             tok = tok2;
@@ -619,7 +623,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
                     scopeList.emplace_back(this, tok, scope, Scope::eTry, tok1);
 
                 tok = tok1;
-                scope->nestedList.push_back(&scopeList.back());
+                scope->addNestedScope(&scopeList.back());
                 scope = &scopeList.back();
             } else if (Token::Match(tok, "if|for|while|catch|switch (") && Token::simpleMatch(tok->next()->link(), ") {")) {
                 const Token *scopeStartTok = tok->next()->link()->next();
@@ -634,7 +638,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
                 } else // if (tok->str() == "switch")
                     scopeList.emplace_back(this, tok, scope, Scope::eSwitch, scopeStartTok);
 
-                scope->nestedList.push_back(&scopeList.back());
+                scope->addNestedScope(&scopeList.back());
                 scope = &scopeList.back();
                 if (scope->type == Scope::eFor)
                     scope->checkVariable(tok->tokAt(2), Local, mSettings); // check for variable declaration and add it to new scope if found
@@ -653,11 +657,11 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
 
                     if (tok2 && tok2->str() == ")" && tok2->link()->strAt(-1) == "]") {
                         scopeList.emplace_back(this, tok2->link()->linkAt(-1), scope, Scope::eLambda, tok);
-                        scope->nestedList.push_back(&scopeList.back());
+                        scope->addNestedScope(&scopeList.back());
                         scope = &scopeList.back();
                     } else if (!Token::Match(tok->previous(), "=|,|(|return") && !(tok->strAt(-1) == ")" && Token::Match(tok->linkAt(-1)->previous(), "=|,|(|return"))) {
                         scopeList.emplace_back(this, tok, scope, Scope::eUnconditional, tok);
-                        scope->nestedList.push_back(&scopeList.back());
+                        scope->addNestedScope(&scopeList.back());
                         scope = &scopeList.back();
                     } else {
                         tok = tok->link();
@@ -674,7 +678,7 @@ void SymbolDatabase::createSymbolDatabaseClassInfo()
         return;
 
     // fill in using info
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         for (std::list<Scope::UsingInfo>::iterator i = it->usingList.begin(); i != it->usingList.end(); ++i) {
             // only find if not already found
             if (i->scope == nullptr) {
@@ -690,7 +694,7 @@ void SymbolDatabase::createSymbolDatabaseClassInfo()
     }
 
     // fill in base class info
-    for (std::list<Type>::iterator it = typeList.begin(); it != typeList.end(); ++it) {
+    for (StableVector<Type>::iterator it = typeList.begin(); it != typeList.end(); ++it) {
         // finish filling in base class info
         for (unsigned int i = 0; i < it->derivedFrom.size(); ++i) {
             const Type* found = findType(it->derivedFrom[i].nameTok, it->enclosingScope);
@@ -704,7 +708,7 @@ void SymbolDatabase::createSymbolDatabaseClassInfo()
     }
 
     // fill in friend info
-    for (std::list<Type>::iterator it = typeList.begin(); it != typeList.end(); ++it) {
+    for (StableVector<Type>::iterator it = typeList.begin(); it != typeList.end(); ++it) {
         for (std::vector<Type::FriendInfo>::iterator i = it->friendList.begin(); i != it->friendList.end(); ++i) {
             i->type = findType(i->nameStart, it->enclosingScope);
         }
@@ -715,14 +719,14 @@ void SymbolDatabase::createSymbolDatabaseClassInfo()
 void SymbolDatabase::createSymbolDatabaseVariableInfo()
 {
     // fill in variable info
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         // find variables
         it->getVariableList(mSettings);
     }
 
     // fill in function arguments
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
-        std::list<Function>::iterator func;
+    for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+        StableVector<Function>::iterator func;
 
         for (func = it->functionList.begin(); func != it->functionList.end(); ++func) {
             // add arguments
@@ -734,11 +738,11 @@ void SymbolDatabase::createSymbolDatabaseVariableInfo()
 void SymbolDatabase::createSymbolDatabaseCopyAndMoveConstructors()
 {
     // fill in class and struct copy/move constructors
-    for (std::list<Scope>::iterator scope = scopeList.begin(); scope != scopeList.end(); ++scope) {
+    for (StableVector<Scope>::iterator scope = scopeList.begin(); scope != scopeList.end(); ++scope) {
         if (!scope->isClassOrStruct())
             continue;
 
-        std::list<Function>::iterator func;
+        StableVector<Function>::iterator func;
         for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
             if (!func->isConstructor() || func->minArgCount() != 1)
                 continue;
@@ -761,7 +765,7 @@ void SymbolDatabase::createSymbolDatabaseCopyAndMoveConstructors()
 void SymbolDatabase::createSymbolDatabaseFunctionScopes()
 {
     // fill in function scopes
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         if (it->type == Scope::eFunction)
             functionScopes.push_back(&*it);
     }
@@ -770,7 +774,7 @@ void SymbolDatabase::createSymbolDatabaseFunctionScopes()
 void SymbolDatabase::createSymbolDatabaseClassAndStructScopes()
 {
     // fill in class and struct scopes
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         if (it->isClassOrStruct())
             classAndStructScopes.push_back(&*it);
     }
@@ -779,8 +783,8 @@ void SymbolDatabase::createSymbolDatabaseClassAndStructScopes()
 void SymbolDatabase::createSymbolDatabaseFunctionReturnTypes()
 {
     // fill in function return types
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
-        std::list<Function>::iterator func;
+    for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+        StableVector<Function>::iterator func;
 
         for (func = it->functionList.begin(); func != it->functionList.end(); ++func) {
             // add return types
@@ -802,7 +806,7 @@ void SymbolDatabase::createSymbolDatabaseNeedInitialization()
 {
     if (mTokenizer->isC()) {
         // For C code it is easy, as there are no constructors and no default values
-        for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+        for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
             Scope *scope = &(*it);
             if (scope->definedType)
                 scope->definedType->needInitialization = Type::True;
@@ -815,7 +819,7 @@ void SymbolDatabase::createSymbolDatabaseNeedInitialization()
         do {
             unknowns = 0;
 
-            for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+            for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
                 Scope *scope = &(*it);
 
                 if (!scope->definedType) {
@@ -827,7 +831,7 @@ void SymbolDatabase::createSymbolDatabaseNeedInitialization()
                     // check for default constructor
                     bool hasDefaultConstructor = false;
 
-                    std::list<Function>::const_iterator func;
+                    StableVector<Function>::const_iterator func;
 
                     for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
                         if (func->type == Function::eConstructor) {
@@ -856,7 +860,7 @@ void SymbolDatabase::createSymbolDatabaseNeedInitialization()
                         bool needInitialization = false;
                         bool unknown = false;
 
-                        std::list<Variable>::const_iterator var;
+                        StableVector<Variable>::const_iterator var;
                         for (var = scope->varlist.begin(); var != scope->varlist.end() && !needInitialization; ++var) {
                             if (var->isClass()) {
                                 if (var->type()) {
@@ -888,7 +892,7 @@ void SymbolDatabase::createSymbolDatabaseNeedInitialization()
 
         // this shouldn't happen so output a debug warning
         if (retry == 100 && mSettings->debugwarnings) {
-            for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+            for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
                 const Scope *scope = &(*it);
 
                 if (scope->isClassOrStruct() && scope->definedType->needInitialization == Type::Unknown)
@@ -905,11 +909,11 @@ void SymbolDatabase::createSymbolDatabaseVariableSymbolTable()
     std::fill_n(mVariableList.begin(), mVariableList.size(), (const Variable*)nullptr);
 
     // check all scopes for variables
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         Scope *scope = &(*it);
 
         // add all variables
-        for (std::list<Variable>::iterator var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
+        for (StableVector<Variable>::iterator var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
             const unsigned int varId = var->declarationId();
             if (varId)
                 mVariableList[varId] = &(*var);
@@ -922,8 +926,8 @@ void SymbolDatabase::createSymbolDatabaseVariableSymbolTable()
         }
 
         // add all function parameters
-        for (std::list<Function>::iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
-            for (std::list<Variable>::iterator arg = func->argumentList.begin(); arg != func->argumentList.end(); ++arg) {
+        for (StableVector<Function>::iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+            for (StableVector<Variable>::iterator arg = func->argumentList.begin(); arg != func->argumentList.end(); ++arg) {
                 // check for named parameters
                 if (arg->nameToken() && arg->declarationId()) {
                     const unsigned int declarationId = arg->declarationId();
@@ -969,7 +973,7 @@ void SymbolDatabase::createSymbolDatabaseVariableSymbolTable()
 void SymbolDatabase::createSymbolDatabaseSetScopePointers()
 {
     // Set scope pointers
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         Token* start = const_cast<Token*>(it->bodyStart);
         Token* end = const_cast<Token*>(it->bodyEnd);
         if (it->type == Scope::eGlobal) {
@@ -980,22 +984,16 @@ void SymbolDatabase::createSymbolDatabaseSetScopePointers()
 
         end->scope(&*it);
 
+        std::unordered_set<const Token *> innerStarts;
+        for (std::list<Scope*>::const_iterator innerScope = it->nestedList.begin(); innerScope != it->nestedList.end(); ++innerScope)
+            innerStarts.insert((*innerScope)->bodyStart);
+
         for (Token* tok = start; tok != end; tok = tok->next()) {
-            if (start != end && tok->str() == "{") {
-                bool isEndOfScope = false;
-                for (std::list<Scope*>::const_iterator innerScope = it->nestedList.begin(); innerScope != it->nestedList.end(); ++innerScope) {
-                    if (tok == (*innerScope)->bodyStart) { // Is begin of inner scope
-                        tok = tok->link();
-                        if (tok->next() == end || !tok->next()) {
-                            isEndOfScope = true;
-                            break;
-                        }
-                        tok = tok->next();
-                        break;
-                    }
-                }
-                if (isEndOfScope)
+            if (start != end && tok->str() == "{" && innerStarts.find(tok) != innerStarts.end()) { // Is begin of inner scope
+                tok = tok->link();
+                if (tok->next() == end || !tok->next())
                     break;
+                tok = tok->next();
             }
             tok->scope(&*it);
         }
@@ -1006,8 +1004,8 @@ void SymbolDatabase::createSymbolDatabaseSetFunctionPointers(bool firstPass)
 {
     if (firstPass) {
         // Set function definition and declaration pointers
-        for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
-            for (std::list<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
+        for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+            for (StableVector<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
                 if (func->tokenDef)
                     const_cast<Token *>(func->tokenDef)->function(&*func);
 
@@ -1027,8 +1025,8 @@ void SymbolDatabase::createSymbolDatabaseSetFunctionPointers(bool firstPass)
     }
 
     // Set C++ 11 delegate constructor function call pointers
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
-        for (std::list<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
+    for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+        for (StableVector<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
             // look for initializer list
             if (func->isConstructor() && func->functionScope && func->functionScope->functionOf && func->arg) {
                 const Token * tok = func->arg->link()->next();
@@ -1192,7 +1190,7 @@ void SymbolDatabase::createSymbolDatabaseSetVariablePointers()
 void SymbolDatabase::createSymbolDatabaseEnums()
 {
     // fill in enumerators in enum
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         if (it->type != Scope::eEnum)
             continue;
 
@@ -1202,7 +1200,7 @@ void SymbolDatabase::createSymbolDatabaseEnums()
     }
 
     // fill in enumerator values
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (StableVector<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         if (it->type != Scope::eEnum)
             continue;
 
@@ -1356,6 +1354,10 @@ SymbolDatabase::~SymbolDatabase()
         const_cast<Token *>(tok)->enumerator(nullptr);
         const_cast<Token *>(tok)->setValueType(nullptr);
     }
+
+    delete mDefUseIndex;
+    for (std::map<const Scope *, ControlFlowGraph *>::const_iterator it = mControlFlowGraphs.begin(); it != mControlFlowGraphs.end(); ++it)
+        delete it->second;
 }
 
 bool SymbolDatabase::isFunction(const Token *tok, const Scope* outerScope, const Token **funcStart, const Token **argStart, const Token** declEnd) const
@@ -2122,12 +2124,20 @@ void SymbolDatabase::addClassFunction(Scope **scope, const Token **tok, const To
     if (!tok1)
         return;
 
-    std::list<Scope>::iterator it1;
-
-    // search for match
-    for (it1 = scopeList.begin(); it1 != scopeList.end(); ++it1) {
-        Scope *scope1 = &(*it1);
+    // search for match, in the scopes with the name of the class unless
+    // the function can be found through using directives of the current scope
+    std::vector<Scope *> allScopes;
+    const std::vector<Scope *> *scopes = &allScopes;
+    if (*scope && !(*scope)->usingList.empty()) {
+        for (StableVector<Scope>::iterator it1 = scopeList.begin(); it1 != scopeList.end(); ++it1)
+            allScopes.push_back(&*it1);
+    } else {
+        const std::unordered_map<std::string, std::vector<Scope *> >::const_iterator it1 = mRecordsByName.find(tok1->str());
+        if (it1 != mRecordsByName.end())
+            scopes = &it1->second;
+    }
 
+    for (Scope *scope1 : *scopes) {
         bool match = false;
 
         // check in namespace if using found
@@ -2234,6 +2244,13 @@ void SymbolDatabase::addClassFunction(Scope **scope, const Token **tok, const To
     addNewFunction(scope, tok);
 }
 
+void SymbolDatabase::addNestedRecord(Scope *scope, Scope *record)
+{
+    scope->addNestedScope(record);
+    if (!record->className.empty())
+        mRecordsByName[record->className].push_back(record);
+}
+
 void SymbolDatabase::addNewFunction(Scope **scope, const Token **tok)
 {
     const Token *tok1 = *tok;
@@ -2270,7 +2287,7 @@ void SymbolDatabase::addNewFunction(Scope **scope, const Token **tok)
             return;
         }
 
-        (*scope)->nestedList.push_back(newScope);
+        (*scope)->addNestedScope(newScope);
         *scope = newScope;
         *tok = tok1;
     } else {
@@ -2509,26 +2526,31 @@ bool Variable::arrayDimensions(const Library* lib)
     return arr;
 }
 
+static const char *scopeTypeToString(Scope::ScopeType type)
+{
+    return type == Scope::eGlobal ? "Global" :
+           type == Scope::eClass ? "Class" :
+           type == Scope::eStruct ? "Struct" :
+           type == Scope::eUnion ? "Union" :
+           type == Scope::eNamespace ? "Namespace" :
+           type == Scope::eFunction ? "Function" :
+           type == Scope::eIf ? "If" :
+           type == Scope::eElse ? "Else" :
+           type == Scope::eFor ? "For" :
+           type == Scope::eWhile ? "While" :
+           type == Scope::eDo ? "Do" :
+           type == Scope::eSwitch ? "Switch" :
+           type == Scope::eTry ? "Try" :
+           type == Scope::eCatch ? "Catch" :
+           type == Scope::eUnconditional ? "Unconditional" :
+           type == Scope::eLambda ? "Lambda" :
+           type == Scope::eEnum ? "Enum" :
+           "Unknown";
+}
+
 static std::ostream & operator << (std::ostream & s, Scope::ScopeType type)
 {
-    s << (type == Scope::eGlobal ? "Global" :
-          type == Scope::eClass ? "Class" :
-          type == Scope::eStruct ? "Struct" :
-          type == Scope::eUnion ? "Union" :
-          type == Scope::eNamespace ? "Namespace" :
-          type == Scope::eFunction ? "Function" :
-          type == Scope::eIf ? "If" :
-          type == Scope::eElse ? "Else" :
-          type == Scope::eFor ? "For" :
-          type == Scope::eWhile ? "While" :
-          type == Scope::eDo ? "Do" :
-          type == Scope::eSwitch ? "Switch" :
-          type == Scope::eTry ? "Try" :
-          type == Scope::eCatch ? "Catch" :
-          type == Scope::eUnconditional ? "Unconditional" :
-          type == Scope::eLambda ? "Lambda" :
-          type == Scope::eEnum ? "Enum" :
-          "Unknown");
+    s << scopeTypeToString(type);
     return s;
 }
 
@@ -2667,14 +2689,14 @@ void SymbolDatabase::printOut(const char *title) const
     if (title)
         std::cout << "\n### " << title << " ###\n";
 
-    for (std::list<Scope>::const_iterator scope = scopeList.begin(); scope != scopeList.end(); ++scope) {
+    for (StableVector<Scope>::const_iterator scope = scopeList.begin(); scope != scopeList.end(); ++scope) {
         std::cout << "Scope: " << &*scope << " " << scope->type << std::endl;
         std::cout << "    className: " << scope->className << std::endl;
         std::cout << "    classDef: " << tokenToString(scope->classDef, mTokenizer) << std::endl;
         std::cout << "    bodyStart: " << tokenToString(scope->bodyStart, mTokenizer) << std::endl;
         std::cout << "    bodyEnd: " << tokenToString(scope->bodyEnd, mTokenizer) << std::endl;
 
-        std::list<Function>::const_iterator func;
+        StableVector<Function>::const_iterator func;
 
         // find the function body if not implemented inline
         for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
@@ -2752,7 +2774,7 @@ void SymbolDatabase::printOut(const char *title) const
             std::cout << "        nestedIn: " << scopeToString(func->nestedIn, mTokenizer) << std::endl;
             std::cout << "        functionScope: " << scopeToString(func->functionScope, mTokenizer) << std::endl;
 
-            std::list<Variable>::const_iterator var;
+            StableVector<Variable>::const_iterator var;
 
             for (var = func->argumentList.begin(); var != func->argumentList.end(); ++var) {
                 std::cout << "        Variable: " << &*var << std::endl;
@@ -2760,7 +2782,7 @@ void SymbolDatabase::printOut(const char *title) const
             }
         }
 
-        std::list<Variable>::const_iterator var;
+        StableVector<Variable>::const_iterator var;
 
         for (var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
             std::cout << "    Variable: " << &*var << std::endl;
@@ -2839,7 +2861,7 @@ void SymbolDatabase::printOut(const char *title) const
         std::cout << std::endl;
     }
 
-    for (std::list<Type>::const_iterator type = typeList.begin(); type != typeList.end(); ++type) {
+    for (StableVector<Type>::const_iterator type = typeList.begin(); type != typeList.end(); ++type) {
         std::cout << "Type: " << &(*type) << std::endl;
         std::cout << "    name: " << type->name() << std::endl;
         std::cout << "    classDef: " << tokenToString(type->classDef, mTokenizer) << std::endl;
@@ -2906,101 +2928,117 @@ void SymbolDatabase::printOut(const char *title) const
     std::cout << std::resetiosflags(std::ios::boolalpha);
 }
 
+std::size_t SymbolDatabase::memoryUsage() const
+{
+    std::size_t bytes = typeList.size() * sizeof(Type) + mVariableList.capacity() * sizeof(const Variable *);
+    for (const Scope &scope : scopeList) {
+        bytes += sizeof(Scope);
+        bytes += scope.varlist.size() * sizeof(Variable);
+        bytes += scope.functionList.size() * sizeof(Function);
+        for (const Function &function : scope.functionList)
+            bytes += function.argumentList.size() * sizeof(Variable);
+    }
+    return bytes;
+}
+
 void SymbolDatabase::printXml(std::ostream &out) const
 {
-    out << std::setiosflags(std::ios::boolalpha);
+    XmlDumpWriter writer(out, 1);
+    dump(writer);
+}
 
+void SymbolDatabase::dump(DumpWriter &out) const
+{
     std::set<const Variable *> variables;
 
     // Scopes..
-    out << "  <scopes>" << std::endl;
-    for (std::list<Scope>::const_iterator scope = scopeList.begin(); scope != scopeList.end(); ++scope) {
-        out << "    <scope";
-        out << " id=\"" << &*scope << "\"";
-        out << " type=\"" << scope->type << "\"";
+    out.startElement("scopes");
+    for (StableVector<Scope>::const_iterator scope = scopeList.begin(); scope != scopeList.end(); ++scope) {
+        out.startElement("scope");
+        out.attribute("id", &*scope);
+        out.attribute("type", scopeTypeToString(scope->type));
         if (!scope->className.empty())
-            out << " className=\"" << ErrorLogger::toxml(scope->className) << "\"";
+            out.attribute("className", scope->className);
         if (scope->bodyStart)
-            out << " bodyStart=\"" << scope->bodyStart << '\"';
+            out.attribute("bodyStart", scope->bodyStart);
         if (scope->bodyEnd)
-            out << " bodyEnd=\"" << scope->bodyEnd << '\"';
+            out.attribute("bodyEnd", scope->bodyEnd);
         if (scope->nestedIn)
-            out << " nestedIn=\"" << scope->nestedIn << "\"";
+            out.attribute("nestedIn", scope->nestedIn);
         if (scope->function)
-            out << " function=\"" << scope->function << "\"";
-        if (scope->functionList.empty() && scope->varlist.empty())
-            out << "/>" << std::endl;
-        else {
-            out << '>' << std::endl;
-            if (!scope->functionList.empty()) {
-                out << "      <functionList>" << std::endl;
-                for (std::list<Function>::const_iterator function = scope->functionList.begin(); function != scope->functionList.end(); ++function) {
-                    out << "        <function id=\"" << &*function << "\" tokenDef=\"" << function->tokenDef << "\" name=\"" << ErrorLogger::toxml(function->name()) << '\"';
-                    out << " type=\"" << (function->type == Function::eConstructor? "Constructor" :
-                                          function->type == Function::eCopyConstructor ? "CopyConstructor" :
-                                          function->type == Function::eMoveConstructor ? "MoveConstructor" :
-                                          function->type == Function::eOperatorEqual ? "OperatorEqual" :
-                                          function->type == Function::eDestructor ? "Destructor" :
-                                          function->type == Function::eFunction ? "Function" :
-                                          "Unknown") << '\"';
-                    if (function->nestedIn->definedType) {
-                        if (function->isVirtual())
-                            out << " isVirtual=\"true\"";
-                        else if (function->isImplicitlyVirtual())
-                            out << " isImplicitlyVirtual=\"true\"";
-                    }
-                    if (function->argCount() == 0U)
-                        out << "/>" << std::endl;
-                    else {
-                        out << ">" << std::endl;
-                        for (unsigned int argnr = 0; argnr < function->argCount(); ++argnr) {
-                            const Variable *arg = function->getArgumentVar(argnr);
-                            out << "          <arg nr=\"" << argnr+1 << "\" variable=\"" << arg << "\"/>" << std::endl;
-                            variables.insert(arg);
-                        }
-                        out << "        </function>" << std::endl;
-                    }
+            out.attribute("function", scope->function);
+        if (!scope->functionList.empty()) {
+            out.startElement("functionList");
+            for (StableVector<Function>::const_iterator function = scope->functionList.begin(); function != scope->functionList.end(); ++function) {
+                out.startElement("function");
+                out.attribute("id", &*function);
+                out.attribute("tokenDef", function->tokenDef);
+                out.attribute("name", function->name());
+                out.attribute("type", function->type == Function::eConstructor? "Constructor" :
+                              function->type == Function::eCopyConstructor ? "CopyConstructor" :
+                              function->type == Function::eMoveConstructor ? "MoveConstructor" :
+                              function->type == Function::eOperatorEqual ? "OperatorEqual" :
+                              function->type == Function::eDestructor ? "Destructor" :
+                              function->type == Function::eFunction ? "Function" :
+                              "Unknown");
+                if (function->nestedIn->definedType) {
+                    if (function->isVirtual())
+                        out.attribute("isVirtual", true);
+                    else if (function->isImplicitlyVirtual())
+                        out.attribute("isImplicitlyVirtual", true);
                 }
-                out << "      </functionList>" << std::endl;
+                for (unsigned int argnr = 0; argnr < function->argCount(); ++argnr) {
+                    const Variable *arg = function->getArgumentVar(argnr);
+                    out.startElement("arg");
+                    out.attribute("nr", argnr+1);
+                    out.attribute("variable", arg);
+                    out.endElement();
+                    variables.insert(arg);
+                }
+                out.endElement();
             }
-            if (!scope->varlist.empty()) {
-                out << "      <varlist>" << std::endl;
-                for (std::list<Variable>::const_iterator var = scope->varlist.begin(); var != scope->varlist.end(); ++var)
-                    out << "        <var id=\""   << &*var << "\"/>" << std::endl;
-                out << "      </varlist>" << std::endl;
+            out.endElement();
+        }
+        if (!scope->varlist.empty()) {
+            out.startElement("varlist");
+            for (StableVector<Variable>::const_iterator var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
+                out.startElement("var");
+                out.attribute("id", &*var);
+                out.endElement();
             }
-            out << "    </scope>" << std::endl;
+            out.endElement();
         }
+        out.endElement();
     }
-    out << "  </scopes>" << std::endl;
+    out.endElement();
 
     // Variables..
     for (const Variable *var : mVariableList)
         variables.insert(var);
-    out << "  <variables>" << std::endl;
+    out.startElement("variables");
     for (const Variable *var : variables) {
         if (!var)
             continue;
-        out << "    <var id=\""   << var << '\"';
-        out << " nameToken=\""      << var->nameToken() << '\"';
-        out << " typeStartToken=\"" << var->typeStartToken() << '\"';
-        out << " typeEndToken=\""   << var->typeEndToken() << '\"';
-        out << " access=\""         << accessControlToString(var->mAccess) << '\"';
-        out << " scope=\""          << var->scope() << '\"';
-        out << " constness=\""      << var->valueType()->constness << '\"';
-        out << " isArgument=\""     << var->isArgument() << '\"';
-        out << " isArray=\""        << var->isArray() << '\"';
-        out << " isClass=\""        << var->isClass() << '\"';
-        out << " isConst=\""        << var->isConst() << '\"';
-        out << " isExtern=\""       << var->isExtern() << '\"';
-        out << " isLocal=\""        << var->isLocal() << '\"';
-        out << " isPointer=\""      << var->isPointer() << '\"';
-        out << " isReference=\""    << var->isReference() << '\"';
-        out << " isStatic=\""       << var->isStatic() << '\"';
-        out << "/>" << std::endl;
-    }
-    out << "  </variables>" << std::endl;
-    out << std::resetiosflags(std::ios::boolalpha);
+        out.startElement("var");
+        out.attribute("id", var);
+        out.attribute("nameToken", var->nameToken());
+        out.attribute("typeStartToken", var->typeStartToken());
+        out.attribute("typeEndToken", var->typeEndToken());
+        out.attribute("access", accessControlToString(var->mAccess));
+        out.attribute("scope", var->scope());
+        out.attribute("constness", var->valueType()->constness);
+        out.attribute("isArgument", var->isArgument());
+        out.attribute("isArray", var->isArray());
+        out.attribute("isClass", var->isClass());
+        out.attribute("isConst", var->isConst());
+        out.attribute("isExtern", var->isExtern());
+        out.attribute("isLocal", var->isLocal());
+        out.attribute("isPointer", var->isPointer());
+        out.attribute("isReference", var->isReference());
+        out.attribute("isStatic", var->isStatic());
+        out.endElement();
+    }
+    out.endElement();
 }
 
 //---------------------------------------------------------------------------
@@ -3218,7 +3256,7 @@ const Function * Function::getOverridenFunctionRecursive(const ::Type* baseType,
 
 const Variable* Function::getArgumentVar(std::size_t num) const
 {
-    for (std::list<Variable>::const_iterator i = argumentList.begin(); i != argumentList.end(); ++i) {
+    for (StableVector<Variable>::const_iterator i = argumentList.begin(); i != argumentList.end(); ++i) {
         if (i->index() == num)
             return (&*i);
         else if (i->index() > num)
@@ -3295,7 +3333,7 @@ Scope::Scope(const SymbolDatabase *check_, const Token *classDef_, const Scope *
 bool Scope::hasDefaultConstructor() const
 {
     if (numConstructors) {
-        std::list<Function>::const_iterator func;
+        StableVector<Function>::const_iterator func;
 
         for (func = functionList.begin(); func != functionList.end(); ++func) {
             if (func->type == Function::eConstructor && func->argCount() == 0)
@@ -3508,14 +3546,8 @@ const Token *Scope::checkVariable(const Token *tok, AccessControl varaccess, con
 
 const Variable *Scope::getVariable(const std::string &varname) const
 {
-    std::list<Variable>::const_iterator iter;
-
-    for (iter = varlist.begin(); iter != varlist.end(); ++iter) {
-        if (iter->name() == varname)
-            return &*iter;
-    }
-
-    return nullptr;
+    const std::unordered_map<std::string, const Variable *>::const_iterator it = mVariableMap.find(varname);
+    return (it != mVariableMap.end()) ? it->second : nullptr;
 }
 
 static const Token* skipPointers(const Token* tok)
@@ -3809,6 +3841,8 @@ const Type* SymbolDatabase::findVariableTypeInBase(const Scope* scope, const Tok
 
 const Type* SymbolDatabase::findVariableType(const Scope *start, const Token *typeTok) const
 {
+    COUNTER_NAME("SymbolDatabase::findVariableType", typeTok->str());
+    COUNTER_CALLSITE("SymbolDatabase::findVariableType callers");
     const Scope *scope = start;
 
     // check if type does not have a namespace
@@ -4008,11 +4042,18 @@ static bool valueTypeMatch(const ValueType * valuetype, const Token * type)
 
 const Function* Scope::findFunction(const Token *tok, bool requireConst) const
 {
+    COUNTER_NAME("Scope::findFunction", tok->str());
+    COUNTER_CALLSITE("Scope::findFunction callers");
     // make sure this is a function call
     const Token *end = tok->linkAt(1);
     if (!end)
         return nullptr;
 
+    // no function with this name in this scope or its base classes
+    if (functionMap.find(tok->str()) == functionMap.end() &&
+        !(isClassOrStruct() && definedType && !definedType->derivedFrom.empty()))
+        return nullptr;
+
     std::vector<const Token *> arguments;
 
     // find all the arguments for this function call
@@ -4333,6 +4374,8 @@ const Function* Scope::findFunction(const Token *tok, bool requireConst) const
 
 const Function* SymbolDatabase::findFunction(const Token *tok) const
 {
+    COUNTER_NAME("SymbolDatabase::findFunction", tok->str());
+    COUNTER_CALLSITE("SymbolDatabase::findFunction callers");
     // find the scope this function is in
     const Scope *currScope = tok->scope();
     while (currScope && currScope->isExecutable()) {
@@ -4427,7 +4470,7 @@ const Function* SymbolDatabase::findFunction(const Token *tok) const
 
 const Scope *SymbolDatabase::findScopeByName(const std::string& name) const
 {
-    for (std::list<Scope>::const_iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (StableVector<Scope>::const_iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         if (it->className == name)
             return &*it;
     }
@@ -4451,12 +4494,9 @@ Scope *Scope::findInNestedList(const std::string & name)
 
 const Scope *Scope::findRecordInNestedList(const std::string & name) const
 {
-    std::list<Scope *>::const_iterator it;
-
-    for (it = nestedList.begin(); it != nestedList.end(); ++it) {
-        if ((*it)->className == name && (*it)->type != eFunction)
-            return (*it);
-    }
+    const std::unordered_map<std::string, Scope *>::const_iterator it = mRecordMap.find(name);
+    if (it != mRecordMap.end())
+        return it->second;
 
     const Type * nested_type = findType(name);
 
@@ -4515,7 +4555,7 @@ Scope *Scope::findInNestedListRecursive(const std::string & name)
 
 const Function *Scope::getDestructor() const
 {
-    std::list<Function>::const_iterator it;
+    StableVector<Function>::const_iterator it;
     for (it = functionList.begin(); it != functionList.end(); ++it) {
         if (it->type == Function::eDestructor)
             return &(*it);
@@ -4940,7 +4980,7 @@ void SymbolDatabase::setValueType(Token *tok, const ValueType &valuetype)
             const Scope *typeScope = vt1->typeScope;
             if (!typeScope)
                 return;
-            for (std::list<Variable>::const_iterator it = typeScope->varlist.begin(); it != typeScope->varlist.end(); ++it) {
+            for (StableVector<Variable>::const_iterator it = typeScope->varlist.begin(); it != typeScope->varlist.end(); ++it) {
                 if (it->nameToken()->str() == name) {
                     var = &*it;
                     break;
@@ -5247,6 +5287,10 @@ void SymbolDatabase::setValueTypeInTokenList()
 {
     Token * tokens = const_cast<Tokenizer *>(mTokenizer)->list.front();
 
+    delete mDefUseIndex;
+    mDefUseIndex = nullptr;
+    mResolvedLibraryCalls.clear();
+
     for (Token *tok = tokens; tok; tok = tok->next())
         tok->setValueType(nullptr);
 
@@ -5445,6 +5489,440 @@ void SymbolDatabase::setValueTypeInTokenList()
 
     // Update auto variables with new type information.
     createSymbolDatabaseSetVariablePointers();
+
+    // Resolve library functions of calls
+    std::unordered_map<const Token *, Library::ResolvedCall> resolvedLibraryCalls;
+    for (const Token *tok = tokens; tok; tok = tok->next()) {
+        if (Token::Match(tok, "%name% (") && !Token::Match(tok, "if|while|for|switch|return|sizeof|decltype"))
+            resolvedLibraryCalls[tok] = mSettings->library.resolveCall(tok);
+    }
+    mResolvedLibraryCalls.swap(resolvedLibraryCalls);
+
+    // Index reads and writes of variables
+    Token::assignIndexes(tokens);
+    mDefUseIndex = new DefUseIndex(tokens, mTokenizer->varIdCount(), mSettings, mIsCpp);
+}
+
+const std::vector<unsigned int> DefUseIndex::mEmptyPositions;
+
+DefUseIndex::DefUseIndex(const Token *tokens, unsigned int varIdCount, const Settings *settings, bool cpp)
+    : mPositions(varIdCount + 1), mSettings(settings), mCpp(cpp)
+{
+    for (const Token *tok = tokens; tok; tok = tok->next()) {
+        if (Token::Match(tok, "%name% ("))
+            mCalls.emplace_back(tok->index(), tok->varId());
+        if (tok->varId() == 0 || tok->varId() >= mPositions.size())
+            continue;
+        Positions &positions = mPositions[tok->varId()];
+        if (isVariableChanged(tok, settings, cpp))
+            positions.writes.push_back(tok->index());
+        else if (!tok->variable() || tok->variable()->nameToken() != tok)
+            positions.reads.push_back(tok->index());
+        if (isVariableChanged(tok, nullptr, cpp))
+            positions.writesNoSettings.push_back(tok->index());
+    }
+}
+
+bool DefUseIndex::getRange(const Token *start, const Token *end, unsigned int varid, unsigned int *startPos, unsigned int *endPos) const
+{
+    if (varid == 0 || varid >= mPositions.size() || !start || start->index() == 0)
+        return false;
+    if (end && (end->index() == 0 || end->index() < start->index()))
+        return false;
+    *startPos = start->index();
+    *endPos = end ? end->index() : UINT_MAX;
+    return true;
+}
+
+static bool hasPosition(const std::vector<unsigned int> &positions, unsigned int startPos, unsigned int endPos)
+{
+    const std::vector<unsigned int>::const_iterator it = std::lower_bound(positions.begin(), positions.end(), startPos);
+    return it != positions.end() && *it < endPos;
+}
+
+bool DefUseIndex::isChanged(const Token *start, const Token *end, unsigned int varid, bool globalvar, const Settings *settings, bool cpp, bool *changed) const
+{
+    if (cpp != mCpp || (settings && settings != mSettings))
+        return false;
+    unsigned int startPos, endPos;
+    if (!getRange(start, end, varid, &startPos, &endPos))
+        return false;
+
+    const Positions &positions = mPositions[varid];
+    if (hasPosition(settings ? positions.writes : positions.writesNoSettings, startPos, endPos)) {
+        *changed = true;
+        return true;
+    }
+
+    *changed = false;
+    if (globalvar) {
+        // TODO: Is global variable really changed by function call?
+        std::vector<std::pair<unsigned int, unsigned int> >::const_iterator it = std::lower_bound(mCalls.begin(), mCalls.end(), std::make_pair(startPos, 0U));
+        for (; it != mCalls.end() && it->first < endPos; ++it) {
+            if (it->second != varid) {
+                *changed = true;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+bool DefUseIndex::isRead(const Token *start, const Token *end, unsigned int varid) const
+{
+    unsigned int startPos, endPos;
+    return getRange(start, end, varid, &startPos, &endPos) && hasPosition(mPositions[varid].reads, startPos, endPos);
+}
+
+const std::vector<unsigned int> &DefUseIndex::writes(unsigned int varid) const
+{
+    return varid < mPositions.size() ? mPositions[varid].writes : mEmptyPositions;
+}
+
+const std::vector<unsigned int> &DefUseIndex::reads(unsigned int varid) const
+{
+    return varid < mPositions.size() ? mPositions[varid].reads : mEmptyPositions;
+}
+
+const Library::ResolvedCall *SymbolDatabase::resolvedLibraryCall(const Token *ftok, const Library *library) const
+{
+    if (mResolvedLibraryCalls.empty() || library != &mSettings->library)
+        return nullptr;
+    const std::unordered_map<const Token *, Library::ResolvedCall>::const_iterator it = mResolvedLibraryCalls.find(ftok);
+    return it != mResolvedLibraryCalls.end() ? &it->second : nullptr;
+}
+
+const ControlFlowGraph *SymbolDatabase::controlFlowGraph(const Scope *scope) const
+{
+    if (!scope || (scope->type != Scope::eFunction && scope->type != Scope::eLambda) || !scope->bodyStart)
+        return nullptr;
+    std::map<const Scope *, ControlFlowGraph *>::const_iterator it = mControlFlowGraphs.find(scope);
+    if (it != mControlFlowGraphs.end())
+        return it->second;
+    ControlFlowGraph *cfg = new ControlFlowGraph(scope, &mSettings->library);
+    mControlFlowGraphs[scope] = cfg;
+    return cfg;
+}
+
+class ControlFlowGraph::Builder {
+public:
+    Builder(ControlFlowGraph *cfg, const Library *library) : mCfg(cfg), mLibrary(library) {}
+
+    void build(const Scope *functionScope) {
+        mCfg->mBlocks.resize(2);
+        mCfg->mFirstIndex = functionScope->bodyStart->index();
+        if (mCfg->mFirstIndex > 0 && functionScope->bodyEnd->index() > mCfg->mFirstIndex)
+            mCfg->mBlockOfIndex.assign(functionScope->bodyEnd->index() - mCfg->mFirstIndex + 1, NONE);
+        addEdge(parseBlock(functionScope->bodyStart->next(), functionScope->bodyEnd, ENTRY), EXIT);
+
+        for (std::vector<std::pair<unsigned int, std::string> >::const_iterator it = mGotos.begin(); it != mGotos.end(); ++it) {
+            const std::map<std::string, unsigned int>::const_iterator label = mLabels.find(it->second);
+            addEdge(it->first, label != mLabels.end() ? label->second : EXIT);
+        }
+
+        mCfg->mReachable.assign(mCfg->mBlocks.size(), false);
+        std::vector<unsigned int> worklist(1, ENTRY);
+        mCfg->mReachable[ENTRY] = true;
+        while (!worklist.empty()) {
+            const unsigned int block = worklist.back();
+            worklist.pop_back();
+            for (unsigned int succ : mCfg->mBlocks[block].successors) {
+                if (!mCfg->mReachable[succ]) {
+                    mCfg->mReachable[succ] = true;
+                    worklist.push_back(succ);
+                }
+            }
+        }
+    }
+
+private:
+    /** targets for break and continue */
+    struct Jump {
+        Jump(unsigned int b, unsigned int c) : breakTarget(b), continueTarget(c) {}
+        unsigned int breakTarget;
+        unsigned int continueTarget;
+    };
+
+    struct Switch {
+        explicit Switch(unsigned int h) : head(h), hasDefault(false) {}
+        unsigned int head;
+        bool hasDefault;
+    };
+
+    unsigned int newBlock() {
+        mCfg->mBlocks.push_back(BasicBlock());
+        return mCfg->mBlocks.size() - 1;
+    }
+
+    void addEdge(unsigned int from, unsigned int to) {
+        if (from == NONE || to == NONE)
+            return;
+        std::vector<unsigned int> &successors = mCfg->mBlocks[from].successors;
+        if (std::find(successors.begin(), successors.end(), to) != successors.end())
+            return;
+        successors.push_back(to);
+        mCfg->mBlocks[to].predecessors.push_back(from);
+    }
+
+    /** Add tokens start..end to block. A new block is created for unreachable code. */
+    unsigned int append(unsigned int block, const Token *start, const Token *end) {
+        if (block == NONE)
+            block = newBlock();
+        BasicBlock &bb = mCfg->mBlocks[block];
+        if (!bb.start)
+            bb.start = start;
+        bb.end = end;
+        for (const Token *tok = start; tok != end->next(); tok = tok->next()) {
+            const unsigned int pos = tok->index() - mCfg->mFirstIndex;
+            if (tok->index() >= mCfg->mFirstIndex && pos < mCfg->mBlockOfIndex.size())
+                mCfg->mBlockOfIndex[pos] = block;
+        }
+        return block;
+    }
+
+    /** Is the statement tok..last a call of a noreturn function? */
+    bool isNoreturnCall(const Token *tok, const Token *last) const {
+        if (!mLibrary || last->str() != ";")
+            return false;
+        if (tok->str() == "::")
+            tok = tok->next();
+        while (Token::Match(tok, "%name% :: %name%"))
+            tok = tok->tokAt(2);
+        return Token::Match(tok, "%name% (") && tok->linkAt(1)->next() == last && mLibrary->isnoreturn(tok);
+    }
+
+    static const Token *statementEnd(const Token *tok, const Token *end) {
+        const Token *last = tok;
+        for (; tok && tok != end; tok = tok->next()) {
+            if (Token::Match(tok, "(|[|{") && tok->link())
+                tok = tok->link();
+            last = tok;
+            if (tok->str() == ";")
+                break;
+        }
+        return last;
+    }
+
+    unsigned int continueTarget() const {
+        return mJumps.empty() ? NONE : mJumps.back().continueTarget;
+    }
+
+    /** Parse statements from start until end, return the block where execution continues */
+    unsigned int parseBlock(const Token *start, const Token *end, unsigned int block) {
+        for (const Token *tok = start; tok && tok != end;)
+            tok = parseStatement(tok, end, &block);
+        return block;
+    }
+
+    const Token *parseStatement(const Token *tok, const Token *end, unsigned int *block) {
+        if (tok->str() == "{" && tok->link()) {
+            *block = parseBlock(tok->next(), tok->link(), *block);
+            return tok->link()->next();
+        }
+        if (tok->str() == ";")
+            return tok->next();
+
+        if (Token::Match(tok, "if|while|for|switch (") && Token::simpleMatch(tok->linkAt(1), ") {")) {
+            const Token *condEnd = tok->linkAt(1);
+            const Token *bodyStart = condEnd->next();
+            if (tok->str() == "if")
+                return parseIf(tok, condEnd, block);
+            if (tok->str() == "switch")
+                return parseSwitch(tok, condEnd, block);
+
+            const unsigned int head = newBlock();
+            addEdge(*block, head);
+            append(head, tok, condEnd);
+            const unsigned int body = newBlock();
+            const unsigned int after = newBlock();
+            addEdge(head, body);
+            addEdge(head, after);
+            mJumps.emplace_back(after, head);
+            addEdge(parseBlock(bodyStart->next(), bodyStart->link(), body), head);
+            mJumps.pop_back();
+            *block = after;
+            return bodyStart->link()->next();
+        }
+
+        if (Token::simpleMatch(tok, "do {"))
+            return parseDo(tok, block);
+
+        if (Token::simpleMatch(tok, "try {"))
+            return parseTry(tok, block);
+
+        if (Token::Match(tok, "case|default") && !mSwitches.empty()) {
+            const Token *colon = tok;
+            while (colon && colon != end && colon->str() != ":") {
+                if (Token::Match(colon, "(|[") && colon->link())
+                    colon = colon->link();
+                colon = colon->next();
+            }
+            if (!colon || colon == end)
+                return end;
+            const unsigned int caseBlock = newBlock();
+            addEdge(*block, caseBlock);
+            addEdge(mSwitches.back().head, caseBlock);
+            if (tok->str() == "default")
+                mSwitches.back().hasDefault = true;
+            *block = caseBlock;
+            return colon->next();
+        }
+
+        if (Token::Match(tok, "%name% :") && tok->varId() == 0 && !Token::Match(tok, "case|default|public|protected|private")) {
+            const unsigned int label = newBlock();
+            addEdge(*block, label);
+            mLabels[tok->str()] = label;
+            *block = label;
+            return tok->tokAt(2);
+        }
+
+        const Token *last = statementEnd(tok, end);
+        *block = append(*block, tok, last);
+        if (tok->str() == "return") {
+            addEdge(*block, EXIT);
+            *block = NONE;
+        } else if (tok->str() == "throw") {
+            if (mCatches.empty())
+                addEdge(*block, EXIT);
+            else {
+                for (unsigned int catchBlock : mCatches.back())
+                    addEdge(*block, catchBlock);
+            }
+            *block = NONE;
+        } else if (Token::Match(tok, "break|continue ;")) {
+            const unsigned int target = mJumps.empty() ? NONE : (tok->str() == "break" ? mJumps.back().breakTarget : mJumps.back().continueTarget);
+            addEdge(*block, target == NONE ? EXIT : target);
+            *block = NONE;
+        } else if (Token::Match(tok, "goto %name% ;")) {
+            mGotos.emplace_back(*block, tok->strAt(1));
+            *block = NONE;
+        } else if (isNoreturnCall(tok, last)) {
+            addEdge(*block, EXIT);
+            *block = NONE;
+        }
+        return last->next();
+    }
+
+    const Token *parseIf(const Token *tok, const Token *condEnd, unsigned int *block) {
+        const unsigned int cond = append(*block, tok, condEnd);
+        const Token *thenStart = condEnd->next();
+        const unsigned int thenBlock = newBlock();
+        addEdge(cond, thenBlock);
+        const unsigned int thenEnd = parseBlock(thenStart->next(), thenStart->link(), thenBlock);
+        const Token *next = thenStart->link()->next();
+
+        unsigned int elseEnd = cond;
+        if (Token::simpleMatch(thenStart->link(), "} else {")) {
+            const Token *elseStart = thenStart->link()->tokAt(2);
+            const unsigned int elseBlock = newBlock();
+            addEdge(cond, elseBlock);
+            elseEnd = parseBlock(elseStart->next(), elseStart->link(), elseBlock);
+            next = elseStart->link()->next();
+        }
+
+        *block = newBlock();
+        addEdge(thenEnd, *block);
+        addEdge(elseEnd, *block);
+        return next;
+    }
+
+    const Token *parseSwitch(const Token *tok, const Token *condEnd, unsigned int *block) {
+        const unsigned int head = append(*block, tok, condEnd);
+        const Token *bodyStart = condEnd->next();
+        const unsigned int after = newBlock();
+        mJumps.emplace_back(after, continueTarget());
+        mSwitches.emplace_back(head);
+        addEdge(parseBlock(bodyStart->next(), bodyStart->link(), NONE), after);
+        if (!mSwitches.back().hasDefault)
+            addEdge(head, after);
+        mSwitches.pop_back();
+        mJumps.pop_back();
+        *block = after;
+        return bodyStart->link()->next();
+    }
+
+    const Token *parseDo(const Token *tok, unsigned int *block) {
+        const Token *bodyEnd = tok->linkAt(1);
+        const unsigned int body = newBlock();
+        const unsigned int cond = newBlock();
+        const unsigned int after = newBlock();
+        addEdge(*block, body);
+        mJumps.emplace_back(after, cond);
+        addEdge(parseBlock(tok->tokAt(2), bodyEnd, body), cond);
+        mJumps.pop_back();
+        addEdge(cond, body);
+        addEdge(cond, after);
+        *block = after;
+
+        if (!Token::simpleMatch(bodyEnd, "} while ("))
+            return bodyEnd->next();
+        const Token *condEnd = bodyEnd->linkAt(2);
+        if (condEnd->next() && condEnd->next()->str() == ";")
+            condEnd = condEnd->next();
+        append(cond, bodyEnd->next(), condEnd);
+        return condEnd->next();
+    }
+
+    const Token *parseTry(const Token *tok, unsigned int *block) {
+        const Token *tryEnd = tok->linkAt(1);
+
+        std::vector<unsigned int> catchBlocks;
+        std::vector<const Token *> catchTokens;
+        const Token *next = tryEnd->next();
+        for (const Token *c = tryEnd; Token::simpleMatch(c, "} catch (") && Token::simpleMatch(c->linkAt(2), ") {"); c = c->linkAt(2)->next()->link()) {
+            catchBlocks.push_back(append(newBlock(), c->next(), c->linkAt(2)));
+            catchTokens.push_back(c->next());
+            next = c->linkAt(2)->next()->link()->next();
+        }
+
+        const unsigned int body = newBlock();
+        addEdge(*block, body);
+        mCatches.push_back(catchBlocks);
+        const unsigned int bodyEnd = parseBlock(tok->tokAt(2), tryEnd, body);
+        mCatches.pop_back();
+
+        // Any statement in the try block might throw
+        const unsigned int lastTryBlock = mCfg->mBlocks.size();
+        for (unsigned int b = body; b < lastTryBlock; ++b) {
+            for (unsigned int catchBlock : catchBlocks)
+                addEdge(b, catchBlock);
+        }
+
+        const unsigned int after = newBlock();
+        addEdge(bodyEnd, after);
+        for (std::size_t i = 0; i < catchBlocks.size(); ++i) {
+            const Token *catchStart = catchTokens[i]->linkAt(1)->next();
+            addEdge(parseBlock(catchStart->next(), catchStart->link(), catchBlocks[i]), after);
+        }
+        *block = after;
+        return next;
+    }
+
+    ControlFlowGraph *mCfg;
+    const Library *mLibrary;
+    std::vector<Jump> mJumps;
+    std::vector<Switch> mSwitches;
+    /** catch blocks of the enclosing try blocks */
+    std::vector<std::vector<unsigned int> > mCatches;
+    std::map<std::string, unsigned int> mLabels;
+    std::vector<std::pair<unsigned int, std::string> > mGotos;
+};
+
+const unsigned int ControlFlowGraph::ENTRY;
+const unsigned int ControlFlowGraph::EXIT;
+const unsigned int ControlFlowGraph::NONE;
+
+ControlFlowGraph::ControlFlowGraph(const Scope *functionScope, const Library *library)
+    : mFirstIndex(0)
+{
+    Builder(this, library).build(functionScope);
+}
+
+unsigned int ControlFlowGraph::blockOf(const Token *tok) const
+{
+    if (!tok || tok->index() < mFirstIndex || tok->index() - mFirstIndex >= mBlockOfIndex.size())
+        return NONE;
+    return mBlockOfIndex[tok->index() - mFirstIndex];
 }
 
 ValueType ValueType::parseDecl(const Token *type, const Settings *settings)
@@ -5533,56 +6011,55 @@ bool ValueType::fromLibraryType(const std::string &typestr, const Settings *sett
     return false;
 }
 
-std::string ValueType::dump() const
+void ValueType::dump(DumpWriter &out) const
 {
-    std::ostringstream ret;
     switch (type) {
     case UNKNOWN_TYPE:
-        return "";
+        return;
     case NONSTD:
-        ret << "valueType-type=\"nonstd\"";
+        out.attribute("valueType-type", "nonstd");
         break;
     case RECORD:
-        ret << "valueType-type=\"record\"";
+        out.attribute("valueType-type", "record");
         break;
     case CONTAINER:
-        ret << "valueType-type=\"container\"";
+        out.attribute("valueType-type", "container");
         break;
     case ITERATOR:
-        ret << "valueType-type=\"iterator\"";
+        out.attribute("valueType-type", "iterator");
         break;
     case VOID:
-        ret << "valueType-type=\"void\"";
+        out.attribute("valueType-type", "void");
         break;
     case BOOL:
-        ret << "valueType-type=\"bool\"";
+        out.attribute("valueType-type", "bool");
         break;
     case CHAR:
-        ret << "valueType-type=\"char\"";
+        out.attribute("valueType-type", "char");
         break;
     case SHORT:
-        ret << "valueType-type=\"short\"";
+        out.attribute("valueType-type", "short");
         break;
     case INT:
-        ret << "valueType-type=\"int\"";
+        out.attribute("valueType-type", "int");
         break;
     case LONG:
-        ret << "valueType-type=\"long\"";
+        out.attribute("valueType-type", "long");
         break;
     case LONGLONG:
-        ret << "valueType-type=\"long long\"";
+        out.attribute("valueType-type", "long long");
         break;
     case UNKNOWN_INT:
-        ret << "valueType-type=\"unknown int\"";
+        out.attribute("valueType-type", "unknown int");
         break;
     case FLOAT:
-        ret << "valueType-type=\"float\"";
+        out.attribute("valueType-type", "float");
         break;
     case DOUBLE:
-        ret << "valueType-type=\"double\"";
+        out.attribute("valueType-type", "double");
         break;
     case LONGDOUBLE:
-        ret << "valueType-type=\"long double\"";
+        out.attribute("valueType-type", "long double");
         break;
     };
 
@@ -5590,29 +6067,27 @@ std::string ValueType::dump() const
     case Sign::UNKNOWN_SIGN:
         break;
     case Sign::SIGNED:
-        ret << " valueType-sign=\"signed\"";
+        out.attribute("valueType-sign", "signed");
         break;
     case Sign::UNSIGNED:
-        ret << " valueType-sign=\"unsigned\"";
+        out.attribute("valueType-sign", "unsigned");
         break;
     };
 
     if (bits > 0)
-        ret << " valueType-bits=\"" << bits << '\"';
+        out.attribute("valueType-bits", bits);
 
     if (pointer > 0)
-        ret << " valueType-pointer=\"" << pointer << '\"';
+        out.attribute("valueType-pointer", pointer);
 
     if (constness > 0)
-        ret << " valueType-constness=\"" << constness << '\"';
+        out.attribute("valueType-constness", constness);
 
     if (typeScope)
-        ret << " valueType-typeScope=\"" << typeScope << '\"';
+        out.attribute("valueType-typeScope", typeScope);
 
     if (!originalTypeName.empty())
-        ret << " valueType-originalTypeName=\"" << originalTypeName << '\"';
-
-    return ret.str();
+        out.rawAttribute("valueType-originalTypeName", originalTypeName);
 }
 
 std::string ValueType::str() const
@@ -24,6 +24,7 @@
 #include "config.h"
 #include "library.h"
 #include "mathlib.h"
+#include "stablevector.h"
 #include "token.h"
 
 #include <cstddef>
@@ -31,9 +32,11 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+class DumpWriter;
 class ErrorLogger;
 class Function;
 class Scope;
@@ -887,7 +890,7 @@ public:
     const ::Type *retType;            ///< function return type
     const Scope *functionScope;       ///< scope of function body
     const Scope* nestedIn;            ///< Scope the function is declared in
-    std::list<Variable> argumentList; ///< argument list
+    StableVector<Variable> argumentList; ///< argument list
     unsigned int initArgCount;        ///< number of args with default values
     Type type;                        ///< constructor, destructor, ...
     AccessControl access;             ///< public/protected/private
@@ -984,9 +987,9 @@ public:
     const Token *classDef;   ///< class/struct/union/namespace token
     const Token *bodyStart;  ///< '{' token
     const Token *bodyEnd;    ///< '}' token
-    std::list<Function> functionList;
+    StableVector<Function> functionList;
     std::multimap<std::string, const Function *> functionMap;
-    std::list<Variable> varlist;
+    StableVector<Variable> varlist;
     const Scope *nestedIn;
     std::list<Scope *> nestedList;
     unsigned int numConstructors;
@@ -1085,6 +1088,16 @@ public:
         varlist.emplace_back(token_, start_, end_, varlist.size(),
                              access_,
                              type_, scope_, settings);
+        const Variable *var = &varlist.back();
+        if (mVariableMap.find(var->name()) == mVariableMap.end())
+            mVariableMap[var->name()] = var;
+    }
+
+    /** @brief add a scope that is nested in this scope */
+    void addNestedScope(Scope *scope) {
+        nestedList.push_back(scope);
+        if (scope->type != eFunction && mRecordMap.find(scope->className) == mRecordMap.end())
+            mRecordMap[scope->className] = scope;
     }
 
     /** @brief initialize varlist */
@@ -1133,6 +1146,12 @@ private:
     bool isVariableDeclaration(const Token* const tok, const Token*& vartok, const Token*& typetok) const;
 
     void findFunctionInBase(const std::string & name, size_t args, std::vector<const Function *> & matches) const;
+
+    /** first variable in varlist with each name */
+    std::unordered_map<std::string, const Variable *> mVariableMap;
+
+    /** first scope in nestedList with each name that is not a function */
+    std::unordered_map<std::string, Scope *> mRecordMap;
 };
 
 
@@ -1175,10 +1194,116 @@ public:
     }
 
     std::string str() const;
-    std::string dump() const;
+    /** Write the valueType-* attributes of a token to the dump */
+    void dump(DumpWriter &out) const;
 };
 
 
+/**
+ * @brief Sorted token positions where each variable is read and changed.
+ *
+ * The index is created once per symbol database, after the valuetypes are
+ * set. Asking if a variable is changed between two tokens is then a binary
+ * search instead of a walk over all tokens in between.
+ */
+class CPPCHECKLIB DefUseIndex {
+public:
+    DefUseIndex(const Token *tokens, unsigned int varIdCount, const Settings *settings, bool cpp);
+
+    /**
+     * Is variable changed in the code from start to end (end is not included)?
+     * Same result as a linear isVariableChanged() scan.
+     * @param start     first token
+     * @param end       end token, nullptr means end of token list
+     * @param varid     variable id
+     * @param globalvar variable is global, any function call changes it
+     * @param settings  settings that the caller use (nullptr or the settings used to create the index)
+     * @param cpp       c++ code
+     * @param changed   output: is variable changed
+     * @return false if the index can't answer the query and the tokens must be scanned
+     */
+    bool isChanged(const Token *start, const Token *end, unsigned int varid, bool globalvar, const Settings *settings, bool cpp, bool *changed) const;
+
+    /** Is variable read (used without being changed) in the code from start to end? Declarations are not reads. */
+    bool isRead(const Token *start, const Token *end, unsigned int varid) const;
+
+    /** Sorted token positions where variable is changed */
+    const std::vector<unsigned int> &writes(unsigned int varid) const;
+
+    /** Sorted token positions where variable is read */
+    const std::vector<unsigned int> &reads(unsigned int varid) const;
+
+private:
+    struct Positions {
+        std::vector<unsigned int> reads;
+        std::vector<unsigned int> writes;
+        /** writes when no settings are given (library is not used) */
+        std::vector<unsigned int> writesNoSettings;
+    };
+
+    bool getRange(const Token *start, const Token *end, unsigned int varid, unsigned int *startPos, unsigned int *endPos) const;
+
+    /** positions for each varid */
+    std::vector<Positions> mPositions;
+
+    /** position and varid of all "%name% (" tokens */
+    std::vector<std::pair<unsigned int, unsigned int> > mCalls;
+
+    const Settings *mSettings;
+    const bool mCpp;
+    static const std::vector<unsigned int> mEmptyPositions;
+};
+
+/**
+ * Basic block control flow graph of a function body.
+ * Block 0 is the entry block and block 1 is the (empty) exit block.
+ * Braces, "else", "case .. :" and labels are not part of any block.
+ * Calls of noreturn functions end their block like return does.
+ */
+class CPPCHECKLIB ControlFlowGraph {
+public:
+    struct BasicBlock {
+        BasicBlock() : start(nullptr), end(nullptr) {}
+
+        /** first token in block, nullptr if the block is empty */
+        const Token *start;
+        /** last token in block (inclusive) */
+        const Token *end;
+        std::vector<unsigned int> successors;
+        std::vector<unsigned int> predecessors;
+    };
+
+    ControlFlowGraph(const Scope *functionScope, const Library *library);
+
+    static const unsigned int ENTRY = 0;
+    static const unsigned int EXIT = 1;
+    static const unsigned int NONE = ~0U;
+
+    const std::vector<BasicBlock> &blocks() const {
+        return mBlocks;
+    }
+
+    /**
+     * Block that contains given token, NONE if the token is not in any block.
+     * Tokens created after the symbol database (Token::index() is 0) are not in any block.
+     */
+    unsigned int blockOf(const Token *tok) const;
+
+    /** Can the given block be reached from the entry block? */
+    bool isReachable(unsigned int block) const {
+        return block < mReachable.size() && mReachable[block];
+    }
+
+private:
+    class Builder;
+
+    std::vector<BasicBlock> mBlocks;
+    /** block of each token in the body, by Token::index() - mFirstIndex */
+    std::vector<unsigned int> mBlockOfIndex;
+    unsigned int mFirstIndex;
+    std::vector<bool> mReachable;
+};
+
 class CPPCHECKLIB SymbolDatabase {
     friend class TestSymbolDatabase;
 public:
@@ -1186,7 +1311,7 @@ public:
     ~SymbolDatabase();
 
     /** @brief Information about all namespaces/classes/structrues */
-    std::list<Scope> scopeList;
+    StableVector<Scope> scopeList;
 
     /** @brief Fast access to function scopes */
     std::vector<const Scope *> functionScopes;
@@ -1195,7 +1320,7 @@ public:
     std::vector<const Scope *> classAndStructScopes;
 
     /** @brief Fast access to types */
-    std::list<Type> typeList;
+    StableVector<Type> typeList;
 
     /**
      * @brief find a variable type if it's a user defined type
@@ -1240,6 +1365,10 @@ public:
     void printOut(const char * title = nullptr) const;
     void printVariable(const Variable *var, const char *indent) const;
     void printXml(std::ostream &out) const;
+    void dump(DumpWriter &out) const;
+
+    /** Estimate the memory used by the scopes, types, functions and variables. */
+    std::size_t memoryUsage() const;
 
     bool isCPP() const;
 
@@ -1254,9 +1383,27 @@ public:
      */
     void validateVariables() const;
 
-    /** Set valuetype in provided tokenlist */
+    /** Set valuetype in provided tokenlist and create the def/use index */
     void setValueTypeInTokenList();
 
+    /** Def/use index of variables, nullptr until setValueTypeInTokenList() is called */
+    const DefUseIndex *defUseIndex() const {
+        return mDefUseIndex;
+    }
+
+    /**
+     * Library function of a function call, resolved once by setValueTypeInTokenList().
+     * @return nullptr if the call was not resolved with given library
+     */
+    const Library::ResolvedCall *resolvedLibraryCall(const Token *ftok, const Library *library) const;
+
+    /**
+     * Control flow graph of a function scope. It is created when it is
+     * first requested and then shared by all checks.
+     * @return nullptr if scope is not a function or lambda scope
+     */
+    const ControlFlowGraph *controlFlowGraph(const Scope *scope) const;
+
     /**
      * Calculates sizeof value for given type.
      * @param type Token which will contain e.g. "int", "*", or string.
@@ -1286,6 +1433,7 @@ private:
     void createSymbolDatabaseUnknownArrayDimensions();
 
     void addClassFunction(Scope **scope, const Token **tok, const Token *argStart);
+    void addNestedRecord(Scope *scope, Scope *record);
     Function *addGlobalFunctionDecl(Scope*& scope, const Token* tok, const Token *argStart, const Token* funcStart);
     Function *addGlobalFunction(Scope*& scope, const Token*& tok, const Token *argStart, const Token* funcStart);
     void addNewFunction(Scope **scope, const Token **tok);
@@ -1317,7 +1465,19 @@ private:
     std::vector<const Variable *> mVariableList;
 
     /** list for missing types */
-    std::list<Type> mBlankTypes;
+    StableVector<Type> mBlankTypes;
+
+    /** named class, struct, union, namespace and enum scopes, in the order of scopeList */
+    std::unordered_map<std::string, std::vector<Scope *> > mRecordsByName;
+
+    /** def/use index of variables */
+    DefUseIndex *mDefUseIndex;
+
+    /** library functions of calls */
+    std::unordered_map<const Token *, Library::ResolvedCall> mResolvedLibraryCalls;
+
+    /** lazily created control flow graphs of function scopes */
+    mutable std::map<const Scope *, ControlFlowGraph *> mControlFlowGraphs;
 
     bool mIsCpp;
     ValueType::Sign mDefaultSignedness;
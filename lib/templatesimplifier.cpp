@@ -60,7 +60,7 @@ TemplateSimplifier::TokenAndName::TokenAndName(Token *tok, const std::string &s,
 }
 
 TemplateSimplifier::TemplateSimplifier(TokenList &tokenlist, const Settings *settings, ErrorLogger *errorLogger)
-    : mTokenList(tokenlist), mSettings(settings), mErrorLogger(errorLogger)
+    : mTokenList(tokenlist), mSettings(settings), mErrorLogger(errorLogger), mBytesPerToken(0)
 {
 }
 
@@ -1848,6 +1848,7 @@ bool TemplateSimplifier::simplifyTemplateInstantiations(
 #else
         (void)maxtime;
 #endif
+        checkMemoryLimit();
         assert(mTokenList.validateToken(tok2)); // that assertion fails on examples from #6021
 
         const Token *startToken = tok2;
@@ -1914,6 +1915,7 @@ bool TemplateSimplifier::simplifyTemplateInstantiations(
 #else
         (void)maxtime;
 #endif
+        checkMemoryLimit();
         assert(mTokenList.validateToken(tok2)); // that assertion fails on examples from #6021
 
         Token *startToken = tok2;
@@ -2147,6 +2149,7 @@ void TemplateSimplifier::simplifyTemplates(
     // Unfortunately the template simplifier doesn't handle namespaces properly so
     // the uninstantiated template code in the symbol database can't be removed until #8768
     // is fixed.
+    mBytesPerToken = 0;
     for (int i = 0; i < 2; ++i) {
         if (i) {
             mTemplateDeclarations.clear();
@@ -2252,3 +2255,14 @@ void TemplateSimplifier::syntaxError(const Token *tok)
 {
     throw InternalError(tok, "syntax error", InternalError::SYNTAX);
 }
+
+void TemplateSimplifier::checkMemoryLimit()
+{
+    if (!mSettings->maxMemoryPerFile)
+        return;
+    // the instantiated tokens are copies of template tokens, their strings are of similar size
+    if (mBytesPerToken == 0 && mTokenList.size() > 0)
+        mBytesPerToken = mTokenList.memoryUsage() / mTokenList.size();
+    if (mTokenList.size() * mBytesPerToken > mSettings->maxMemoryPerFile)
+        throw InternalError(nullptr, "The instantiated templates need more memory than --max-memory-per-file allows.", InternalError::LIMIT);
+}
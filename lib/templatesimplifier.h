@@ -24,6 +24,7 @@
 
 #include "config.h"
 
+#include <cstddef>
 #include <ctime>
 #include <list>
 #include <map>
@@ -230,6 +231,12 @@ private:
     /** Syntax error */
     static void syntaxError(const Token *tok);
 
+    /**
+     * Bail out when the instantiated templates use more memory than --max-memory-per-file allows.
+     * The memory used per token is measured the first time, the tokens are counted after that.
+     */
+    void checkMemoryLimit();
+
     static bool matchSpecialization(
         const Token *templateDeclarationNameToken,
         const Token *templateInstantiationNameToken,
@@ -270,6 +277,9 @@ private:
     std::list<TokenAndName> mInstantiatedTemplates;
     std::list<TokenAndName> mMemberFunctionsToDelete;
     std::vector<Token *> mTypesUsedInTemplateInstantiation;
+
+    /** Memory used per token, see checkMemoryLimit(). 0 if not measured yet. */
+    std::size_t mBytesPerToken;
 };
 
 /// @}
@@ -63,6 +63,9 @@ void TimerResults::ShowResults(SHOWTIME_MODES mode) const
 
     const double secOverall = overallData.seconds();
     std::cout << "Overall time: " << secOverall << "s" << std::endl;
+
+    for (std::map<std::string, unsigned long>::const_iterator iter = mCounts.begin(); iter != mCounts.end(); ++iter)
+        std::cout << iter->first << ": " << iter->second << std::endl;
 }
 
 void TimerResults::AddResults(const std::string& str, std::clock_t clocks)
@@ -71,6 +74,11 @@ void TimerResults::AddResults(const std::string& str, std::clock_t clocks)
     mResults[str].mNumberOfResults++;
 }
 
+void TimerResults::AddCount(const std::string& str, unsigned long count)
+{
+    mCounts[str] += count;
+}
+
 Timer::Timer(const std::string& str, unsigned int showtimeMode, TimerResultsIntf* timerResults)
     : mStr(str)
     , mTimerResults(timerResults)
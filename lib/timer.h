@@ -38,6 +38,7 @@ public:
     virtual ~TimerResultsIntf() { }
 
     virtual void AddResults(const std::string& str, std::clock_t clocks) = 0;
+    virtual void AddCount(const std::string& str, unsigned long count) = 0;
 };
 
 struct TimerResultsData {
@@ -62,9 +63,11 @@ public:
 
     void ShowResults(SHOWTIME_MODES mode) const;
     virtual void AddResults(const std::string& str, std::clock_t clocks) override;
+    virtual void AddCount(const std::string& str, unsigned long count) override;
 
 private:
     std::map<std::string, struct TimerResultsData> mResults;
+    std::map<std::string, unsigned long> mCounts;
 };
 
 class CPPCHECKLIB Timer {
@@ -18,6 +18,8 @@
 
 #include "token.h"
 
+#include "counters.h"
+#include "dumpwriter.h"
 #include "errorlogger.h"
 #include "library.h"
 #include "settings.h"
@@ -33,34 +35,39 @@
 #include <stack>
 #include <utility>
 
-const std::list<ValueFlow::Value> Token::mEmptyValueList;
+const ValueFlow::ValueList Token::mEmptyValueList;
 
 Token::Token(TokensFrontBack *tokensFrontBack) :
-    mTokensFrontBack(tokensFrontBack),
     mNext(nullptr),
     mPrevious(nullptr),
-    mLink(nullptr),
-    mScope(nullptr),
-    mFunction(nullptr), // Initialize whole union
     mVarId(0),
-    mFileIndex(0),
-    mLineNumber(0),
-    mColumn(0),
-    mProgressValue(0),
     mTokType(eNone),
     mFlags(0),
     mBits(0),
+    mProgressValue(0),
+    mLink(nullptr),
     mAstOperand1(nullptr),
     mAstOperand2(nullptr),
     mAstParent(nullptr),
+    mScope(nullptr),
+    mFunction(nullptr), // Initialize whole union
+    mValues(nullptr),
+    mLineNumber(0),
+    mIndex(0),
+    mTokensFrontBack(tokensFrontBack),
+    mFileIndex(0),
+    mColumn(0),
     mOriginalName(nullptr),
-    mValueType(nullptr),
-    mValues(nullptr)
+    mValueType(nullptr)
 {
+    if (mTokensFrontBack)
+        ++mTokensFrontBack->size;
 }
 
 Token::~Token()
 {
+    if (mTokensFrontBack)
+        --mTokensFrontBack->size;
     delete mOriginalName;
     delete mValueType;
     delete mValues;
@@ -567,6 +574,8 @@ int Token::multiCompare(const Token *tok, const char *haystack, unsigned int var
 
 bool Token::simpleMatch(const Token *tok, const char pattern[])
 {
+    COUNTER_LITERAL("Token::simpleMatch", pattern);
+    COUNTER_CALLSITE("Token::simpleMatch callers");
     if (!tok)
         return false; // shortcut
     const char *current  = pattern;
@@ -622,6 +631,8 @@ const char *Token::chrInFirstWord(const char *str, char c)
 
 bool Token::Match(const Token *tok, const char pattern[], unsigned int varid)
 {
+    COUNTER_LITERAL("Token::Match", pattern);
+    COUNTER_CALLSITE("Token::Match callers");
     const char *p = pattern;
     while (*p) {
         // Skip spaces in pattern..
@@ -1389,104 +1400,108 @@ std::string Token::astStringVerbose(const unsigned int indent1, const unsigned i
 
 void Token::printValueFlow(bool xml, std::ostream &out) const
 {
+    if (xml) {
+        XmlDumpWriter writer(out, 1);
+        dumpValueFlow(writer);
+        return;
+    }
     unsigned int line = 0;
-    if (xml)
-        out << "  <valueflow>" << std::endl;
-    else
-        out << "\n\n##Value flow" << std::endl;
+    out << "\n\n##Value flow" << std::endl;
     for (const Token *tok = this; tok; tok = tok->next()) {
         if (!tok->mValues)
             continue;
-        if (xml)
-            out << "    <values id=\"" << tok->mValues << "\">" << std::endl;
-        else if (line != tok->linenr())
+        if (line != tok->linenr())
             out << "Line " << tok->linenr() << std::endl;
         line = tok->linenr();
-        if (!xml) {
-            out << "  " << tok->str() << (tok->mValues->front().isKnown() ? " always " : " possible ");
-            if (tok->mValues->size() > 1U)
-                out << '{';
-        }
+        out << "  " << tok->str() << (tok->mValues->front().isKnown() ? " always " : " possible ");
+        if (tok->mValues->size() > 1U)
+            out << '{';
         for (const ValueFlow::Value &value : *tok->mValues) {
-            if (xml) {
-                out << "      <value ";
-                switch (value.valueType) {
-                case ValueFlow::Value::INT:
-                    if (tok->valueType() && tok->valueType()->sign == ValueType::UNSIGNED)
-                        out << "intvalue=\"" << (MathLib::biguint)value.intvalue << '\"';
-                    else
-                        out << "intvalue=\"" << value.intvalue << '\"';
-                    break;
-                case ValueFlow::Value::TOK:
-                    out << "tokvalue=\"" << value.tokvalue << '\"';
-                    break;
-                case ValueFlow::Value::FLOAT:
-                    out << "floatvalue=\"" << value.floatValue << '\"';
-                    break;
-                case ValueFlow::Value::MOVED:
-                    out << "movedvalue=\"" << ValueFlow::Value::toString(value.moveKind) << '\"';
-                    break;
-                case ValueFlow::Value::UNINIT:
-                    out << "uninit=\"1\"";
-                    break;
-                case ValueFlow::Value::CONTAINER_SIZE:
-                    out << "container-size=\"" << value.intvalue << '\"';
-                    break;
-                case ValueFlow::Value::LIFETIME:
-                    out << "lifetime=\"" << value.tokvalue << '\"';
-                    break;
-                }
-                if (value.condition)
-                    out << " condition-line=\"" << value.condition->linenr() << '\"';
-                if (value.isKnown())
-                    out << " known=\"true\"";
-                else if (value.isPossible())
-                    out << " possible=\"true\"";
-                else if (value.isInconclusive())
-                    out << " inconclusive=\"true\"";
-                out << "/>" << std::endl;
-            }
-
-            else {
-                if (&value != &tok->mValues->front())
-                    out << ",";
-                switch (value.valueType) {
-                case ValueFlow::Value::INT:
-                    if (tok->valueType() && tok->valueType()->sign == ValueType::UNSIGNED)
-                        out << (MathLib::biguint)value.intvalue;
-                    else
-                        out << value.intvalue;
-                    break;
-                case ValueFlow::Value::TOK:
-                    out << value.tokvalue->str();
-                    break;
-                case ValueFlow::Value::FLOAT:
-                    out << value.floatValue;
-                    break;
-                case ValueFlow::Value::MOVED:
-                    out << ValueFlow::Value::toString(value.moveKind);
-                    break;
-                case ValueFlow::Value::UNINIT:
-                    out << "Uninit";
-                    break;
-                case ValueFlow::Value::CONTAINER_SIZE:
-                    out << "size=" << value.intvalue;
-                    break;
-                case ValueFlow::Value::LIFETIME:
-                    out << "lifetime=" << value.tokvalue->str();
-                    break;
-                }
+            if (&value != &tok->mValues->front())
+                out << ",";
+            switch (value.valueType) {
+            case ValueFlow::Value::INT:
+                if (tok->valueType() && tok->valueType()->sign == ValueType::UNSIGNED)
+                    out << (MathLib::biguint)value.intvalue;
+                else
+                    out << value.intvalue;
+                break;
+            case ValueFlow::Value::TOK:
+                out << value.tokvalue->str();
+                break;
+            case ValueFlow::Value::FLOAT:
+                out << value.floatValue;
+                break;
+            case ValueFlow::Value::MOVED:
+                out << ValueFlow::Value::toString(value.moveKind);
+                break;
+            case ValueFlow::Value::UNINIT:
+                out << "Uninit";
+                break;
+            case ValueFlow::Value::CONTAINER_SIZE:
+                out << "size=" << value.intvalue;
+                break;
+            case ValueFlow::Value::LIFETIME:
+                out << "lifetime=" << value.tokvalue->str();
+                break;
             }
         }
-        if (xml)
-            out << "    </values>" << std::endl;
-        else if (tok->mValues->size() > 1U)
+        if (tok->mValues->size() > 1U)
             out << '}' << std::endl;
         else
             out << std::endl;
     }
-    if (xml)
-        out << "  </valueflow>" << std::endl;
+}
+
+void Token::dumpValueFlow(DumpWriter &out) const
+{
+    out.startElement("valueflow");
+    for (const Token *tok = this; tok; tok = tok->next()) {
+        if (!tok->mValues)
+            continue;
+        out.startElement("values");
+        out.attribute("id", tok->mValues);
+        for (const ValueFlow::Value &value : *tok->mValues) {
+            out.startElement("value");
+            switch (value.valueType) {
+            case ValueFlow::Value::INT:
+                if (tok->valueType() && tok->valueType()->sign == ValueType::UNSIGNED)
+                    out.attribute("intvalue", (MathLib::biguint)value.intvalue);
+                else
+                    out.attribute("intvalue", value.intvalue);
+                break;
+            case ValueFlow::Value::TOK:
+                out.attribute("tokvalue", value.tokvalue);
+                break;
+            case ValueFlow::Value::FLOAT:
+                out.attribute("floatvalue", value.floatValue);
+                break;
+            case ValueFlow::Value::MOVED:
+                out.attribute("movedvalue", ValueFlow::Value::toString(value.moveKind));
+                break;
+            case ValueFlow::Value::UNINIT:
+                out.attribute("uninit", 1);
+                break;
+            case ValueFlow::Value::CONTAINER_SIZE:
+                out.attribute("container-size", value.intvalue);
+                break;
+            case ValueFlow::Value::LIFETIME:
+                out.attribute("lifetime", value.tokvalue);
+                break;
+            }
+            if (value.condition)
+                out.attribute("condition-line", value.condition->linenr());
+            if (value.isKnown())
+                out.attribute("known", true);
+            else if (value.isPossible())
+                out.attribute("possible", true);
+            else if (value.isInconclusive())
+                out.attribute("inconclusive", true);
+            out.endElement();
+        }
+        out.endElement();
+    }
+    out.endElement();
 }
 
 const ValueFlow::Value * Token::getValueLE(const MathLib::bigint val, const Settings *settings) const
@@ -1494,7 +1509,7 @@ const ValueFlow::Value * Token::getValueLE(const MathLib::bigint val, const Sett
     if (!mValues)
         return nullptr;
     const ValueFlow::Value *ret = nullptr;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = mValues->begin(); it != mValues->end(); ++it) {
         if (it->isIntValue() && it->intvalue <= val) {
             if (!ret || ret->isInconclusive() || (ret->condition && !it->isInconclusive()))
@@ -1517,7 +1532,7 @@ const ValueFlow::Value * Token::getValueGE(const MathLib::bigint val, const Sett
     if (!mValues)
         return nullptr;
     const ValueFlow::Value *ret = nullptr;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = mValues->begin(); it != mValues->end(); ++it) {
         if (it->isIntValue() && it->intvalue >= val) {
             if (!ret || ret->isInconclusive() || (ret->condition && !it->isInconclusive()))
@@ -1540,7 +1555,7 @@ const ValueFlow::Value * Token::getInvalidValue(const Token *ftok, unsigned int
     if (!mValues || !settings)
         return nullptr;
     const ValueFlow::Value *ret = nullptr;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = mValues->begin(); it != mValues->end(); ++it) {
         if ((it->isIntValue() && !settings->library.isIntArgValid(ftok, argnr, it->intvalue)) ||
             (it->isFloatValue() && !settings->library.isFloatArgValid(ftok, argnr, it->floatValue))) {
@@ -1565,7 +1580,7 @@ const Token *Token::getValueTokenMinStrSize() const
         return nullptr;
     const Token *ret = nullptr;
     std::size_t minsize = ~0U;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = mValues->begin(); it != mValues->end(); ++it) {
         if (it->isTokValue() && it->tokvalue && it->tokvalue->tokType() == Token::eString) {
             const std::size_t size = getStrSize(it->tokvalue);
@@ -1584,7 +1599,7 @@ const Token *Token::getValueTokenMaxStrLength() const
         return nullptr;
     const Token *ret = nullptr;
     std::size_t maxlength = 0U;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = mValues->begin(); it != mValues->end(); ++it) {
         if (it->isTokValue() && it->tokvalue && it->tokvalue->tokType() == Token::eString) {
             const std::size_t length = getStrLength(it->tokvalue);
@@ -1608,7 +1623,7 @@ const Token *Token::getValueTokenDeadPointer() const
 {
     const Scope * const functionscope = getfunctionscope(this->scope());
 
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::ValueList::const_iterator it;
     for (it = values().begin(); it != values().end(); ++it) {
         // Is this a pointer alias?
         if (!it->isTokValue() || (it->tokvalue && it->tokvalue->str() != "&"))
@@ -1653,7 +1668,7 @@ bool Token::addValue(const ValueFlow::Value &value)
             return false;
 
         // if value already exists, don't add it again
-        std::list<ValueFlow::Value>::iterator it;
+        ValueFlow::ValueList::iterator it;
         for (it = mValues->begin(); it != mValues->end(); ++it) {
             // different intvalue => continue
             if (it->intvalue != value.intvalue)
@@ -1683,7 +1698,7 @@ bool Token::addValue(const ValueFlow::Value &value)
             if (v.varId == 0)
                 v.varId = mVarId;
             if (v.isKnown() && v.isIntValue())
-                mValues->push_front(v);
+                mValues->insert(mValues->begin(), v);
             else
                 mValues->push_back(v);
         }
@@ -1691,7 +1706,7 @@ bool Token::addValue(const ValueFlow::Value &value)
         ValueFlow::Value v(value);
         if (v.varId == 0)
             v.varId = mVarId;
-        mValues = new std::list<ValueFlow::Value>(1, v);
+        mValues = new ValueFlow::ValueList(1, v);
     }
 
     return true;
@@ -1704,7 +1719,14 @@ void Token::assignProgressValues(Token *tok)
         ++total_count;
     unsigned int count = 0;
     for (Token *tok2 = tok; tok2; tok2 = tok2->next())
-        tok2->mProgressValue = count++ * 100 / total_count;
+        tok2->mProgressValue = static_cast<unsigned char>(count++ * 100 / total_count);
+}
+
+void Token::assignIndexes(Token *tok)
+{
+    unsigned int index = 0;
+    for (Token *tok2 = tok; tok2; tok2 = tok2->next())
+        tok2->mIndex = ++index;
 }
 
 void Token::setValueType(ValueType *vt)
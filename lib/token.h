@@ -33,6 +33,7 @@
 #include <string>
 #include <vector>
 
+class DumpWriter;
 class Enumerator;
 class Function;
 class Scope;
@@ -47,6 +48,8 @@ class Variable;
 struct TokensFrontBack {
     Token *front;
     Token *back;
+    /** number of tokens that are allocated for the list */
+    std::size_t size;
 };
 
 /// @addtogroup Core
@@ -64,8 +67,6 @@ struct TokensFrontBack {
  */
 class CPPCHECKLIB Token {
 private:
-    TokensFrontBack* mTokensFrontBack;
-
     // Not implemented..
     Token(const Token &);
     Token operator=(const Token &);
@@ -791,6 +792,17 @@ public:
     /** Calculate progress values for all tokens */
     static void assignProgressValues(Token *tok);
 
+    /**
+     * Get position of token in token list. Assigned by assignIndexes(),
+     * tokens created afterwards have index 0.
+     */
+    unsigned int index() const {
+        return mIndex;
+    }
+
+    /** Assign increasing positions (starting at 1) to all tokens */
+    static void assignIndexes(Token *tok);
+
     /**
      * @return the first token of the next argument. Does only work on argument
      * lists. Requires that Tokenizer::createLinks2() has been called before.
@@ -830,7 +842,7 @@ public:
         return mOriginalName ? *mOriginalName : emptyString;
     }
 
-    const std::list<ValueFlow::Value>& values() const {
+    const ValueFlow::ValueList& values() const {
         return mValues ? *mValues : mEmptyValueList;
     }
 
@@ -936,31 +948,21 @@ private:
      */
     static const char *chrInFirstWord(const char *str, char c);
 
-    std::string mStr;
+    /*
+     * The members are ordered by how often they are read. The members
+     * that Token::Match() and the walks over the token list read come
+     * first and fit in 64 bytes, then the links to other tokens and the
+     * symbol database, then the members that are only read when an
+     * error is reported or the dump is written. Walks over the token list
+     * are limited by memory reads, so keep the Token small.
+     */
 
     Token *mNext;
     Token *mPrevious;
-    Token *mLink;
 
-    // symbol database information
-    const Scope *mScope;
-    union {
-        const Function *mFunction;
-        const Variable *mVariable;
-        const ::Type* mType;
-        const Enumerator *mEnumerator;
-    };
+    std::string mStr;
 
     unsigned int mVarId;
-    unsigned int mFileIndex;
-    unsigned int mLineNumber;
-    unsigned int mColumn;
-
-    /**
-     * A value from 0-100 that provides a rough idea about where in the token
-     * list this token is located.
-     */
-    unsigned int mProgressValue;
 
     Token::Type mTokType;
 
@@ -1023,20 +1025,49 @@ private:
     /** Bitfield bit count. */
     unsigned char mBits;
 
+    /**
+     * A value from 0-100 that provides a rough idea about where in the token
+     * list this token is located. It is rarely read but fits in the padding
+     * after mBits.
+     */
+    unsigned char mProgressValue;
+
+    Token *mLink;
+
     // AST..
     Token *mAstOperand1;
     Token *mAstOperand2;
     Token *mAstParent;
 
+    // symbol database information
+    const Scope *mScope;
+    union {
+        const Function *mFunction;
+        const Variable *mVariable;
+        const ::Type* mType;
+        const Enumerator *mEnumerator;
+    };
+
+    // ValueFlow
+    ValueFlow::ValueList* mValues;
+
+    unsigned int mLineNumber;
+
+    /** Position of token in token list, see assignIndexes() */
+    unsigned int mIndex;
+
+    TokensFrontBack* mTokensFrontBack;
+
+    unsigned int mFileIndex;
+    unsigned int mColumn;
+
     // original name like size_t
     std::string* mOriginalName;
 
     // ValueType
     ValueType *mValueType;
 
-    // ValueFlow
-    std::list<ValueFlow::Value>* mValues;
-    static const std::list<ValueFlow::Value> mEmptyValueList;
+    static const ValueFlow::ValueList mEmptyValueList;
 
 public:
     void astOperand1(Token *tok);
@@ -1094,6 +1125,9 @@ public:
     void printAst(bool verbose, bool xml, std::ostream &out) const;
 
     void printValueFlow(bool xml, std::ostream &out) const;
+
+    /** Write the values of this token and the following tokens to the dump */
+    void dumpValueFlow(DumpWriter &out) const;
 };
 
 /// @}
@@ -20,6 +20,7 @@
 #include "tokenize.h"
 
 #include "check.h"
+#include "dumpwriter.h"
 #include "library.h"
 #include "mathlib.h"
 #include "path.h"
@@ -147,7 +148,10 @@ Tokenizer::Tokenizer() :
     mVarId(0),
     mUnnamedCount(0),
     mCodeWithTemplates(false), //is there any templates?
-    mTimerResults(nullptr)
+    mTimerResults(nullptr),
+    mDeadline(0),
+    mValueFlowTimeout(false),
+    mValueFlowBudgetExceeded(false)
 #ifdef MAXTIME
     ,mMaxTime(std::time(0) + MAXTIME)
 #endif
@@ -163,7 +167,10 @@ Tokenizer::Tokenizer(const Settings *settings, ErrorLogger *errorLogger) :
     mVarId(0),
     mUnnamedCount(0),
     mCodeWithTemplates(false), //is there any templates?
-    mTimerResults(nullptr)
+    mTimerResults(nullptr),
+    mDeadline(0),
+    mValueFlowTimeout(false),
+    mValueFlowBudgetExceeded(false)
 #ifdef MAXTIME
     ,mMaxTime(std::time(0) + MAXTIME)
 #endif
@@ -1768,7 +1775,11 @@ bool Tokenizer::simplifyTokens1(const std::string &configuration)
     }
 
     mSymbolDatabase->setValueTypeInTokenList();
-    ValueFlow::setValues(&list, mSymbolDatabase, mErrorLogger, mSettings);
+    const ValueFlow::SetValuesResult valueFlowResult = ValueFlow::setValues(&list, mSymbolDatabase, mErrorLogger, mSettings, mDeadline, mTimerResults);
+    if (valueFlowResult == ValueFlow::TIMEOUT_REACHED)
+        mValueFlowTimeout = true;
+    else if (valueFlowResult == ValueFlow::BUDGET_EXCEEDED)
+        mValueFlowBudgetExceeded = true;
 
     printDebugOutput(1);
 
@@ -4076,7 +4087,11 @@ bool Tokenizer::simplifyTokenList2()
     createSymbolDatabase();
     mSymbolDatabase->setValueTypeInTokenList();
 
-    ValueFlow::setValues(&list, mSymbolDatabase, mErrorLogger, mSettings);
+    const ValueFlow::SetValuesResult valueFlowResult = ValueFlow::setValues(&list, mSymbolDatabase, mErrorLogger, mSettings, mDeadline, mTimerResults);
+    if (valueFlowResult == ValueFlow::TIMEOUT_REACHED)
+        mValueFlowTimeout = true;
+    else if (valueFlowResult == ValueFlow::BUDGET_EXCEEDED)
+        mValueFlowBudgetExceeded = true;
 
     if (mSettings->terminated())
         return false;
@@ -4139,77 +4154,84 @@ void Tokenizer::printDebugOutput(unsigned int simplification) const
 
 void Tokenizer::dump(std::ostream &out) const
 {
-    // Create a xml data dump.
+    XmlDumpWriter writer(out, 1);
+    dump(writer);
+}
+
+void Tokenizer::dump(DumpWriter &out) const
+{
+    // Create a data dump.
     // The idea is not that this will be readable for humans. It's a
     // data dump that 3rd party tools could load and get useful info from.
 
     // tokens..
-    out << "  <tokenlist>" << std::endl;
+    out.startElement("tokenlist");
     for (const Token *tok = list.front(); tok; tok = tok->next()) {
-        out << "    <token id=\"" << tok << "\" file=\"" << ErrorLogger::toxml(list.file(tok)) << "\" linenr=\"" << tok->linenr() << '\"';
-        out << " str=\"" << ErrorLogger::toxml(tok->str()) << '\"';
-        out << " scope=\"" << tok->scope() << '\"';
+        out.startElement("token");
+        out.attribute("id", tok);
+        out.attribute("file", list.file(tok));
+        out.attribute("linenr", tok->linenr());
+        out.attribute("str", tok->str());
+        out.attribute("scope", tok->scope());
         if (tok->isName()) {
-            out << " type=\"name\"";
+            out.attribute("type", "name");
             if (tok->isUnsigned())
-                out << " isUnsigned=\"true\"";
+                out.attribute("isUnsigned", true);
             else if (tok->isSigned())
-                out << " isSigned=\"true\"";
+                out.attribute("isSigned", true);
         } else if (tok->isNumber()) {
-            out << " type=\"number\"";
+            out.attribute("type", "number");
             if (MathLib::isInt(tok->str()))
-                out << " isInt=\"True\"";
+                out.attribute("isInt", "True");
             if (MathLib::isFloat(tok->str()))
-                out << " isFloat=\"True\"";
-        } else if (tok->tokType() == Token::eString)
-            out << " type=\"string\" strlen=\"" << Token::getStrLength(tok) << '\"';
-        else if (tok->tokType() == Token::eChar)
-            out << " type=\"char\"";
+                out.attribute("isFloat", "True");
+        } else if (tok->tokType() == Token::eString) {
+            out.attribute("type", "string");
+            out.attribute("strlen", Token::getStrLength(tok));
+        } else if (tok->tokType() == Token::eChar)
+            out.attribute("type", "char");
         else if (tok->isBoolean())
-            out << " type=\"boolean\"";
+            out.attribute("type", "boolean");
         else if (tok->isOp()) {
-            out << " type=\"op\"";
+            out.attribute("type", "op");
             if (tok->isArithmeticalOp())
-                out << " isArithmeticalOp=\"True\"";
+                out.attribute("isArithmeticalOp", "True");
             else if (tok->isAssignmentOp())
-                out << " isAssignmentOp=\"True\"";
+                out.attribute("isAssignmentOp", "True");
             else if (tok->isComparisonOp())
-                out << " isComparisonOp=\"True\"";
+                out.attribute("isComparisonOp", "True");
             else if (tok->tokType() == Token::eLogicalOp)
-                out << " isLogicalOp=\"True\"";
+                out.attribute("isLogicalOp", "True");
         }
         if (tok->link())
-            out << " link=\"" << tok->link() << '\"';
+            out.attribute("link", tok->link());
         if (tok->varId() > 0U)
-            out << " varId=\"" << MathLib::toString(tok->varId()) << '\"';
+            out.attribute("varId", tok->varId());
         if (tok->variable())
-            out << " variable=\"" << tok->variable() << '\"';
+            out.attribute("variable", tok->variable());
         if (tok->function())
-            out << " function=\"" << tok->function() << '\"';
+            out.attribute("function", tok->function());
         if (!tok->values().empty())
-            out << " values=\"" << &tok->values() << '\"';
+            out.attribute("values", &tok->values());
         if (tok->type())
-            out << " type-scope=\"" << tok->type()->classScope << '\"';
+            out.attribute("type-scope", tok->type()->classScope);
         if (tok->astParent())
-            out << " astParent=\"" << tok->astParent() << '\"';
+            out.attribute("astParent", tok->astParent());
         if (tok->astOperand1())
-            out << " astOperand1=\"" << tok->astOperand1() << '\"';
+            out.attribute("astOperand1", tok->astOperand1());
         if (tok->astOperand2())
-            out << " astOperand2=\"" << tok->astOperand2() << '\"';
+            out.attribute("astOperand2", tok->astOperand2());
         if (!tok->originalName().empty())
-            out << " originalName=\"" << tok->originalName() << '\"';
-        if (tok->valueType()) {
-            const std::string vt = tok->valueType()->dump();
-            if (!vt.empty())
-                out << ' ' << vt;
-        }
-        out << "/>" << std::endl;
+            out.rawAttribute("originalName", tok->originalName());
+        if (tok->valueType())
+            tok->valueType()->dump(out);
+        out.endElement();
     }
-    out << "  </tokenlist>" << std::endl;
+    out.endElement();
 
-    mSymbolDatabase->printXml(out);
+    mSymbolDatabase->dump(out);
     if (list.front())
-        list.front()->printValueFlow(true, out);
+        list.front()->dumpValueFlow(out);
 }
 
 void Tokenizer::removeMacrosInGlobalScope()
@@ -9836,6 +9858,38 @@ void Tokenizer::deleteSymbolDatabase()
     mSymbolDatabase = nullptr;
 }
 
+std::size_t Tokenizer::estimateCost() const
+{
+    // ValueFlow and the checks do work for each function, and template
+    // instantiations are often large and deeply nested
+    const std::size_t functionCost = 50;
+    const std::size_t templateCost = 200;
+
+    std::size_t cost = 0;
+    for (const Token *tok = list.front(); tok; tok = tok->next())
+        ++cost;
+    if (!mSymbolDatabase)
+        return cost;
+    for (const Scope *scope : mSymbolDatabase->functionScopes) {
+        cost += functionCost;
+        if (scope->className.find('<') != std::string::npos)
+            cost += templateCost;
+    }
+    for (const Scope *scope : mSymbolDatabase->classAndStructScopes) {
+        if (scope->className.find('<') != std::string::npos)
+            cost += templateCost;
+    }
+    return cost;
+}
+
+std::size_t Tokenizer::memoryUsage() const
+{
+    std::size_t bytes = list.memoryUsage() + ValueFlow::memoryUsage(&list);
+    if (mSymbolDatabase)
+        bytes += mSymbolDatabase->memoryUsage();
+    return bytes;
+}
+
 static bool operatorEnd(const Token * tok)
 {
     if (tok && tok->str() == ")") {
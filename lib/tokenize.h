@@ -31,6 +31,7 @@
 #include <string>
 #include <stack>
 
+class DumpWriter;
 class Settings;
 class SymbolDatabase;
 class TimerResults;
@@ -88,6 +89,24 @@ public:
         mTimerResults = tr;
     }
 
+    /**
+     * Stop repeating the ValueFlow analysis when this time is reached.
+     * @param deadline the deadline, 0 if there is no deadline
+     */
+    void setDeadline(std::time_t deadline) {
+        mDeadline = deadline;
+    }
+
+    /** Was the ValueFlow analysis stopped before all values were found? */
+    bool isValueFlowIncomplete() const {
+        return mValueFlowTimeout || mValueFlowBudgetExceeded;
+    }
+
+    /** Was the ValueFlow analysis stopped by the time or memory budget of the file? */
+    bool isValueFlowBudgetExceeded() const {
+        return mValueFlowBudgetExceeded;
+    }
+
     /** Is the code C. Used for bailouts */
     bool isC() const {
         return list.isC();
@@ -788,6 +807,19 @@ public:
     void createSymbolDatabase();
     void deleteSymbolDatabase();
 
+    /**
+     * Rough estimate of how expensive it is to check the token list. It
+     * is the number of tokens plus a weight for each function scope and
+     * each template instantiation. Call it after simplifyTokens1().
+     */
+    std::size_t estimateCost() const;
+
+    /**
+     * Estimate the memory used by the tokens, their ValueFlow values and
+     * the symbol database.
+     */
+    std::size_t memoryUsage() const;
+
     /** print --debug output if debug flags match the simplification:
      * 0=unknown/both simplifications
      * 1=1st simplifications
@@ -796,6 +828,7 @@ public:
     void printDebugOutput(unsigned int simplification) const;
 
     void dump(std::ostream &out) const;
+    void dump(DumpWriter &out) const;
 
     Token *deleteInvalidTypedef(Token *typeDef);
 
@@ -909,6 +942,15 @@ private:
      */
     TimerResults *mTimerResults;
 
+    /** ValueFlow deadline, 0 if there is none */
+    std::time_t mDeadline;
+
+    /** Was the ValueFlow analysis stopped by its built-in time limit? */
+    bool mValueFlowTimeout;
+
+    /** Was the ValueFlow analysis stopped by the budget of the file? */
+    bool mValueFlowBudgetExceeded;
+
 #ifdef MAXTIME
     /** Tokenizer maxtime */
     const std::time_t mMaxTime;
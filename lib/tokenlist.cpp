@@ -23,6 +23,7 @@
 #include "mathlib.h"
 #include "path.h"
 #include "settings.h"
+#include "symboldatabase.h"
 #include "token.h"
 
 #include <simplecpp.h>
@@ -40,6 +41,7 @@ static const unsigned int AST_MAX_DEPTH = 50U;
 TokenList::TokenList(const Settings* settings) :
     mTokensFrontBack(),
     mSettings(settings),
+    mValueFlowStatistics(),
     mIsC(false),
     mIsCpp(false)
 {
@@ -330,6 +332,19 @@ void TokenList::createTokens(const simplecpp::TokenList *tokenList)
 
 //---------------------------------------------------------------------------
 
+std::size_t TokenList::memoryUsage() const
+{
+    std::size_t bytes = 0;
+    for (const Token* tok = front(); tok; tok = tok->next()) {
+        bytes += sizeof(Token) + tok->str().capacity();
+        if (!tok->originalName().empty())
+            bytes += sizeof(std::string) + tok->originalName().capacity();
+        if (tok->valueType())
+            bytes += sizeof(ValueType) + tok->valueType()->originalTypeName.capacity();
+    }
+    return bytes;
+}
+
 unsigned long long TokenList::calculateChecksum() const
 {
     unsigned long long checksum = 0;
@@ -24,6 +24,7 @@
 #include "config.h"
 #include "token.h"
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -150,6 +151,19 @@ public:
     */
     unsigned long long calculateChecksum() const;
 
+    /** Number of tokens in the list. */
+    std::size_t size() const {
+        return mTokensFrontBack.size;
+    }
+
+    /** Estimate the memory used by the tokens, without their ValueFlow values. */
+    std::size_t memoryUsage() const;
+
+    /** ValueFlow budget statistics of this token list, written by ValueFlow::setValues(). */
+    ValueFlow::BudgetStatistics &valueFlowStatistics() {
+        return mValueFlowStatistics;
+    }
+
     /**
      * Create abstract syntax tree.
      */
@@ -195,6 +209,9 @@ private:
     /** settings */
     const Settings* mSettings;
 
+    /** ValueFlow budget statistics */
+    ValueFlow::BudgetStatistics mValueFlowStatistics;
+
     /** File is known to be C/C++ code */
     bool mIsC, mIsCpp;
 };
@@ -0,0 +1,83 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tokenpatterntable.h"
+
+#include "token.h"
+
+#include <algorithm>
+
+const std::size_t TokenPatternTable::npos;
+
+std::size_t TokenPatternTable::add(const std::string &pattern)
+{
+    const std::size_t index = mPatterns.size();
+    mPatterns.push_back(pattern);
+
+    const std::string::size_type begin = pattern.find_first_not_of(' ');
+    const std::string first = (begin == std::string::npos) ? std::string() : pattern.substr(begin, pattern.find(' ', begin) - begin);
+
+    // Split "a|b|c" into its alternatives. An empty alternative, a %cmd%,
+    // "!!else" or a "[abc]" character set can match other tokens.
+    std::vector<std::string> alternatives;
+    bool any = first.empty() || first[0] == '!' || (first[0] == '[' && first.size() > 1);
+    std::string::size_type pos = 0;
+    while (!any) {
+        const std::string::size_type end = first.find('|', pos);
+        const std::string alternative = first.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        if (alternative.empty() || alternative.find('%') != std::string::npos)
+            any = true;
+        else if (std::find(alternatives.begin(), alternatives.end(), alternative) == alternatives.end())
+            alternatives.push_back(alternative);
+        if (end == std::string::npos)
+            break;
+        pos = end + 1;
+    }
+
+    if (any)
+        mAnyFirstToken.push_back(index);
+    else {
+        for (std::size_t i = 0; i < alternatives.size(); ++i)
+            mByFirstToken[alternatives[i]].push_back(index);
+    }
+    return index;
+}
+
+std::size_t TokenPatternTable::findMatch(const Token *tok, std::size_t start) const
+{
+    if (!tok)
+        return npos;
+
+    static const std::vector<std::size_t> none;
+    const std::unordered_map<std::string, std::vector<std::size_t> >::const_iterator it = mByFirstToken.find(tok->str());
+    const std::vector<std::size_t> &byFirstToken = (it == mByFirstToken.end()) ? none : it->second;
+
+    // Merge the two sorted lists of candidates, so the patterns are tried in order
+    std::vector<std::size_t>::const_iterator a = std::lower_bound(byFirstToken.begin(), byFirstToken.end(), start);
+    std::vector<std::size_t>::const_iterator b = std::lower_bound(mAnyFirstToken.begin(), mAnyFirstToken.end(), start);
+    while (a != byFirstToken.end() || b != mAnyFirstToken.end()) {
+        std::size_t index;
+        if (b == mAnyFirstToken.end() || (a != byFirstToken.end() && *a < *b))
+            index = *a++;
+        else
+            index = *b++;
+        if (Token::Match(tok, mPatterns[index].c_str()))
+            return index;
+    }
+    return npos;
+}
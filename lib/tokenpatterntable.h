@@ -0,0 +1,81 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef tokenpatterntableH
+#define tokenpatterntableH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Token;
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief A list of Token::Match patterns, indexed by their first token.
+ *
+ * This is for checks that match many configured patterns against every
+ * token. Each token is only matched against the patterns that can start
+ * with it. Patterns whose first token is not a plain string, like
+ * "%name%" or "!!else", are matched against all tokens.
+ */
+class CPPCHECKLIB TokenPatternTable {
+public:
+    static const std::size_t npos = ~static_cast<std::size_t>(0);
+
+    /**
+     * Add a pattern. Patterns are tried in the order they are added.
+     * @return the index of the pattern
+     */
+    std::size_t add(const std::string &pattern);
+
+    /** Number of patterns */
+    std::size_t size() const {
+        return mPatterns.size();
+    }
+
+    const std::string &pattern(std::size_t index) const {
+        return mPatterns[index];
+    }
+
+    /**
+     * Find the first pattern that matches at a token
+     * @param tok the token
+     * @param start index of the first pattern to try
+     * @return the index of the pattern, or npos if no pattern matches
+     */
+    std::size_t findMatch(const Token *tok, std::size_t start = 0) const;
+
+private:
+    std::vector<std::string> mPatterns;
+    /** patterns by their first token, in increasing order */
+    std::unordered_map<std::string, std::vector<std::size_t> > mByFirstToken;
+    /** patterns that can start with any token, in increasing order */
+    std::vector<std::size_t> mAnyFirstToken;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // tokenpatterntableH
@@ -78,6 +78,7 @@
 #include "valueflow.h"
 
 #include "astutils.h"
+#include "counters.h"
 #include "errorlogger.h"
 #include "library.h"
 #include "mathlib.h"
@@ -85,6 +86,7 @@
 #include "settings.h"
 #include "standards.h"
 #include "symboldatabase.h"
+#include "timer.h"
 #include "token.h"
 #include "tokenlist.h"
 #include "utils.h"
@@ -477,7 +479,7 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value, const Setti
                 const Token *op = cond ? tok->astOperand1() : tok->astOperand2();
                 if (!op) // #7769 segmentation fault at setTokenValue()
                     return;
-                const std::list<ValueFlow::Value> &values = op->values();
+                const ValueFlow::ValueList &values = op->values();
                 if (std::find(values.begin(), values.end(), value) != values.end())
                     setTokenValue(parent, value, settings);
             }
@@ -1191,14 +1193,14 @@ static void valueFlowTerminatingCondition(TokenList *tokenlist, SymbolDatabase*
                     ValueFlow::Value val(1);
                     val.setKnown();
                     val.condition = cond.first;
-                    val.errorPath = errorPath;
+                    val.errorPath = ValueFlow::Value::ErrorPath(errorPath);
                     val.errorPath.emplace_back(cond.first, "Assuming condition '" + cond.first->expressionString() + "' is false");
                     setTokenValue(tok, val, tokenlist->getSettings());
                 } else if (isSameExpression(cpp, true, tok, cond.first, settings->library, true, true, &errorPath)) {
                     ValueFlow::Value val(0);
                     val.setKnown();
                     val.condition = cond.first;
-                    val.errorPath = errorPath;
+                    val.errorPath = ValueFlow::Value::ErrorPath(errorPath);
                     val.errorPath.emplace_back(cond.first, "Assuming condition '" + cond.first->expressionString() + "' is false");
                     setTokenValue(tok, val, tokenlist->getSettings());
                 }
@@ -1377,6 +1379,24 @@ static void valueFlowGlobalStaticVar(TokenList *tokenList, const Settings *setti
     }
 }
 
+namespace {
+    /** Tokens that may be visited for one variable in one forward/reverse analysis */
+    class TokenBudget {
+    public:
+        explicit TokenBudget(unsigned int max) : mMax(max), mVisited(0) {}
+        bool visit() {
+            ++mVisited;
+            return mMax == 0 || mVisited <= mMax;
+        }
+        unsigned long visited() const {
+            return mVisited;
+        }
+    private:
+        const unsigned int mMax;
+        unsigned long mVisited;
+    };
+}
+
 static void valueFlowReverse(TokenList *tokenlist,
                              Token *tok,
                              const Token * const varToken,
@@ -1393,6 +1413,8 @@ static void valueFlowReverse(TokenList *tokenlist,
     const unsigned int       varid      = varToken->varId();
     const Token * const      startToken = var->nameToken();
 
+    TokenBudget budget(settings->maxValueFlowTokens);
+
     for (Token *tok2 = tok->previous(); ; tok2 = tok2->previous()) {
         if (!tok2 ||
             tok2 == startToken ||
@@ -1400,6 +1422,14 @@ static void valueFlowReverse(TokenList *tokenlist,
             break;
         }
 
+        if (!budget.visit()) {
+            if (settings->showtime != SHOWTIME_NONE)
+                ++tokenlist->valueFlowStatistics().reverseTokenBailouts;
+            if (settings->debugwarnings)
+                bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " valueFlowReverse, token budget exceeded");
+            break;
+        }
+
         if (tok2->varId() == varid) {
             // bailout: assignment
             if (Token::Match(tok2->previous(), "!!* %name% =")) {
@@ -1589,10 +1619,13 @@ static void valueFlowReverse(TokenList *tokenlist,
             if (!(var->isLocal() || var->isArgument()) && !var->isConst()) {
                 if (settings->debugwarnings)
                     bailout(tokenlist, errorLogger, tok, "global variable " + var->name());
-                return;
+                break;
             }
         }
     }
+
+    if (settings->showtime != SHOWTIME_NONE)
+        tokenlist->valueFlowStatistics().reverseTokens += budget.visited();
 }
 
 static void valueFlowBeforeCondition(TokenList *tokenlist, SymbolDatabase *symboldatabase, ErrorLogger *errorLogger, const Settings *settings)
@@ -1722,7 +1755,7 @@ static void valueFlowAST(Token *tok, unsigned int varid, const ValueFlow::Value
         if (conditionIsFalse(tok->astOperand1(), pm))
             return;
     } else if (tok->str() == "||" && tok->astOperand1()) {
-        const std::list<ValueFlow::Value> &values = tok->astOperand1()->values();
+        const ValueFlow::ValueList &values = tok->astOperand1()->values();
         bool nonzero = false;
         for (const ValueFlow::Value &v : values) {
             if (v.intvalue != 0) {
@@ -1815,7 +1848,9 @@ static bool valueFlowForward(Token * const               startToken,
                              const bool                  subFunction,
                              TokenList * const           tokenlist,
                              ErrorLogger * const         errorLogger,
-                             const Settings * const      settings)
+                             const Settings * const      settings,
+                             TokenBudget &               budget,
+                             const unsigned int          depth)
 {
     int indentlevel = 0;
     unsigned int number_of_if = 0;
@@ -1826,7 +1861,23 @@ static bool valueFlowForward(Token * const               startToken,
     if (values.empty())
         return true;
 
+    if (settings->maxValueFlowDepth && depth > settings->maxValueFlowDepth) {
+        if (settings->showtime != SHOWTIME_NONE)
+            ++tokenlist->valueFlowStatistics().forwardDepthBailouts;
+        if (settings->debugwarnings)
+            bailout(tokenlist, errorLogger, startToken, "variable " + var->name() + " valueFlowForward, depth budget exceeded");
+        return false;
+    }
+
     for (Token *tok2 = startToken; tok2 && tok2 != endToken; tok2 = tok2->next()) {
+        if (!budget.visit()) {
+            if (settings->showtime != SHOWTIME_NONE)
+                ++tokenlist->valueFlowStatistics().forwardTokenBailouts;
+            if (settings->debugwarnings)
+                bailout(tokenlist, errorLogger, tok2, "variable " + var->name() + " valueFlowForward, token budget exceeded");
+            return false;
+        }
+
         if (indentlevel >= 0 && tok2->str() == "{")
             ++indentlevel;
         else if (indentlevel >= 0 && tok2->str() == "}") {
@@ -2002,7 +2053,9 @@ static bool valueFlowForward(Token * const               startToken,
                                                  subFunction,
                                                  tokenlist,
                                                  errorLogger,
-                                                 settings);
+                                                 settings,
+                                                 budget,
+                                                 depth + 1);
 
                 if (!condAlwaysFalse && isVariableChanged(startToken1, startToken1->link(), varid, var->isGlobal(), settings, tokenlist->isCPP())) {
                     removeValues(values, truevalues);
@@ -2030,7 +2083,9 @@ static bool valueFlowForward(Token * const               startToken,
                                                 subFunction,
                                                 tokenlist,
                                                 errorLogger,
-                                                settings);
+                                                settings,
+                                                budget,
+                                                depth + 1);
 
                     if (!condAlwaysTrue && isVariableChanged(startTokenElse, startTokenElse->link(), varid, var->isGlobal(), settings, tokenlist->isCPP())) {
                         removeValues(values, falsevalues);
@@ -2100,7 +2155,9 @@ static bool valueFlowForward(Token * const               startToken,
                                      subFunction,
                                      tokenlist,
                                      errorLogger,
-                                     settings);
+                                     settings,
+                                     budget,
+                                     depth + 1);
                 }
 
                 // Remove conditional values
@@ -2473,7 +2530,25 @@ static bool valueFlowForward(Token * const               startToken,
     return true;
 }
 
-static const Variable *getLifetimeVariable(const Token *tok, ErrorPath &errorPath)
+static bool valueFlowForward(Token * const               startToken,
+                             const Token * const         endToken,
+                             const Variable * const      var,
+                             const unsigned int          varid,
+                             std::list<ValueFlow::Value> values,
+                             const bool                  constValue,
+                             const bool                  subFunction,
+                             TokenList * const           tokenlist,
+                             ErrorLogger * const         errorLogger,
+                             const Settings * const      settings)
+{
+    TokenBudget budget(settings->maxValueFlowTokens);
+    const bool result = valueFlowForward(startToken, endToken, var, varid, std::move(values), constValue, subFunction, tokenlist, errorLogger, settings, budget, 0);
+    if (settings->showtime != SHOWTIME_NONE)
+        tokenlist->valueFlowStatistics().forwardTokens += budget.visited();
+    return result;
+}
+
+static const Variable *getLifetimeVariable(const Token *tok, ValueFlow::Value::ErrorPath &errorPath)
 {
     const Variable *var = tok->variable();
     if (!var)
@@ -2484,7 +2559,7 @@ static const Variable *getLifetimeVariable(const Token *tok, ErrorPath &errorPat
                 continue;
             if (v.tokvalue == tok)
                 continue;
-            errorPath.insert(errorPath.end(), v.errorPath.begin(), v.errorPath.end());
+            errorPath.append(v.errorPath);
             const Variable *var2 = getLifetimeVariable(v.tokvalue, errorPath);
             if (var2)
                 return var2;
@@ -2527,7 +2602,7 @@ static void valueFlowForwardLifetime(Token * tok, TokenList *tokenlist, ErrorLog
             !(var->valueType() && var->valueType()->isIntegral()))
             return;
 
-        std::list<ValueFlow::Value> values = parent->astOperand2()->values();
+        std::list<ValueFlow::Value> values(parent->astOperand2()->values().begin(), parent->astOperand2()->values().end());
 
         // Static variable initialisation?
         if (var->isStatic() && var->nameToken() == parent->astOperand1())
@@ -2558,7 +2633,7 @@ static void valueFlowForwardLifetime(Token * tok, TokenList *tokenlist, ErrorLog
             return;
         const Token *endOfVarScope = var->typeStartToken()->scope()->bodyEnd;
 
-        std::list<ValueFlow::Value> values = tok->values();
+        std::list<ValueFlow::Value> values(tok->values().begin(), tok->values().end());
         const Token *nextExpression = nextAfterAstRightmostLeaf(parent);
         // Only forward lifetime values
         values.remove_if(&isNotLifetimeValue);
@@ -2582,7 +2657,7 @@ struct LifetimeStore {
 
     template <class Predicate>
     void byRef(Token *tok, TokenList *tokenlist, ErrorLogger *errorLogger, const Settings *settings, Predicate pred) const {
-        ErrorPath errorPath;
+        ValueFlow::Value::ErrorPath errorPath;
         const Variable *var = getLifetimeVariable(argtok, errorPath);
         if (!var)
             return;
@@ -2614,7 +2689,7 @@ struct LifetimeStore {
             if (!v.isLifetimeValue())
                 continue;
             const Token *tok3 = v.tokvalue;
-            ErrorPath errorPath = v.errorPath;
+            ValueFlow::Value::ErrorPath errorPath = v.errorPath;
             const Variable *var = getLifetimeVariable(tok3, errorPath);
             if (!var)
                 continue;
@@ -2647,7 +2722,7 @@ struct LifetimeStore {
             if (!v.isLifetimeValue())
                 continue;
             const Token *tok2 = v.tokvalue;
-            ErrorPath errorPath = v.errorPath;
+            ValueFlow::Value::ErrorPath errorPath = v.errorPath;
             const Variable *var = getLifetimeVariable(tok2, errorPath);
             if (!var)
                 continue;
@@ -2782,7 +2857,7 @@ static void valueFlowLifetime(TokenList *tokenlist, SymbolDatabase*, ErrorLogger
         }
         // address of
         else if (tok->isUnaryOp("&")) {
-            ErrorPath errorPath;
+            ValueFlow::Value::ErrorPath errorPath;
             // child should be some buffer or variable
             const Token *vartok = tok->astOperand1();
             while (vartok) {
@@ -2814,7 +2889,7 @@ static void valueFlowLifetime(TokenList *tokenlist, SymbolDatabase*, ErrorLogger
         }
         // container lifetimes
         else if (tok->variable() && Token::Match(tok, "%var% . begin|cbegin|rbegin|crbegin|end|cend|rend|crend|data|c_str (")) {
-            ErrorPath errorPath;
+            ValueFlow::Value::ErrorPath errorPath;
             const Library::Container * container = settings->library.detectContainer(tok->variable()->typeStartToken());
             if (!container)
                 continue;
@@ -2842,7 +2917,7 @@ static void valueFlowLifetime(TokenList *tokenlist, SymbolDatabase*, ErrorLogger
         }
         // Check variables
         else if (tok->variable()) {
-            ErrorPath errorPath;
+            ValueFlow::Value::ErrorPath errorPath;
             const Variable * var = getLifetimeVariable(tok, errorPath);
             if (!var)
                 continue;
@@ -3022,7 +3097,7 @@ static void valueFlowAfterAssign(TokenList *tokenlist, SymbolDatabase* symboldat
             if (!tok->astOperand2() || tok->astOperand2()->values().empty())
                 continue;
 
-            std::list<ValueFlow::Value> values = tok->astOperand2()->values();
+            std::list<ValueFlow::Value> values(tok->astOperand2()->values().begin(), tok->astOperand2()->values().end());
             if (std::any_of(values.begin(), values.end(), std::mem_fn(&ValueFlow::Value::isLifetimeValue))) {
                 valueFlowForwardLifetime(tok, tokenlist, errorLogger, settings);
                 values.remove_if(std::mem_fn(&ValueFlow::Value::isLifetimeValue));
@@ -3980,7 +4055,7 @@ static bool evaluate(const Token *expr, const std::vector<std::list<ValueFlow::V
 
 static std::list<ValueFlow::Value> getFunctionArgumentValues(const Token *argtok)
 {
-    std::list<ValueFlow::Value> argvalues(argtok->values());
+    std::list<ValueFlow::Value> argvalues(argtok->values().begin(), argtok->values().end());
     if (argvalues.empty() && Token::Match(argtok, "%comp%|%oror%|&&|!")) {
         argvalues.emplace_back(0);
         argvalues.emplace_back(1);
@@ -4104,7 +4179,7 @@ static void valueFlowFunctionDefaultParameter(TokenList *tokenlist, SymbolDataba
         for (std::size_t arg = function->minArgCount(); arg < function->argCount(); arg++) {
             const Variable* var = function->getArgumentVar(arg);
             if (var && var->hasDefault() && Token::Match(var->nameToken(), "%var% = %num%|%str% [,)]")) {
-                const std::list<ValueFlow::Value> &values = var->nameToken()->tokAt(2)->values();
+                const ValueFlow::ValueList &values = var->nameToken()->tokAt(2)->values();
                 std::list<ValueFlow::Value> argvalues;
                 for (const ValueFlow::Value &value : values) {
                     ValueFlow::Value v(value);
@@ -4557,6 +4632,58 @@ static void valueFlowContainerAfterCondition(TokenList *tokenlist,
     handler.afterCondition(tokenlist, symboldatabase, errorLogger, settings);
 }
 
+/** Memory used by the error path nodes of this thread */
+static thread_local std::size_t errorPathBytes = 0;
+
+ValueFlow::SharedErrorPath::Node::Node(const std::shared_ptr<const Node> &parent_, const Token *tok, std::string &&info)
+    : parent(parent_), item(tok, std::move(info)), size(parent_ ? parent_->size + 1 : 1)
+{
+    // make_shared() allocates the reference counts together with the node
+    errorPathBytes += sizeof(Node) + 2 * sizeof(long) + item.second.capacity();
+}
+
+ValueFlow::SharedErrorPath::Node::~Node()
+{
+    errorPathBytes -= sizeof(Node) + 2 * sizeof(long) + item.second.capacity();
+}
+
+std::size_t ValueFlow::SharedErrorPath::memoryUsage()
+{
+    return errorPathBytes;
+}
+
+ValueFlow::SharedErrorPath::SharedErrorPath(const std::list<Item> &items)
+{
+    for (const Item &item : items)
+        push_back(item);
+}
+
+void ValueFlow::SharedErrorPath::emplace_back(const Token *tok, std::string info)
+{
+    mLast = std::make_shared<const Node>(mLast, tok, std::move(info));
+}
+
+void ValueFlow::SharedErrorPath::append(const SharedErrorPath &other)
+{
+    if (!mLast) {
+        mLast = other.mLast;
+        return;
+    }
+    std::vector<const Node *> nodes;
+    for (const Node *node = other.mLast.get(); node; node = node->parent.get())
+        nodes.push_back(node);
+    for (std::vector<const Node *>::const_reverse_iterator it = nodes.rbegin(); it != nodes.rend(); ++it)
+        push_back((*it)->item);
+}
+
+std::list<ValueFlow::SharedErrorPath::Item> ValueFlow::SharedErrorPath::toList() const
+{
+    std::list<Item> items;
+    for (const Node *node = mLast.get(); node; node = node->parent.get())
+        items.push_front(node->item);
+    return items;
+}
+
 ValueFlow::Value::Value(const Token *c, long long val)
     : valueType(INT),
       intvalue(val),
@@ -4605,6 +4732,28 @@ const ValueFlow::Value *ValueFlow::valueFlowConstantFoldAST(const Token *expr, c
     return expr && expr->hasKnownValue() ? &expr->values().front() : nullptr;
 }
 
+/** Count the values and the bytes used by the value containers in one walk */
+static void countValues(const TokenList *tokenlist, std::size_t &values, std::size_t &bytes)
+{
+    values = bytes = 0;
+    for (const Token *tok = tokenlist->front(); tok; tok = tok->next()) {
+        const ValueFlow::ValueList &tokvalues = tok->values();
+        if (tokvalues.empty())
+            continue;
+        values += tokvalues.size();
+        bytes += sizeof(ValueFlow::ValueList);
+        // the first value is stored in the container itself
+        if (!tokvalues.isInline())
+            bytes += tokvalues.capacity() * sizeof(ValueFlow::Value);
+    }
+}
+
+static std::size_t valuesMemoryUsage(std::size_t bytes)
+{
+    return bytes + ValueFlow::SharedErrorPath::memoryUsage();
+}
+
+#ifdef HAVE_COUNTERS
 static std::size_t getTotalValues(TokenList *tokenlist)
 {
     std::size_t n = 1;
@@ -4613,45 +4762,96 @@ static std::size_t getTotalValues(TokenList *tokenlist)
     return n;
 }
 
-void ValueFlow::setValues(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings)
+/** Run pass and count the values it created */
+#define VALUEFLOW_PASS(pass, args) \
+    do { \
+        const std::size_t valuesBefore = getTotalValues(tokenlist); \
+        pass args; \
+        const std::size_t valuesAfter = getTotalValues(tokenlist); \
+        Counters::count("ValueFlow values", #pass, valuesAfter > valuesBefore ? valuesAfter - valuesBefore : 0); \
+    } while (false)
+#else
+#define VALUEFLOW_PASS(pass, args) pass args
+#endif
+
+ValueFlow::SetValuesResult ValueFlow::setValues(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings, std::time_t deadline, TimerResultsIntf *timerResults)
 {
     for (Token *tok = tokenlist->front(); tok; tok = tok->next())
         tok->clearValueFlow();
 
-    valueFlowNumber(tokenlist);
-    valueFlowString(tokenlist);
-    valueFlowArray(tokenlist);
-    valueFlowGlobalStaticVar(tokenlist, settings);
-    valueFlowPointerAlias(tokenlist);
-    valueFlowLifetime(tokenlist, symboldatabase, errorLogger, settings);
-    valueFlowFunctionReturn(tokenlist, errorLogger);
-    valueFlowBitAnd(tokenlist);
+    tokenlist->valueFlowStatistics() = ValueFlow::BudgetStatistics();
+
+    VALUEFLOW_PASS(valueFlowNumber, (tokenlist));
+    VALUEFLOW_PASS(valueFlowString, (tokenlist));
+    VALUEFLOW_PASS(valueFlowArray, (tokenlist));
+    VALUEFLOW_PASS(valueFlowGlobalStaticVar, (tokenlist, settings));
+    VALUEFLOW_PASS(valueFlowPointerAlias, (tokenlist));
+    VALUEFLOW_PASS(valueFlowLifetime, (tokenlist, symboldatabase, errorLogger, settings));
+    VALUEFLOW_PASS(valueFlowFunctionReturn, (tokenlist, errorLogger));
+    VALUEFLOW_PASS(valueFlowBitAnd, (tokenlist));
 
     // Temporary hack.. run valueflow until there is nothing to update or timeout expires
     const std::time_t timeout = std::time(0) + TIMEOUT;
+    // the tokens and the symbols are not changed by the passes
+    const std::size_t fixedMemory = settings->maxMemoryPerFile ? tokenlist->memoryUsage() + symboldatabase->memoryUsage() : 0;
     std::size_t values = 0;
-    while (std::time(0) < timeout && values < getTotalValues(tokenlist)) {
-        values = getTotalValues(tokenlist);
-        valueFlowRightShift(tokenlist);
-        valueFlowOppositeCondition(symboldatabase, settings);
-        valueFlowTerminatingCondition(tokenlist, symboldatabase, settings);
-        valueFlowBeforeCondition(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowAfterMove(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowAfterAssign(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowAfterCondition(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowSwitchVariable(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowForLoop(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowSubFunction(tokenlist, errorLogger, settings);
-        valueFlowFunctionDefaultParameter(tokenlist, symboldatabase, errorLogger, settings);
-        valueFlowUninit(tokenlist, symboldatabase, errorLogger, settings);
+    SetValuesResult result = ALL_VALUES;
+    for (;;) {
+        std::size_t count, bytes;
+        countValues(tokenlist, count, bytes);
+        if (values >= count + 1)
+            break;
+        const std::time_t now = std::time(0);
+        if (deadline != 0 && now >= deadline) {
+            result = BUDGET_EXCEEDED;
+            break;
+        }
+        if (now >= timeout) {
+            result = TIMEOUT_REACHED;
+            break;
+        }
+        if (settings->maxMemoryPerFile && fixedMemory + valuesMemoryUsage(bytes) > settings->maxMemoryPerFile) {
+            result = BUDGET_EXCEEDED;
+            break;
+        }
+        values = count + 1;
+        VALUEFLOW_PASS(valueFlowRightShift, (tokenlist));
+        VALUEFLOW_PASS(valueFlowOppositeCondition, (symboldatabase, settings));
+        VALUEFLOW_PASS(valueFlowTerminatingCondition, (tokenlist, symboldatabase, settings));
+        VALUEFLOW_PASS(valueFlowBeforeCondition, (tokenlist, symboldatabase, errorLogger, settings));
+        VALUEFLOW_PASS(valueFlowAfterMove, (tokenlist, symboldatabase, errorLogger, settings));
+        VALUEFLOW_PASS(valueFlowAfterAssign, (tokenlist, symboldatabase, errorLogger, settings));
+        VALUEFLOW_PASS(valueFlowAfterCondition, (tokenlist, symboldatabase, errorLogger, settings));
+        VALUEFLOW_PASS(valueFlowSwitchVariable, (tokenlist, symboldatabase, errorLogger, settings));
+        VALUEFLOW_PASS(valueFlowForLoop, (tokenlist, symboldatabase, errorLogger, settings));
+        VALUEFLOW_PASS(valueFlowSubFunction, (tokenlist, errorLogger, settings));
+        VALUEFLOW_PASS(valueFlowFunctionDefaultParameter, (tokenlist, symboldatabase, errorLogger, settings));
+        VALUEFLOW_PASS(valueFlowUninit, (tokenlist, symboldatabase, errorLogger, settings));
         if (tokenlist->isCPP()) {
-            valueFlowContainerSize(tokenlist, symboldatabase, errorLogger, settings);
-            valueFlowContainerAfterCondition(tokenlist, symboldatabase, errorLogger, settings);
+            VALUEFLOW_PASS(valueFlowContainerSize, (tokenlist, symboldatabase, errorLogger, settings));
+            VALUEFLOW_PASS(valueFlowContainerAfterCondition, (tokenlist, symboldatabase, errorLogger, settings));
         }
     }
+
+    if (timerResults && settings->showtime != SHOWTIME_NONE) {
+        const ValueFlow::BudgetStatistics &budgetStatistics = tokenlist->valueFlowStatistics();
+        timerResults->AddCount("ValueFlow forward: tokens visited", budgetStatistics.forwardTokens);
+        timerResults->AddCount("ValueFlow forward: token budget exceeded", budgetStatistics.forwardTokenBailouts);
+        timerResults->AddCount("ValueFlow forward: depth budget exceeded", budgetStatistics.forwardDepthBailouts);
+        timerResults->AddCount("ValueFlow reverse: tokens visited", budgetStatistics.reverseTokens);
+        timerResults->AddCount("ValueFlow reverse: token budget exceeded", budgetStatistics.reverseTokenBailouts);
+    }
+    return result;
 }
 
 
+std::size_t ValueFlow::memoryUsage(const TokenList *tokenlist)
+{
+    std::size_t values, bytes;
+    countValues(tokenlist, values, bytes);
+    return valuesMemoryUsage(bytes);
+}
+
 std::string ValueFlow::eitherTheConditionIsRedundant(const Token *condition)
 {
     if (!condition)
@@ -22,22 +22,76 @@
 //---------------------------------------------------------------------------
 
 #include "config.h"
+#include "smallvector.h"
 
+#include <cstddef>
+#include <ctime>
 #include <list>
+#include <memory>
 #include <string>
 #include <utility>
 
 class ErrorLogger;
 class Settings;
 class SymbolDatabase;
+class TimerResultsIntf;
 class Token;
 class TokenList;
 
 namespace ValueFlow {
+    /**
+     * @brief Error path of a value.
+     *
+     * Each item points at the item before it, and copies of the path
+     * share their items. Copying a path is cheap and adding an item to
+     * a copy does not change the other copies.
+     */
+    class CPPCHECKLIB SharedErrorPath {
+    public:
+        typedef std::pair<const Token *, std::string> Item;
+
+        SharedErrorPath() {}
+        explicit SharedErrorPath(const std::list<Item> &items);
+
+        bool empty() const {
+            return !mLast;
+        }
+        std::size_t size() const {
+            return mLast ? mLast->size : 0;
+        }
+
+        void emplace_back(const Token *tok, std::string info);
+        void push_back(const Item &item) {
+            emplace_back(item.first, item.second);
+        }
+        void clear() {
+            mLast.reset();
+        }
+
+        /** Add the items of other after the items of this path */
+        void append(const SharedErrorPath &other);
+
+        /** The items, the first item first */
+        std::list<Item> toList() const;
+
+        /** Estimate the memory used by the items of all error paths that exist in the calling thread */
+        static std::size_t memoryUsage();
+
+    private:
+        struct Node {
+            Node(const std::shared_ptr<const Node> &parent_, const Token *tok, std::string &&info);
+            ~Node();
+            std::shared_ptr<const Node> parent;
+            Item item;
+            std::size_t size;
+        };
+        std::shared_ptr<const Node> mLast;
+    };
+
     class CPPCHECKLIB Value {
     public:
-        typedef std::pair<const Token *, std::string> ErrorPathItem;
-        typedef std::list<ErrorPathItem> ErrorPath;
+        typedef SharedErrorPath::Item ErrorPathItem;
+        typedef SharedErrorPath ErrorPath;
 
         explicit Value(long long val = 0) : valueType(INT), intvalue(val), tokvalue(nullptr), floatValue(0.0), moveKind(NonMovedVariable), varvalue(val), condition(nullptr), varId(0U), conditional(false), defaultArg(false), lifetimeKind(Object), valueKind(ValueKind::Possible) {}
         Value(const Token *c, long long val);
@@ -195,11 +249,39 @@ namespace ValueFlow {
         }
     };
 
+    /** Values of a token. Almost all tokens that have values have only one. */
+    typedef SmallVector<Value, 1> ValueList;
+
+    /** Token and depth budget statistics for --showtime, reset by setValues() */
+    struct BudgetStatistics {
+        BudgetStatistics() : forwardTokens(0), forwardTokenBailouts(0), forwardDepthBailouts(0), reverseTokens(0), reverseTokenBailouts(0) {}
+        unsigned long forwardTokens;
+        unsigned long forwardTokenBailouts;
+        unsigned long forwardDepthBailouts;
+        unsigned long reverseTokens;
+        unsigned long reverseTokenBailouts;
+    };
+
     /// Constant folding of expression. This can be used before the full ValueFlow has been executed (ValueFlow::setValues).
     const ValueFlow::Value * valueFlowConstantFoldAST(const Token *expr, const Settings *settings);
 
-    /// Perform valueflow analysis.
-    void setValues(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings);
+    /** How far setValues() repeated the analysis */
+    enum SetValuesResult {
+        ALL_VALUES,       ///< repeated until no more values were found
+        TIMEOUT_REACHED,  ///< stopped by the built-in time limit
+        BUDGET_EXCEEDED   ///< stopped by the time or memory budget of the file
+    };
+
+    /**
+     * Perform valueflow analysis.
+     * @param deadline stop repeating the analysis when this time is reached, 0 if there is no deadline
+     * @param timerResults where the analysis budget statistics are added for --showtime
+     * @return if the analysis was stopped before all values were found, and why
+     */
+    SetValuesResult setValues(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings, std::time_t deadline = 0, TimerResultsIntf *timerResults = nullptr);
+
+    /// Estimate the memory used by the values of the tokens and by their error paths.
+    std::size_t memoryUsage(const TokenList *tokenlist);
 
     std::string eitherTheConditionIsRedundant(const Token *condition);
 }
@@ -0,0 +1,108 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEMPDIRECTORY_H
+#define TEMPDIRECTORY_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Utility class that creates an empty temporary directory for the
+ * files a test writes. Uses RAII to remove the directory and the files in
+ * it when the object goes out of scope. Subdirectories are not supported.
+ */
+class TempDirectory {
+public:
+    TempDirectory() {
+#ifdef _WIN32
+        char tempPath[MAX_PATH];
+        if (GetTempPathA(MAX_PATH, tempPath) == 0)
+            return;
+        char name[MAX_PATH];
+        if (GetTempFileNameA(tempPath, "cpc", 0, name) == 0)
+            return;
+        // GetTempFileName() created a file with the unique name
+        DeleteFileA(name);
+        if (CreateDirectoryA(name, nullptr))
+            _path = name;
+#else
+        const char *tmpdir = std::getenv("TMPDIR");
+        std::string pattern = std::string((tmpdir && *tmpdir) ? tmpdir : "/tmp") + "/cppcheck-test-XXXXXX";
+        std::vector<char> buf(pattern.begin(), pattern.end());
+        buf.push_back('\0');
+        if (mkdtemp(buf.data()))
+            _path = buf.data();
+#endif
+    }
+
+    ~TempDirectory() {
+        if (_path.empty())
+            return;
+#ifdef _WIN32
+        WIN32_FIND_DATAA ffd;
+        const HANDLE hFind = FindFirstFileA((_path + "\\*").c_str(), &ffd);
+        if (hFind != INVALID_HANDLE_VALUE) {
+            do {
+                if ((ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+                    DeleteFileA(file(ffd.cFileName).c_str());
+            } while (FindNextFileA(hFind, &ffd));
+            FindClose(hFind);
+        }
+        RemoveDirectoryA(_path.c_str());
+#else
+        DIR *dir = opendir(_path.c_str());
+        if (dir) {
+            while (const struct dirent *entry = readdir(dir)) {
+                const std::string name = entry->d_name;
+                if (name != "." && name != "..")
+                    std::remove(file(name).c_str());
+            }
+            closedir(dir);
+        }
+        rmdir(_path.c_str());
+#endif
+    }
+
+    /** Path of the directory, empty if it could not be created */
+    const std::string &path() const {
+        return _path;
+    }
+
+    /** Path of the file name in the directory */
+    std::string file(const std::string &name) const {
+        return _path + '/' + name;
+    }
+
+private:
+    TempDirectory(const TempDirectory &) = delete;
+    TempDirectory &operator=(const TempDirectory &) = delete;
+
+    std::string _path;
+};
+
+#endif
@@ -102,6 +102,14 @@ private:
         TEST_CASE(maxConfigsMissingCount);
         TEST_CASE(maxConfigsInvalid);
         TEST_CASE(maxConfigsTooSmall);
+        TEST_CASE(maxTimePerFile);
+        TEST_CASE(maxTimePerFileInvalid);
+        TEST_CASE(maxMemoryPerFile);
+        TEST_CASE(maxMemoryPerFileInvalid);
+        TEST_CASE(maxMemory);
+        TEST_CASE(maxValueFlowTokens);
+        TEST_CASE(maxValueFlowTokensInvalid);
+        TEST_CASE(maxValueFlowDepth);
         TEST_CASE(reportProgressTest); // "Test" suffix to avoid hiding the parent's reportProgress
         TEST_CASE(stdposix);
         TEST_CASE(stdc99);
@@ -126,6 +134,10 @@ private:
         TEST_CASE(xmlverinvalid);
         TEST_CASE(doc);
         TEST_CASE(showtime);
+        TEST_CASE(memleakEngine);
+        TEST_CASE(dumpFormat);
+        TEST_CASE(addon);
+        TEST_CASE(cfgCacheDir);
         TEST_CASE(errorlist1);
         TEST_CASE(errorlistverbose1);
         TEST_CASE(errorlistverbose2);
@@ -686,6 +698,67 @@ private:
         ASSERT_EQUALS(false, defParser.parseFromArgs(3, argv));
     }
 
+    void maxTimePerFile() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--max-time-per-file=60", "file.cpp"};
+        settings.maxTimePerFile = 0;
+        ASSERT(defParser.parseFromArgs(3, argv));
+        ASSERT_EQUALS(60, settings.maxTimePerFile);
+    }
+
+    void maxTimePerFileInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--max-time-per-file=e", "file.cpp"};
+        // Fails since invalid time given for --max-time-per-file=
+        ASSERT_EQUALS(false, defParser.parseFromArgs(3, argv));
+    }
+
+    void maxMemoryPerFile() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--max-memory-per-file=100", "file.cpp"};
+        settings.maxMemoryPerFile = 0;
+        ASSERT(defParser.parseFromArgs(3, argv));
+        ASSERT_EQUALS(100U * 1024U * 1024U, settings.maxMemoryPerFile);
+    }
+
+    void maxMemoryPerFileInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--max-memory-per-file=e", "file.cpp"};
+        // Fails since invalid size given for --max-memory-per-file=
+        ASSERT_EQUALS(false, defParser.parseFromArgs(3, argv));
+    }
+
+    void maxMemory() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--max-memory=2048", "file.cpp"};
+        settings.maxMemory = 0;
+        ASSERT(defParser.parseFromArgs(3, argv));
+        ASSERT_EQUALS(2048U * 1024U * 1024U, settings.maxMemory);
+    }
+
+    void maxValueFlowTokens() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--max-valueflow-tokens=5000", "file.cpp"};
+        settings.maxValueFlowTokens = 100000;
+        ASSERT(defParser.parseFromArgs(3, argv));
+        ASSERT_EQUALS(5000, settings.maxValueFlowTokens);
+    }
+
+    void maxValueFlowTokensInvalid() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--max-valueflow-tokens=e", "file.cpp"};
+        // Fails since invalid number given for --max-valueflow-tokens=
+        ASSERT_EQUALS(false, defParser.parseFromArgs(3, argv));
+    }
+
+    void maxValueFlowDepth() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--max-valueflow-depth=0", "file.cpp"};
+        settings.maxValueFlowDepth = 64;
+        ASSERT(defParser.parseFromArgs(3, argv));
+        ASSERT_EQUALS(0, settings.maxValueFlowDepth);
+    }
+
     void reportProgressTest() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--report-progress", "file.cpp"};
@@ -907,6 +980,64 @@ private:
         ASSERT(settings.showtime == SHOWTIME_SUMMARY);
     }
 
+    void memleakEngine() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--memleak-engine=compare"};
+        settings.memleakEngine = Settings::MEMLEAK_SIMPLIFY;
+        ASSERT(defParser.parseFromArgs(2, argv));
+        ASSERT(settings.memleakEngine == Settings::MEMLEAK_COMPARE);
+        settings.memleakEngine = Settings::MEMLEAK_SIMPLIFY;
+    }
+
+    void dumpFormat() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--dump-format=binary"};
+        settings.dump = false;
+        settings.dumpFormat = Settings::DUMP_XML;
+        ASSERT(defParser.parseFromArgs(2, argv));
+        ASSERT(settings.dump);
+        ASSERT(settings.dumpFormat == Settings::DUMP_BINARY);
+
+        const char * const argv2[] = {"cppcheck", "--dump-format=json"};
+        ASSERT(!defParser.parseFromArgs(2, argv2));
+
+        settings.dump = false;
+        settings.dumpFormat = Settings::DUMP_XML;
+    }
+
+    void addon() {
+        REDIRECT;
+        const char * const argv[] = {"cppcheck", "--addon=addons/misra.py", "--addon-python=python3", "file.cpp"};
+        settings.addons.clear();
+        ASSERT(defParser.parseFromArgs(4, argv));
+        ASSERT_EQUALS(1U, settings.addons.size());
+        ASSERT_EQUALS("addons/misra.py", settings.addons.front());
+        ASSERT_EQUALS("python3", settings.addonPython);
+        ASSERT(!settings.dump);
+
+        const char * const argv2[] = {"cppcheck", "--addon=addons/nosuchaddon.py", "file.cpp"};
+        ASSERT(!defParser.parseFromArgs(3, argv2));
+
+        settings.addons.clear();
+        settings.addonPython = "python";
+    }
+
+    void cfgCacheDir() {
+        REDIRECT;
+        settings.library.setCacheDirectory("");
+        const char * const argv0[] = {"cppcheck", "file.cpp"};
+        ASSERT(defParser.parseFromArgs(2, argv0));
+        ASSERT_EQUALS("", settings.library.cacheDirectory()); // disabled by default
+
+        const char * const argv[] = {"cppcheck", "--cfg-cache-dir=cache\\dir", "file.cpp"};
+        ASSERT(defParser.parseFromArgs(3, argv));
+        ASSERT_EQUALS("cache/dir", settings.library.cacheDirectory());
+
+        const char * const argv2[] = {"cppcheck", "--cfg-cache-dir=", "file.cpp"};
+        ASSERT(defParser.parseFromArgs(3, argv2));
+        ASSERT_EQUALS("", settings.library.cacheDirectory());
+    }
+
     void errorlist1() {
         REDIRECT;
         const char * const argv[] = {"cppcheck", "--errorlist"};
@@ -0,0 +1,88 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "counters.h"
+#include "testsuite.h"
+
+#include <sstream>
+
+class TestCounters : public TestFixture {
+public:
+    TestCounters() : TestFixture("TestCounters") {
+    }
+
+private:
+
+    void run() override {
+        TEST_CASE(count);
+        TEST_CASE(json);
+        TEST_CASE(callSite);
+    }
+
+    void count() const {
+        Counters::reset();
+        static const char pattern[] = "%name% (";
+        Counters::countLiteral("Token::Match", pattern);
+        Counters::countLiteral("Token::Match", pattern);
+        Counters::count("Token::Match", "%name% (", 3);
+        Counters::count("ValueFlow values", "valueFlowNumber", 10);
+        ASSERT_EQUALS(5UL, Counters::get("Token::Match", "%name% ("));
+        ASSERT_EQUALS(10UL, Counters::get("ValueFlow values", "valueFlowNumber"));
+        ASSERT_EQUALS(0UL, Counters::get("ValueFlow values", "valueFlowString"));
+        ASSERT_EQUALS(0UL, Counters::get("SymbolDatabase::findFunction", "f"));
+        Counters::reset();
+        ASSERT_EQUALS(0UL, Counters::get("Token::Match", "%name% ("));
+    }
+
+    void json() const {
+        Counters::reset();
+        Counters::count("Token::Match", "%str%", 1);
+        Counters::count("Token::Match", "\"abc\"", 2);
+        Counters::count("Scope::findFunction", "f", 4);
+        std::ostringstream ostr;
+        Counters::writeJson(ostr);
+        ASSERT_EQUALS("{\n"
+                      "  \"Scope::findFunction\": {\n"
+                      "    \"f\": 4\n"
+                      "  },\n"
+                      "  \"Token::Match\": {\n"
+                      "    \"\\\"abc\\\"\": 2,\n"
+                      "    \"%str%\": 1\n"
+                      "  }\n"
+                      "}\n", ostr.str());
+        Counters::reset();
+    }
+
+    void callSite() const {
+        Counters::reset();
+        static const char caller1[] = "1";
+        static const char caller2[] = "2";
+        Counters::countCallSite("Token::Match callers", caller1);
+        Counters::countCallSite("Token::Match callers", caller1);
+        Counters::countCallSite("Token::Match callers", caller2);
+        std::ostringstream ostr;
+        Counters::writeJson(ostr);
+        const std::string json = ostr.str();
+        ASSERT(json.find("\"Token::Match callers\"") != std::string::npos);
+        ASSERT(json.find("\": 2,\n") != std::string::npos);
+        ASSERT(json.find("\": 1\n") != std::string::npos);
+        Counters::reset();
+    }
+};
+
+REGISTER_TEST(TestCounters)
@@ -19,11 +19,14 @@
 #include "check.h"
 #include "cppcheck.h"
 #include "errorlogger.h"
+#include "tempdirectory.h"
 #include "testsuite.h"
 
 #include <algorithm>
+#include <fstream>
 #include <list>
 #include <string>
+#include <vector>
 
 
 class TestCppcheck : public TestFixture {
@@ -36,12 +39,16 @@ private:
     class ErrorLogger2 : public ErrorLogger {
     public:
         std::list<std::string> id;
+        std::list<std::string> messages;
+        std::list<std::string> out;
 
-        void reportOut(const std::string & /*outmsg*/) {
+        void reportOut(const std::string &outmsg) {
+            out.push_back(outmsg);
         }
 
         void reportErr(const ErrorLogger::ErrorMessage &msg) {
             id.push_back(msg._id);
+            messages.push_back(msg.toString(false));
         }
     };
 
@@ -49,6 +56,11 @@ private:
         TEST_CASE(instancesSorted);
         TEST_CASE(classInfoFormat);
         TEST_CASE(getErrorMessages);
+        TEST_CASE(maxMemoryPerFile);
+        TEST_CASE(valueFlowTimeoutMessage);
+        TEST_CASE(loadConfigs);
+        TEST_CASE(addon);
+        TEST_CASE(addonDumpFile);
     }
 
     void instancesSorted() const {
@@ -105,6 +117,141 @@ private:
         ASSERT(foundPurgedConfiguration);
         ASSERT(foundTooManyConfigs);
     }
+
+    void maxMemoryPerFile() const {
+        const char code[] = "template<class T> struct A { T x; };\n"
+                            "A<int> a;\n";
+        {
+            ErrorLogger2 errorLogger;
+            CppCheck cppCheck(errorLogger, true);
+            cppCheck.settings().maxMemoryPerFile = 1;
+            cppCheck.settings().addEnabled("information");
+            cppCheck.check("test.cpp", code);
+
+            // the configuration is aborted instead of reporting an internal error
+            ASSERT_EQUALS(1U, errorLogger.id.size());
+            ASSERT_EQUALS("analysisDegraded", errorLogger.id.front());
+            ASSERT_EQUALS("[test.cpp:0]: (information) Analysis of this file was degraded to stay within its budget: "
+                          "aborted configurations.", errorLogger.messages.front());
+        }
+
+        // the degraded analysis is only reported with --enable=information
+        {
+            ErrorLogger2 errorLogger;
+            CppCheck cppCheck(errorLogger, true);
+            cppCheck.settings().maxMemoryPerFile = 1;
+            ASSERT_EQUALS(0U, cppCheck.check("test.cpp", code));
+            ASSERT_EQUALS(0U, errorLogger.id.size());
+        }
+    }
+
+    void valueFlowTimeoutMessage() const {
+        ErrorLogger2 errorLogger;
+        CppCheck cppCheck(errorLogger, true);
+        cppCheck.settings().addEnabled("information");
+
+        // the built-in time limit of ValueFlow is not a budget of the file
+        cppCheck.degradedAnalysisMessage("test.cpp", std::vector<std::string>(), true);
+        ASSERT_EQUALS(1U, errorLogger.messages.size());
+        ASSERT_EQUALS("[test.cpp:0]: (information) ValueFlow analysis of this file was stopped by its time limit.", errorLogger.messages.front());
+    }
+
+    void loadConfigs() const {
+        Settings settings;
+        Check::loadConfigs(&settings);
+        ASSERT_EQUALS(0U, settings.checkConfigs.size());
+
+        settings.userRuleConfigure = YAML::Load("CheckPointerBeforeUse:\n"
+                                                "  containerType:\n"
+                                                "    - vector\n"
+                                                "CheckTryCatchFunc:\n"
+                                                "  - class: '::'\n"
+                                                "    function:\n"
+                                                "      - stoi\n"
+                                                "    exception:\n"
+                                                "      - invalid_argument\n"
+                                                "UnknownCheck: 1\n");
+        Check::loadConfigs(&settings);
+        ASSERT_EQUALS(2U, settings.checkConfigs.size());
+        ASSERT_EQUALS(1U, settings.checkConfigs.count("CheckPointerBeforeUse"));
+        ASSERT_EQUALS(1U, settings.checkConfigs.count("CheckTryCatchFunc"));
+
+        // the configurations are shared by copies of the settings
+        const Settings copy(settings);
+        ASSERT(copy.checkConfigs.at("CheckTryCatchFunc") == settings.checkConfigs.at("CheckTryCatchFunc"));
+
+        settings.userRuleConfigure = YAML::Load("CheckTryCatchFunc:\n"
+                                                "  - function: [ a, b ]\n");
+        ASSERT_THROW(Check::loadConfigs(&settings), YAML::Exception);
+    }
+
+    // The addons are shell scripts here, "sh" is passed as the interpreter
+    static void writeAddon(const std::string &filename, const char script[]) {
+        std::ofstream fout(filename);
+        fout << script;
+    }
+
+    void addon() const {
+#ifndef _WIN32
+        TempDirectory dir;
+        ASSERT(!dir.path().empty());
+        writeAddon(dir.file("addon.sh"),
+                   "test \"$(wc -c)\" -gt 0 || exit 2\n"
+                   "echo \"[test.c:2] (warning): dump read from $1 [addonWarning]\" >&2\n"
+                   "echo \"[test.c:3]: ( style ) no id\" >&2\n"
+                   "echo \"[test.c:3] (style): suppressed [addonSuppressed]\" >&2\n"
+                   "echo \"Checking $1...\"\n");
+
+        ErrorLogger2 errorLogger;
+        CppCheck cppCheck(errorLogger, true);
+        cppCheck.settings().addons.push_back(dir.file("addon.sh"));
+        cppCheck.settings().addonPython = "sh";
+        cppCheck.settings().nomsg.addSuppressionLine("addonSuppressed");
+        cppCheck.check("test.c", "int x;\n"
+                       "int y;\n"
+                       "int z;\n");
+
+        // the results are reported through the ErrorLogger, the suppressions apply
+        ASSERT_EQUALS(2U, errorLogger.id.size());
+        ASSERT_EQUALS("addonWarning", errorLogger.id.front());
+        ASSERT_EQUALS("addon", errorLogger.id.back());
+        ASSERT_EQUALS("[test.c:2]: (warning) dump read from -", errorLogger.messages.front());
+        ASSERT_EQUALS("[test.c:3]: (style) no id", errorLogger.messages.back());
+        ASSERT(std::find(errorLogger.out.begin(), errorLogger.out.end(), "Checking -...") != errorLogger.out.end());
+#endif
+    }
+
+    void addonDumpFile() const {
+#ifndef _WIN32
+        TempDirectory dir;
+        ASSERT(!dir.path().empty());
+        writeAddon(dir.file("addon.sh"),
+                   "echo \"[test.c:1] (style): $1 [dumpFile]\" >&2\n");
+
+        // the file names are passed as arguments, the shell does not expand them
+        const std::string dumpfile = dir.file("a $(touch pwned) `touch pwned`.dump");
+        ErrorLogger2 errorLogger;
+        CppCheck cppCheck(errorLogger, true);
+        cppCheck.settings().addons.push_back(dir.file("addon.sh"));
+        cppCheck.settings().addonPython = "sh";
+        cppCheck.settings().dump = true;
+        cppCheck.settings().dumpFile = dumpfile;
+        cppCheck.check("test.c", "int x;\n");
+
+        ASSERT_EQUALS(1U, errorLogger.messages.size());
+        ASSERT_EQUALS("[test.c:1]: (style) " + dumpfile, errorLogger.messages.front());
+        ASSERT_EQUALS(false, std::ifstream("pwned").is_open());
+
+        // an error is reported when the dump file can not be written, the addon reads the pipe
+        errorLogger.id.clear();
+        errorLogger.messages.clear();
+        cppCheck.settings().dumpFile = dir.file("missing/test.c.dump");
+        cppCheck.check("test.c", "int x;\n");
+        ASSERT_EQUALS(2U, errorLogger.id.size());
+        ASSERT_EQUALS("dumpFileError", errorLogger.id.front());
+        ASSERT_EQUALS("[test.c:1]: (style) -", errorLogger.messages.back());
+#endif
+    }
 };
 
 REGISTER_TEST(TestCppcheck)
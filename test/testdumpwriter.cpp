@@ -0,0 +1,181 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dumpwriter.h"
+#include "testsuite.h"
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+class TestDumpWriter : public TestFixture {
+public:
+    TestDumpWriter() : TestFixture("TestDumpWriter") {
+    }
+
+private:
+
+    void run() override {
+        TEST_CASE(xml);
+        TEST_CASE(xmlEscape);
+        TEST_CASE(xmlLayout);
+        TEST_CASE(binary);
+        TEST_CASE(binaryShapes);
+    }
+
+    static void writeTree(DumpWriter &writer) {
+        writer.startElement("root");
+        writer.attribute("name", "a.c");
+        writer.startElement("child");
+        writer.attribute("linenr", 12U);
+        writer.attribute("isConst", true);
+        writer.endElement();
+        writer.startElement("child");
+        writer.attribute("linenr", -1);
+        writer.attribute("isConst", false);
+        writer.endElement();
+        writer.endElement();
+    }
+
+    /** Convert the binary dump to readable text, one record per line */
+    static std::string records(const std::string &dump) {
+        std::string ret;
+        std::string::size_type pos = std::strlen(BinaryDumpWriter::MAGIC);
+        while (pos + 4 <= dump.size()) {
+            const std::string::size_type len = (unsigned char)dump[pos] |
+                                               ((unsigned char)dump[pos + 1] << 8) |
+                                               ((unsigned char)dump[pos + 2] << 16) |
+                                               ((unsigned char)dump[pos + 3] << 24);
+            std::string record = dump.substr(pos + 4, len);
+            for (std::string::size_type i = 0; i < record.size(); ++i) {
+                if (record[i] == '\0')
+                    record[i] = ' ';
+            }
+            ret += record + '\n';
+            pos += 4 + len;
+        }
+        if (pos != dump.size())
+            ret += "truncated\n";
+        return ret;
+    }
+
+    void xml() {
+        std::ostringstream ostr;
+        {
+            XmlDumpWriter writer(ostr);
+            writer.prolog();
+            writeTree(writer);
+        }
+        ASSERT_EQUALS("<?xml version=\"1.0\"?>\n"
+                      "<root name=\"a.c\">\n"
+                      "  <child linenr=\"12\" isConst=\"true\"/>\n"
+                      "  <child linenr=\"-1\" isConst=\"false\"/>\n"
+                      "</root>\n", ostr.str());
+    }
+
+    void xmlEscape() {
+        std::ostringstream ostr;
+        {
+            XmlDumpWriter writer(ostr, 1);
+            writer.startElement("tok");
+            writer.attribute("str", std::string("\"<&>\"\xe4", 6));
+            writer.attribute("id", static_cast<const void *>(nullptr));
+            writer.endElement();
+        }
+        ASSERT_EQUALS("  <tok str=\"&quot;&lt;&amp;&gt;&quot;x\" id=\"0\"/>\n", ostr.str());
+    }
+
+    void xmlLayout() {
+        // same bytes as the xml dump that was written without DumpWriter
+        std::ostringstream ostr;
+        {
+            XmlDumpWriter writer(ostr);
+            writer.startElement("dumps");
+            writer.startElement("suppressions");
+            writer.endElement();
+            writer.startElement("dump");
+            writer.attribute("cfg", "");
+            writer.startElement("tokenlist");
+            writer.startElement("token");
+            writer.attribute("str", ".");
+            writer.rawAttribute("originalName", "->");
+            writer.endElement();
+            writer.endElement();
+            writer.endElement();
+            writer.startElement("suppressions");
+            writer.startElement("suppression");
+            writer.attribute("errorId", "id");
+            writer.endElement();
+            writer.endElement();
+            writer.endElement();
+        }
+        ASSERT_EQUALS("<dumps>\n"
+                      "  <suppressions>\n"
+                      "  </suppressions>\n"
+                      "<dump cfg=\"\">\n"
+                      "  <tokenlist>\n"
+                      "    <token str=\".\" originalName=\"->\"/>\n"
+                      "  </tokenlist>\n"
+                      "</dump>\n"
+                      "  <suppressions>\n"
+                      "    <suppression errorId=\"id\" />\n"
+                      "  </suppressions>\n"
+                      "</dumps>\n", ostr.str());
+    }
+
+    void binary() {
+        std::ostringstream ostr;
+        {
+            BinaryDumpWriter writer(ostr);
+            writeTree(writer);
+        }
+        const std::string dump = ostr.str();
+        ASSERT_EQUALS(BinaryDumpWriter::MAGIC, dump.substr(0, std::strlen(BinaryDumpWriter::MAGIC)));
+        ASSERT_EQUALS("T0 root name\n"
+                      "E0 a.c\n"
+                      "T1 child linenr isConst\n"
+                      "L1 12 true\n"
+                      "L1 -1 false\n"
+                      "X\n", records(dump));
+    }
+
+    void binaryShapes() {
+        // a new shape when the attributes differ, values are not escaped
+        std::ostringstream ostr;
+        {
+            BinaryDumpWriter writer(ostr);
+            writer.startElement("tok");
+            writer.attribute("str", "<");
+            writer.endElement();
+            writer.startElement("tok");
+            writer.attribute("str", "a");
+            writer.attribute("varId", 1);
+            writer.endElement();
+            writer.startElement("tok");
+            writer.attribute("str", std::string("\0\xe4", 2));
+            writer.endElement();
+        }
+        ASSERT_EQUALS("T0 tok str\n"
+                      "L0 <\n"
+                      "T1 tok str varId\n"
+                      "L1 a 1\n"
+                      "L0 \\0x\n", records(ostr.str()));
+    }
+};
+
+REGISTER_TEST(TestDumpWriter)
@@ -49,6 +49,9 @@ private:
         TEST_CASE(ToXmlV2);
         TEST_CASE(ToXmlV2Locations);
         TEST_CASE(ToXmlV2Encoding);
+        TEST_CASE(ToXmlV2Escape);
+        TEST_CASE(AppendXml);
+        TEST_CASE(AppendString);
 
         // Inconclusive results in xml reports..
         TEST_CASE(InconclusiveXml);
@@ -229,6 +232,39 @@ private:
         }
     }
 
+    void ToXmlV2Escape() const {
+        // the same escaping as tinyxml2::XMLPrinter
+        const std::list<ErrorLogger::ErrorMessage::FileLocation> locs(1, ErrorLogger::ErrorMessage::FileLocation("a&b's.cpp", "x<\"y\">", 5));
+        ErrorMessage msg(locs, emptyString, Severity::style, "$symbol:f<T>\nFunction 'f<T>' & \"g\"", "errorId", false);
+        ASSERT_EQUALS("        <error id=\"errorId\" severity=\"style\" msg=\"Function &apos;f&lt;T&gt;&apos; &amp; &quot;g&quot;\" verbose=\"Function &apos;f&lt;T&gt;&apos; &amp; &quot;g&quot;\">\n"
+                      "            <location file=\"a&amp;b&apos;s.cpp\" line=\"5\" info=\"x&lt;&quot;y&quot;&gt;\"/>\n"
+                      "            <symbol>f&lt;T&gt;</symbol>\n"
+                      "        </error>",
+                      msg.toXML());
+    }
+
+    void AppendXml() const {
+        std::list<ErrorLogger::ErrorMessage::FileLocation> locs(1, fooCpp5);
+        ErrorMessage msg(locs, emptyString, Severity::error, "Programming error.", "errorId", false);
+        std::string buf("<errors>\n");
+        msg.appendXML(buf);
+        ASSERT_EQUALS("<errors>\n" + msg.toXML(), buf);
+    }
+
+    void AppendString() const {
+        std::list<ErrorLogger::ErrorMessage::FileLocation> locs = { fooCpp5, barCpp8 };
+        ErrorMessage msg(locs, emptyString, Severity::error, "Programming error.", "errorId", true);
+        std::string buf("1: ");
+        msg.appendString(buf, false, "{file}:{line}:{column}: {inconclusive:inconclusive\\t}{severity} {unknown} {id}", "{file}:{line}: {info}");
+        ASSERT_EQUALS("1: bar.cpp:8:0: inconclusive\terror {unknown} errorId\n"
+                      "foo.cpp:5: Programming error.\n"
+                      "bar.cpp:8: Programming error.", buf);
+
+        buf = "2: ";
+        msg.appendString(buf, false);
+        ASSERT_EQUALS("2: [foo.cpp:5] -> [bar.cpp:8]: (error, inconclusive) Programming error.", buf);
+    }
+
     void InconclusiveXml() const {
         // Location
         std::list<ErrorLogger::ErrorMessage::FileLocation> locs(1, fooCpp5);
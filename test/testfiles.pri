@@ -15,7 +15,9 @@ SOURCES += $${BASEPATH}/test64bit.cpp \
            $${BASEPATH}/testcmdlineparser.cpp \
            $${BASEPATH}/testcondition.cpp \
            $${BASEPATH}/testconstructors.cpp \
+           $${BASEPATH}/testcounters.cpp \
            $${BASEPATH}/testcppcheck.cpp \
+           $${BASEPATH}/testdumpwriter.cpp \
            $${BASEPATH}/testerrorlogger.cpp \
            $${BASEPATH}/testexceptionsafety.cpp \
            $${BASEPATH}/testfilelister.cpp \
@@ -37,12 +39,16 @@ SOURCES += $${BASEPATH}/test64bit.cpp \
            $${BASEPATH}/testplatform.cpp \
            $${BASEPATH}/testpostfixoperator.cpp \
            $${BASEPATH}/testpreprocessor.cpp \
+           $${BASEPATH}/testresultwriter.cpp \
+           $${BASEPATH}/testrulematcher.cpp \
            $${BASEPATH}/testrunner.cpp \
            $${BASEPATH}/testsamples.cpp \
            $${BASEPATH}/testsimplifytemplate.cpp \
            $${BASEPATH}/testsimplifytokens.cpp \
            $${BASEPATH}/testsimplifytypedef.cpp \
            $${BASEPATH}/testsizeof.cpp \
+           $${BASEPATH}/testsmallvector.cpp \
+           $${BASEPATH}/teststablevector.cpp \
            $${BASEPATH}/teststl.cpp \
            $${BASEPATH}/teststring.cpp \
            $${BASEPATH}/testsuite.cpp \
@@ -20,12 +20,16 @@
 #include "library.h"
 #include "settings.h"
 #include "standards.h"
+#include "stringhashmap.h"
+#include "symboldatabase.h"
+#include "tempdirectory.h"
 #include "testsuite.h"
 #include "token.h"
 #include "tokenize.h"
 #include "tokenlist.h"
 
 #include <tinyxml2.h>
+#include <fstream>
 #include <map>
 #include <set>
 #include <string>
@@ -55,6 +59,7 @@ private:
         TEST_CASE(function_method);
         TEST_CASE(function_baseClassMethod); // calling method in base class
         TEST_CASE(function_warn);
+        TEST_CASE(function_resolvedCall);
         TEST_CASE(memory);
         TEST_CASE(memory2); // define extra "free" allocation functions
         TEST_CASE(memory3);
@@ -63,6 +68,8 @@ private:
         TEST_CASE(container);
         TEST_CASE(version);
         TEST_CASE(loadLibErrors);
+        TEST_CASE(cache);
+        TEST_CASE(stringHashMap);
     }
 
     static Library::Error readLibrary(Library& library, const char* xmldata) {
@@ -572,6 +579,47 @@ private:
         }
     }
 
+    void function_resolvedCall() const {
+        const char xmldata[] = "<?xml version=\"1.0\"?>\n"
+                               "<def>\n"
+                               "  <function name=\"foo\">\n"
+                               "    <arg nr=\"1\"><not-null/></arg>\n"
+                               "    <arg nr=\"2\"/>\n"
+                               "  </function>\n"
+                               "</def>";
+
+        Settings s;
+        ASSERT_EQUALS(true, Library::OK == (readLibrary(s.library, xmldata)).errorcode);
+        Tokenizer tokenizer(&s, nullptr);
+        std::istringstream istr("void f(int *p) { foo(p, 1); foo(p); }");
+        tokenizer.tokenize(istr, "test.cpp");
+        const SymbolDatabase *db = tokenizer.getSymbolDatabase();
+        const Token *foo1 = Token::findsimplematch(tokenizer.tokens(), "foo ( p ,");
+        const Token *foo2 = Token::findsimplematch(tokenizer.tokens(), "foo ( p )");
+
+        const Library::ResolvedCall *call1 = db->resolvedLibraryCall(foo1, &s.library);
+        ASSERT(call1 != nullptr);
+        if (call1) {
+            ASSERT_EQUALS("foo", call1->name);
+            ASSERT_EQUALS(false, call1->notLibraryFunction);
+            ASSERT(call1->function == &s.library.functions.at("foo"));
+        }
+        const Library::ResolvedCall *call2 = db->resolvedLibraryCall(foo2, &s.library);
+        ASSERT(call2 != nullptr);
+        if (call2) {
+            ASSERT_EQUALS(true, call2->notLibraryFunction); // wrong number of arguments
+            ASSERT(call2->function == nullptr);
+        }
+
+        ASSERT(s.library.isnullargbad(foo1, 1));
+        ASSERT(!s.library.isnullargbad(foo2, 1));
+
+        // another library is not using the cached calls
+        Library library;
+        ASSERT(db->resolvedLibraryCall(foo1, &library) == nullptr);
+        ASSERT(!library.isnullargbad(foo1, 1));
+    }
+
     void memory() const {
         const char xmldata[] = "<?xml version=\"1.0\"?>\n"
                                "<def>\n"
@@ -913,6 +961,109 @@ private:
         // comma followed by dot
         LOADLIB_ERROR_INVALID_RANGE("-10:0,.5:");
     }
+
+    static void writeFile(const std::string &filename, const char data[]) {
+        std::ofstream fout(filename.c_str(), std::ios::out | std::ios::trunc);
+        fout << data;
+    }
+
+    static bool fileExists(const std::string &filename) {
+        std::ifstream fin(filename.c_str());
+        return fin.is_open();
+    }
+
+    void cache() const {
+        const TempDirectory tempdir;
+        ASSERT(!tempdir.path().empty());
+        const std::string cfg = tempdir.file("testlibrary-cache.cfg");
+        writeFile(cfg, "<?xml version=\"1.0\"?>\n"
+                  "<def>\n"
+                  "  <memory><alloc init=\"false\">foo_alloc</alloc><dealloc>foo_free</dealloc></memory>\n"
+                  "  <define name=\"FOO\" value=\"1\"/>\n"
+                  "  <podtype name=\"foo_t\" size=\"4\" sign=\"u\"/>\n"
+                  "  <function name=\"foo\"><noreturn>false</noreturn><arg nr=\"1\"><not-null/><valid>0:10</valid></arg></function>\n"
+                  "  <container id=\"fooVector\" startPattern=\"fooVector &lt;\"><size><function name=\"size\" yields=\"size\"/></size></container>\n"
+                  "</def>");
+
+        // first load writes the cache
+        Library library1;
+        library1.setCacheDirectory(tempdir.path());
+        ASSERT_EQUALS(Library::OK, library1.load(nullptr, cfg.c_str()).errorcode);
+        const std::string cacheFile1 = library1.cacheFilename();
+        ASSERT(!cacheFile1.empty());
+        ASSERT(fileExists(cacheFile1));
+
+        // second load reads the cache
+        Library library2;
+        library2.setCacheDirectory(tempdir.path());
+        ASSERT_EQUALS(Library::OK, library2.load(nullptr, cfg.c_str()).errorcode);
+        ASSERT_EQUALS(cacheFile1, library2.cacheFilename());
+        ASSERT_EQUALS(1U, library2.functions.size());
+        ASSERT(library2.functions["foo"].argumentChecks[1].notnull);
+        ASSERT_EQUALS("0:10", library2.functions["foo"].argumentChecks[1].valid);
+        ASSERT_EQUALS(library1.allocId("foo_alloc"), library2.allocId("foo_alloc"));
+        ASSERT_EQUALS(library1.deallocId("foo_free"), library2.deallocId("foo_free"));
+        ASSERT_EQUALS(1U, library2.defines.size());
+        ASSERT(library2.podtype("foo_t") && library2.podtype("foo_t")->size == 4 && library2.podtype("foo_t")->sign == 'u');
+        ASSERT_EQUALS(Library::Container::SIZE, library2.containers["fooVector"].getYield("size"));
+        ASSERT_EQUALS(Library::OK, library2.load(nullptr, cfg.c_str()).errorcode); // duplicate
+
+        // modified file => cache entry is not used
+        writeFile(cfg, "<?xml version=\"1.0\"?>\n"
+                  "<def>\n"
+                  "  <function name=\"bar\"><noreturn>true</noreturn></function>\n"
+                  "</def>");
+        Library library3;
+        library3.setCacheDirectory(tempdir.path());
+        ASSERT_EQUALS(Library::OK, library3.load(nullptr, cfg.c_str()).errorcode);
+        ASSERT(cacheFile1 != library3.cacheFilename());
+        ASSERT_EQUALS(1U, library3.functions.size());
+        ASSERT_EQUALS(1U, library3.functions.count("bar"));
+
+        // same size, rewritten within the same second => cache entry is not used
+        writeFile(cfg, "<?xml version=\"1.0\"?>\n"
+                  "<def>\n"
+                  "  <function name=\"baz\"><noreturn>true</noreturn></function>\n"
+                  "</def>");
+        Library library4;
+        library4.setCacheDirectory(tempdir.path());
+        ASSERT_EQUALS(Library::OK, library4.load(nullptr, cfg.c_str()).errorcode);
+        ASSERT(library3.cacheFilename() != library4.cacheFilename());
+        ASSERT_EQUALS(1U, library4.functions.count("baz"));
+    }
+
+    void stringHashMap() const {
+        StringHashMap<int> map;
+        ASSERT(map.empty());
+        ASSERT(map.find("a") == map.end());
+
+        // enough entries to rehash a few times
+        for (int i = 0; i < 100; ++i)
+            map["f" + std::to_string(i)] = i;
+        int &f7 = map["f7"];
+        map["g"] = -1;
+        ASSERT_EQUALS(101U, map.size());
+        ASSERT(&f7 == &map["f7"]); // entries are not moved
+        for (int i = 0; i < 100; ++i)
+            ASSERT_EQUALS(i, map.at("f" + std::to_string(i)));
+
+        // lookup without std::string
+        const char key[] = "f42x";
+        ASSERT_EQUALS(42, map.find(key, 3, StringHashMap<int>::hash(key, 3))->second);
+        ASSERT(map.find(key) == map.end());
+        ASSERT_EQUALS(1U, map.count("g"));
+        ASSERT_EQUALS(0U, map.count("h"));
+
+        // insertion order
+        ASSERT_EQUALS("f0", map.begin()->first);
+
+        StringHashMap<int> copy;
+        copy = map;
+        map["f0"] = 1000;
+        ASSERT_EQUALS(0, copy.at("f0"));
+        ASSERT_EQUALS(101U, copy.size());
+        ASSERT_THROW(copy.at("h"), std::out_of_range);
+    }
 };
 
 REGISTER_TEST(TestLibrary)
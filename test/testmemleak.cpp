@@ -132,14 +132,35 @@ private:
     Settings settings2;
 
     void check(const char code[], bool c = false, bool posix = false, bool experimental = false, Settings *settings = nullptr) {
-        // Clear the error buffer..
-        errout.str("");
-
         if (!settings)
             settings = &settings1;
         settings->experimental = experimental;
         settings->standards.posix = posix;
 
+        runChecks(code, c, settings);
+
+        // The cfg engine must give the same results as simplifycode
+        if (settings->memleakEngine == Settings::MEMLEAK_SIMPLIFY) {
+            const std::string expected(errout.str());
+
+            Settings cfgSettings(*settings);
+            cfgSettings.memleakEngine = Settings::MEMLEAK_CFG;
+            runChecks(code, c, &cfgSettings);
+            ASSERT_EQUALS_MSG(expected, errout.str(), code);
+
+            // A disagreement is reported as a debug message
+            cfgSettings.memleakEngine = Settings::MEMLEAK_COMPARE;
+            runChecks(code, c, &cfgSettings);
+            ASSERT_EQUALS_MSG(expected, errout.str(), code);
+
+            errout.str(expected);
+        }
+    }
+
+    void runChecks(const char code[], bool c, const Settings *settings) {
+        // Clear the error buffer..
+        errout.str("");
+
         // Tokenize..
         Tokenizer tokenizer(settings, this);
         std::istringstream istr(code);
@@ -169,6 +190,8 @@ private:
 
         // Check that errors are found..
         TEST_CASE(findleak);
+        TEST_CASE(findleakCfg);
+        TEST_CASE(memleakEngine);
 
         TEST_CASE(simple5);
         TEST_CASE(simple7);
@@ -843,7 +866,7 @@ private:
 
 
     // is there a leak in given code? if so, return the linenr
-    unsigned int dofindleak(const char code[]) {
+    unsigned int dofindleak(const char code[], bool cfg = false) {
         // Clear the error buffer..
         errout.str("");
 
@@ -872,7 +895,9 @@ private:
             }
         }
 
-        const Token *tok = CheckMemoryLeakInFunction::findleak(tokens);
+        const Token *tok = cfg ?
+                           CheckMemoryLeakInFunction::findleakCfg(tokens, true, nullptr, nullptr) :
+                           CheckMemoryLeakInFunction::findleak(tokens);
 
         settings0.debugwarnings = false;
 
@@ -929,6 +954,82 @@ private:
         ASSERT_EQUALS(notfound, dofindleak("; alloc ; callfunc ; }"));
     }
 
+    void findleakCfg() {
+        static const unsigned int notfound = (unsigned int)(-1);
+
+        ASSERT_EQUALS(1,  dofindleak("alloc;", true));
+        ASSERT_EQUALS(1,  dofindleak("; use; { alloc; }", true));
+        ASSERT_EQUALS(2,  dofindleak("alloc;\n return;", true));
+        ASSERT_EQUALS(notfound, dofindleak("alloc; return use;", true));
+        ASSERT_EQUALS(2, dofindleak("alloc;\n callfunc;", true));
+        ASSERT_EQUALS(notfound, dofindleak("alloc; use;", true));
+        ASSERT_EQUALS(notfound, dofindleak("assign; if alloc; dealloc;", true));
+
+        // if..
+        ASSERT_EQUALS(2,  dofindleak("if alloc;\n return;", true));
+        ASSERT_EQUALS(notfound, dofindleak("alloc; ifv dealloc;", true));
+        ASSERT_EQUALS(2,  dofindleak("alloc;\n if return;\n dealloc;", true));
+        ASSERT_EQUALS(2,  dofindleak("alloc;\n if_var return;\n dealloc;", true));
+        ASSERT_EQUALS(3,  dofindleak("alloc;\n if\n return;\n dealloc;", true));
+        ASSERT_EQUALS(notfound, dofindleak("alloc; if { dealloc ; return; } dealloc;", true));
+        ASSERT_EQUALS(notfound, dofindleak("alloc;\n if(!var)\n { callfunc;\n return;\n }\n use;", true));
+        ASSERT_EQUALS(5, dofindleak("{\n;\n alloc;\n if dealloc;\n}", true));
+        ASSERT_EQUALS(3, dofindleak("alloc;\n if { return; }\n return; }", true));
+        ASSERT_EQUALS(2, dofindleak("; if { use; alloc; if { dealloc; }\n } ;\n }", true));
+
+        // assign..
+        ASSERT_EQUALS(2,  dofindleak("alloc;\n assign;\n dealloc;", true));
+        ASSERT_EQUALS(notfound, dofindleak("alloc;\n if(!var) assign;\n dealloc;", true));
+
+        // loop..
+        ASSERT_EQUALS(1, dofindleak("; loop alloc ;", true));
+        ASSERT_EQUALS(1, dofindleak("; loop alloc ; dealloc ;", true));
+        ASSERT_EQUALS(notfound, dofindleak("; loop { alloc ; dealloc ; }", true));
+        ASSERT_EQUALS(2, dofindleak("; alloc ; loop {\n if break ; return ; }", true));
+        ASSERT_EQUALS(notfound, dofindleak("; alloc ; while1 { if { dealloc ; return ; } }", true));
+        ASSERT_EQUALS(notfound, dofindleak("; assign ; loop !var { alloc ; } return use ; }", true));
+        ASSERT_EQUALS(2, dofindleak("; assign ; loop !var { alloc ; }\n }", true));
+
+        // switch..
+        ASSERT_EQUALS(2, dofindleak("; alloc ; switch { case ; dealloc ; break ; default ;\n return ; } dealloc ;", true));
+        ASSERT_EQUALS(notfound, dofindleak("; alloc ; switch { case ; return use ; } dealloc ;", true));
+
+        // try/catch..
+        ASSERT_EQUALS(notfound, dofindleak("; alloc ; try { throw ; } catch { dealloc ; return ; } dealloc ;", true));
+        ASSERT_EQUALS(2, dofindleak("; alloc ; try { throw ; } catch {\n return ; } dealloc ;", true));
+
+        // callfunc (might be noreturn)
+        ASSERT_EQUALS(notfound, dofindleak("; alloc ; callfunc ; }", true));
+
+        // goto => bailout
+        ASSERT_EQUALS(notfound, dofindleak("; alloc ; goto ; }", true));
+    }
+
+    void memleakEngine() {
+        const char code[] = "void f(int x) {\n"
+                            "    char *p = malloc(10);\n"
+                            "    if (x)\n"
+                            "        return;\n"
+                            "    free(p);\n"
+                            "}";
+        Settings settings(settings1);
+        settings.memleakEngine = Settings::MEMLEAK_CFG;
+        check(code, false, false, false, &settings);
+        ASSERT_EQUALS("[test.cpp:4]: (error) Memory leak: p\n", errout.str());
+
+        settings.memleakEngine = Settings::MEMLEAK_COMPARE;
+        settings.debugwarnings = true;
+        check(code, false, false, false, &settings);
+        ASSERT_EQUALS("[test.cpp:4]: (error) Memory leak: p\n", errout.str());
+
+        check("void f() {\n"
+              "    char *p = malloc(10);\n"
+              "    free(p);\n"
+              "    free(p);\n"
+              "}", false, false, false, &settings);
+        ASSERT_EQUALS("[test.cpp:4]: (error) Deallocating a deallocated pointer: p\n", errout.str());
+    }
+
 
     void simple5() {
         check("static char *f()\n"
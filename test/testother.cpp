@@ -2700,6 +2700,28 @@ private:
               "}");
         ASSERT_EQUALS("", errout.str()); // #3457
 
+        // the loop is entered through another goto
+        check("void f(int x) {\n"
+              "    goto L1;\n"
+              "    while (x) {\n"
+              "L2:\n"
+              "        g();\n"
+              "    }\n"
+              "L1:\n"
+              "    goto L2;\n"
+              "}");
+        ASSERT_EQUALS("", errout.str());
+
+        check("void f(int x) {\n"
+              "    goto L1;\n"
+              "    while (x) {\n"
+              "        g();\n"
+              "    }\n"
+              "L1:\n"
+              "    return;\n"
+              "}");
+        ASSERT_EQUALS("[test.cpp:3]: (style) Statements following return, break, continue, goto or throw will never be executed.\n", errout.str());
+
         // #3383. TODO: Use preprocessor
         check("int foo() {\n"
               "\n" // #ifdef A
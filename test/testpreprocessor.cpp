@@ -23,16 +23,23 @@
 #include "platform.h"
 #include "preprocessor.h"
 #include "settings.h"
+#include "tempdirectory.h"
 #include "testsuite.h"
 
 #include <simplecpp.h>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <list>
 #include <map>
 #include <set>
 #include <string>
 #include <vector>
 
+#if !defined(_WIN32) && !defined(__APPLE__)
+#include <utime.h>
+#endif
+
 class ErrorLogger;
 
 class TestPreprocessor : public TestFixture {
@@ -248,6 +255,9 @@ private:
         TEST_CASE(testDirectiveIncludeComments);
 
         TEST_CASE(testSameLine);  // #7912
+
+        TEST_CASE(includeCache);
+        TEST_CASE(includeCacheDirectoryTime);
     }
 
     void preprocess(const char* code, std::map<std::string, std::string>& actual, const char filename[] = "file.c") {
@@ -2386,6 +2396,86 @@ private:
         ASSERT_EQUALS(exp, preprocessor.getcode(code, "", "test.cpp"));
     }
 
+    static std::string preprocessIncludes(const char code[], const std::list<std::string> &includePaths) {
+        std::istringstream istr(code);
+        std::vector<std::string> files;
+        simplecpp::OutputList outputList;
+        const simplecpp::TokenList tokens1(istr, files, "file.c", &outputList);
+        simplecpp::DUI dui;
+        dui.includePaths = includePaths;
+        std::map<std::string, simplecpp::TokenList*> filedata;
+        simplecpp::TokenList tokens2(files);
+        simplecpp::preprocess(tokens2, tokens1, files, filedata, dui, &outputList);
+        simplecpp::cleanup(filedata);
+        std::string ret;
+        for (const simplecpp::Token *tok = tokens2.cfront(); tok; tok = tok->next)
+            ret += (ret.empty() ? "" : " ") + tok->str();
+        return ret;
+    }
+
+    static void writeFile(const std::string &filename, const char data[]) {
+        std::ofstream fout(filename.c_str(), std::ios::out | std::ios::trunc);
+        fout << data;
+    }
+
+    void includeCache() {
+        const TempDirectory dir1;
+        const TempDirectory dir2;
+        ASSERT(!dir1.path().empty() && !dir2.path().empty());
+        std::list<std::string> includePaths;
+        includePaths.push_back(dir1.path());
+        includePaths.push_back(dir2.path());
+        const char code[] = "#include <cache.h>\n";
+        simplecpp::clearIncludeCache();
+
+        // the header is not found
+        ASSERT_EQUALS("", preprocessIncludes(code, includePaths));
+
+        // a header that is added later is found, the cache is dropped when the directory is modified
+        writeFile(dir2.file("cache.h"), "int two;");
+        ASSERT_EQUALS("int two ;", preprocessIncludes(code, includePaths));
+        writeFile(dir1.file("cache.h"), "int one;");
+        ASSERT_EQUALS("int one ;", preprocessIncludes(code, includePaths));
+
+        // cached header was removed => it is searched again
+        std::remove(dir1.file("cache.h").c_str());
+        ASSERT_EQUALS("int two ;", preprocessIncludes(code, includePaths));
+
+        simplecpp::clearIncludeCache();
+    }
+
+    static void setModificationTime(const std::string &path, time_t t) {
+#if !defined(_WIN32) && !defined(__APPLE__)
+        struct utimbuf times;
+        times.actime = t;
+        times.modtime = t;
+        utime(path.c_str(), &times);
+#endif
+    }
+
+    void includeCacheDirectoryTime() {
+#if !defined(_WIN32) && !defined(__APPLE__)
+        const TempDirectory dir;
+        ASSERT(!dir.path().empty());
+        std::list<std::string> includePaths;
+        includePaths.push_back(dir.path());
+        const char code[] = "#include <cache.h>\n";
+        setModificationTime(dir.path(), 1000000000);
+        simplecpp::clearIncludeCache();
+        ASSERT_EQUALS("", preprocessIncludes(code, includePaths));
+
+        // the directory time is unchanged => the cached lookup is used
+        writeFile(dir.file("cache.h"), "int x;");
+        setModificationTime(dir.path(), 1000000000);
+        ASSERT_EQUALS("", preprocessIncludes(code, includePaths));
+
+        // the directory was modified => the header is searched again
+        setModificationTime(dir.path(), 1000000010);
+        ASSERT_EQUALS("int x ;", preprocessIncludes(code, includePaths));
+
+        simplecpp::clearIncludeCache();
+#endif
+    }
 };
 
 REGISTER_TEST(TestPreprocessor)
@@ -0,0 +1,133 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "resultwriter.h"
+#include "testsuite.h"
+
+#include <sstream>
+#include <string>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+class TestResultWriter : public TestFixture {
+public:
+    TestResultWriter() : TestFixture("TestResultWriter") {
+    }
+
+private:
+
+    void run() override {
+        TEST_CASE(buffered);
+        TEST_CASE(fullBuffer);
+        TEST_CASE(setStream);
+        TEST_CASE(flushAfterSignal);
+        TEST_CASE(destructor);
+    }
+
+    void buffered() const {
+        std::ostringstream out;
+        ResultWriter writer(out);
+        writer.writeLine("a.c:1: error");
+        writer.writeLine("a.c:2: error");
+        ASSERT_EQUALS("", out.str());
+        writer.flush();
+        ASSERT_EQUALS("a.c:1: error\na.c:2: error\n", out.str());
+        writer.flush();
+        ASSERT_EQUALS("a.c:1: error\na.c:2: error\n", out.str());
+    }
+
+    void fullBuffer() const {
+        std::ostringstream out;
+        ResultWriter writer(out);
+        const std::string line(99, 'x');
+        std::size_t written = 0;
+        while (written + 100 < ResultWriter::BUFFER_SIZE) {
+            writer.writeLine(line);
+            written += 100;
+        }
+        ASSERT_EQUALS(0U, out.str().size());
+        writer.writeLine(line);
+        ASSERT_EQUALS(written + 100, out.str().size());
+    }
+
+    void setStream() const {
+        std::ostringstream out1, out2;
+        ResultWriter writer(out1);
+        writer.writeLine("1");
+        writer.setStream(out2);
+        writer.writeLine("2");
+        writer.flush();
+        ASSERT_EQUALS("1\n", out1.str());
+        ASSERT_EQUALS("2\n", out2.str());
+    }
+
+    void flushAfterSignal() const {
+        int fds[2];
+#ifdef _WIN32
+        ASSERT_EQUALS(0, _pipe(fds, 4096, _O_BINARY));
+#else
+        ASSERT_EQUALS(0, pipe(fds));
+#endif
+        std::ostringstream out;
+        ResultWriter writer(out, fds[1]);
+        writer.writeLine("1");
+        writer.writeLine("2");
+        writer.flushAfterSignal();
+
+        // the lines are written to the file descriptor, not to the stream
+        char buf[16] = {0};
+#ifdef _WIN32
+        const int n = _read(fds[0], buf, sizeof(buf) - 1);
+        _close(fds[0]);
+        _close(fds[1]);
+#else
+        const int n = read(fds[0], buf, sizeof(buf) - 1);
+        close(fds[0]);
+        close(fds[1]);
+#endif
+        ASSERT_EQUALS(4, n);
+        ASSERT_EQUALS("1\n2\n", buf);
+        ASSERT_EQUALS("", out.str());
+        writer.flush();
+        ASSERT_EQUALS("", out.str());
+
+        // nothing is written without file descriptor, the lines stay buffered
+        ResultWriter writer2(out);
+        writer2.writeLine("3");
+        writer2.flushAfterSignal();
+        ASSERT_EQUALS("", out.str());
+        writer2.flush();
+        ASSERT_EQUALS("3\n", out.str());
+    }
+
+    void destructor() const {
+        std::ostringstream out;
+        {
+            ResultWriter writer(out);
+            writer.writeLine("1");
+        }
+        ASSERT_EQUALS("1\n", out.str());
+    }
+};
+
+REGISTER_TEST(TestResultWriter)
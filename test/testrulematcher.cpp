@@ -0,0 +1,167 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rulematcher.h"
+#include "settings.h"
+#include "testsuite.h"
+
+#include <list>
+#include <string>
+#include <vector>
+
+class TestRuleMatcher : public TestFixture {
+public:
+    TestRuleMatcher() : TestFixture("TestRuleMatcher") {
+    }
+
+private:
+
+    void run() override {
+        TEST_CASE(requiredLiteral);
+        TEST_CASE(requiredLiteralQuantifiers);
+        TEST_CASE(requiredLiteralUnknown);
+        TEST_CASE(multiStringMatcher);
+        TEST_CASE(multiStringMatcherOverlap);
+#ifdef HAVE_RULES
+        TEST_CASE(compiledFrom);
+        TEST_CASE(matchThreads);
+#endif
+    }
+
+    void requiredLiteral() const {
+        ASSERT_EQUALS("strcpy (", RuleMatcher::requiredLiteral("strcpy \\("));
+        ASSERT_EQUALS(" == NULL", RuleMatcher::requiredLiteral("[a-z]+ == NULL"));
+        ASSERT_EQUALS("if ( ", RuleMatcher::requiredLiteral("\\bif \\( \\w+ \\)"));
+        ASSERT_EQUALS("alloc ( 1", RuleMatcher::requiredLiteral("= (m|c)alloc \\( 1"));
+        ASSERT_EQUALS("; } ", RuleMatcher::requiredLiteral("^; } .*$"));
+        ASSERT_EQUALS("[", RuleMatcher::requiredLiteral("\\[[]x]"));
+        ASSERT_EQUALS("abc", RuleMatcher::requiredLiteral("abc"));
+        ASSERT_EQUALS("", RuleMatcher::requiredLiteral(""));
+    }
+
+    void requiredLiteralQuantifiers() const {
+        // the character before an optional quantifier is not required
+        ASSERT_EQUALS("ab", RuleMatcher::requiredLiteral("abc*"));
+        ASSERT_EQUALS("ab", RuleMatcher::requiredLiteral("abc?d"));
+        ASSERT_EQUALS("ab", RuleMatcher::requiredLiteral("abc{0,2}d"));
+        ASSERT_EQUALS("abc", RuleMatcher::requiredLiteral("abc+d"));
+        ASSERT_EQUALS("abc", RuleMatcher::requiredLiteral("abc{2}d"));
+        ASSERT_EQUALS("ab", RuleMatcher::requiredLiteral("abc*?d"));
+        ASSERT_EQUALS("x{y", RuleMatcher::requiredLiteral("x{y"));
+        ASSERT_EQUALS("abcd", RuleMatcher::requiredLiteral("(ab)?abcd"));
+    }
+
+    void requiredLiteralUnknown() const {
+        // no literal is returned when the pattern could match without it
+        ASSERT_EQUALS("", RuleMatcher::requiredLiteral("free|delete"));
+        ASSERT_EQUALS("", RuleMatcher::requiredLiteral("(?i)malloc"));
+        ASSERT_EQUALS("", RuleMatcher::requiredLiteral("a(?=b)"));
+        ASSERT_EQUALS("", RuleMatcher::requiredLiteral("\\x41BC"));
+        ASSERT_EQUALS("", RuleMatcher::requiredLiteral("\\Qa.b\\E"));
+        ASSERT_EQUALS("", RuleMatcher::requiredLiteral("(abc"));
+        ASSERT_EQUALS("", RuleMatcher::requiredLiteral("[abc"));
+        ASSERT_EQUALS("", RuleMatcher::requiredLiteral("abc\\"));
+    }
+
+    static std::string found(const std::vector<std::string> &strings, const std::string &text) {
+        const MultiStringMatcher matcher(strings);
+        const std::vector<bool> result = matcher.find(text);
+        std::string ret;
+        for (std::size_t i = 0; i < result.size(); ++i)
+            ret += result[i] ? '1' : '0';
+        return ret;
+    }
+
+    void multiStringMatcher() const {
+        std::vector<std::string> strings;
+        strings.push_back("malloc (");
+        strings.push_back("free (");
+        strings.push_back("strcpy");
+        strings.push_back("");
+        ASSERT_EQUALS("0101", found(strings, "int * p ; free ( p ) ;"));
+        ASSERT_EQUALS("1111", found(strings, "p = malloc ( 10 ) ; strcpy ( p , s ) ; free ( p ) ;"));
+        ASSERT_EQUALS("0001", found(strings, ""));
+        ASSERT_EQUALS("0001", found(strings, "mallo ( fre ("));
+        ASSERT_EQUALS("", found(std::vector<std::string>(), "abc"));
+    }
+
+    void multiStringMatcherOverlap() const {
+        std::vector<std::string> strings;
+        strings.push_back("he");
+        strings.push_back("she");
+        strings.push_back("his");
+        strings.push_back("hers");
+        strings.push_back("e");
+        ASSERT_EQUALS("11011", found(strings, "ushers"));
+        ASSERT_EQUALS("00100", found(strings, "xhisx"));
+        ASSERT_EQUALS("10011", found(strings, "hhhers"));
+        ASSERT_EQUALS("00000", found(strings, "s h i s"));
+    }
+
+#ifdef HAVE_RULES
+    static Settings::Rule rule(const char pattern[], const char id[]) {
+        Settings::Rule r;
+        r.pattern = pattern;
+        r.id = id;
+        return r;
+    }
+
+    void compiledFrom() const {
+        std::list<Settings::Rule> rules;
+        rules.push_back(rule("malloc", "m"));
+        const RuleMatcher matcher(rules);
+        ASSERT(matcher.compiledFrom(rules));
+
+        // same number of rules, but a different pattern
+        rules.front().pattern = "free";
+        ASSERT(!matcher.compiledFrom(rules));
+        rules.front().pattern = "malloc";
+        rules.front().severity = Severity::warning;
+        ASSERT(!matcher.compiledFrom(rules));
+        rules.push_back(rule("free", "f"));
+        ASSERT(!matcher.compiledFrom(rules));
+    }
+
+    static std::string matches(const RuleMatcher &matcher, const std::string &subject, unsigned int threads) {
+        const std::vector<RuleMatcher::Result> results = matcher.match("simple", subject, threads);
+        std::string ret;
+        for (std::size_t i = 0; i < results.size(); ++i)
+            ret += results[i].rule->id + ":" + std::to_string(results[i].begin) + " ";
+        return ret;
+    }
+
+    void matchThreads() const {
+        std::list<Settings::Rule> rules;
+        rules.push_back(rule("malloc", "m"));
+        rules.push_back(rule("free", "f"));
+        rules.push_back(rule("p", "p"));
+        rules.push_back(rule("strcpy", "s"));
+        const RuleMatcher matcher(rules);
+        const std::string subject = " p = malloc ( 1 ) ; free ( p ) ;";
+
+        // the results are ordered by rule, whatever the number of threads
+        const std::string expected = "m:5 f:20 p:1 p:27 ";
+        ASSERT_EQUALS(expected, matches(matcher, subject, 1));
+        ASSERT_EQUALS(expected, matches(matcher, subject, 2));
+        ASSERT_EQUALS(expected, matches(matcher, subject, 8));
+        ASSERT_EQUALS(expected, matches(matcher, subject, 0));
+    }
+#endif
+};
+
+REGISTER_TEST(TestRuleMatcher)
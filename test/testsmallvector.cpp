@@ -0,0 +1,162 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "smallvector.h"
+#include "testsuite.h"
+
+#include <string>
+#include <vector>
+
+class TestSmallVector : public TestFixture {
+public:
+    TestSmallVector() : TestFixture("TestSmallVector") {
+    }
+
+private:
+
+    void run() override {
+        TEST_CASE(inlineStorage);
+        TEST_CASE(growth);
+        TEST_CASE(insertAndErase);
+        TEST_CASE(destruction);
+        TEST_CASE(copyAndCompare);
+    }
+
+    void inlineStorage() const {
+        SmallVector<std::string, 1> v;
+        ASSERT_EQUALS(true, v.empty());
+        ASSERT_EQUALS(true, v.begin() == v.end());
+        v.push_back("a");
+        ASSERT_EQUALS(1U, v.size());
+        ASSERT_EQUALS(true, v.isInline());
+        // the element is stored in the container itself
+        const char *p = reinterpret_cast<const char *>(&v.front());
+        const char *self = reinterpret_cast<const char *>(&v);
+        ASSERT_EQUALS(true, p >= self && p < self + sizeof(v));
+        ASSERT_EQUALS("a", v[0]);
+    }
+
+    void growth() const {
+        SmallVector<std::string, 1> v;
+        for (int i = 0; i < 100; ++i)
+            v.emplace_back(std::to_string(i));
+        ASSERT_EQUALS(100U, v.size());
+        ASSERT_EQUALS(false, v.isInline());
+        ASSERT_EQUALS(true, v.capacity() >= 100U);
+        for (int i = 0; i < 100; ++i)
+            ASSERT_EQUALS(std::to_string(i), v[i]);
+        ASSERT_EQUALS("0", v.front());
+        ASSERT_EQUALS("99", v.back());
+
+        // an element of the container is added while it grows
+        SmallVector<std::string, 1> w(1, "x");
+        w.push_back(w.front());
+        ASSERT_EQUALS(2U, w.size());
+        ASSERT_EQUALS("x", w.back());
+
+        std::vector<std::string> backward;
+        for (SmallVector<std::string, 1>::const_reverse_iterator it = v.rbegin(); it != v.rend(); ++it)
+            backward.push_back(*it);
+        ASSERT_EQUALS(100U, backward.size());
+        ASSERT_EQUALS("99", backward.front());
+    }
+
+    void insertAndErase() const {
+        SmallVector<int, 1> v;
+        v.push_back(2);
+        v.insert(v.begin(), 1);
+        v.insert(v.end(), 3);
+        ASSERT_EQUALS(3U, v.size());
+        for (int i = 0; i < 3; ++i)
+            ASSERT_EQUALS(i + 1, v[i]);
+
+        v.erase(v.begin() + 1);
+        ASSERT_EQUALS(2U, v.size());
+        ASSERT_EQUALS(1, v.front());
+        ASSERT_EQUALS(3, v.back());
+
+        for (int i = 4; i < 10; ++i)
+            v.push_back(i);
+        v.remove_if([](int i) {
+            return i % 2 == 0;
+        });
+        ASSERT_EQUALS(5U, v.size());
+        for (int i = 0; i < 5; ++i)
+            ASSERT_EQUALS(2 * i + 1, v[i]);
+
+        v.clear();
+        ASSERT_EQUALS(true, v.empty());
+    }
+
+    struct Counted {
+        explicit Counted(int *count_) : count(count_) {
+            ++*count;
+        }
+        Counted(const Counted &other) : count(other.count) {
+            ++*count;
+        }
+        Counted &operator=(const Counted &other) {
+            count = other.count;
+            return *this;
+        }
+        ~Counted() {
+            --*count;
+        }
+        int *count;
+    };
+
+    void destruction() const {
+        int count = 0;
+        {
+            SmallVector<Counted, 1> v;
+            v.emplace_back(&count);
+            ASSERT_EQUALS(1, count);
+            for (int i = 0; i < 20; ++i)
+                v.emplace_back(&count);
+            // the elements that were moved to the heap were destroyed
+            ASSERT_EQUALS(21, count);
+            v.erase(v.begin(), v.begin() + 5);
+            ASSERT_EQUALS(16, count);
+            v.pop_back();
+            ASSERT_EQUALS(15, count);
+        }
+        // destructor
+        ASSERT_EQUALS(0, count);
+    }
+
+    void copyAndCompare() const {
+        SmallVector<std::string, 1> v;
+        v.push_back("a");
+        const SmallVector<std::string, 1> copy(v);
+        ASSERT_EQUALS(true, copy == v);
+        ASSERT_EQUALS(true, copy.isInline());
+
+        v.push_back("b");
+        ASSERT_EQUALS(true, copy != v);
+        SmallVector<std::string, 1> assigned;
+        assigned = v;
+        ASSERT_EQUALS(true, assigned == v);
+        ASSERT_EQUALS("b", assigned.back());
+
+        const std::vector<std::string> items(v.begin(), v.end());
+        const SmallVector<std::string, 1> range(items.begin(), items.end());
+        ASSERT_EQUALS(true, range == v);
+    }
+};
+
+REGISTER_TEST(TestSmallVector)
@@ -0,0 +1,169 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "stablevector.h"
+#include "testsuite.h"
+
+#include <string>
+#include <vector>
+
+class TestStableVector : public TestFixture {
+public:
+    TestStableVector() : TestFixture("TestStableVector") {
+    }
+
+private:
+
+    void run() override {
+        TEST_CASE(addressStability);
+        TEST_CASE(iterators);
+        TEST_CASE(removal);
+        TEST_CASE(copyAndMove);
+    }
+
+    void addressStability() const {
+        StableVector<std::string> v;
+        ASSERT_EQUALS(true, v.empty());
+        std::vector<const std::string *> addresses;
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(std::to_string(i));
+            addresses.push_back(&v.back());
+        }
+        ASSERT_EQUALS(1000U, v.size());
+
+        // the elements were not moved when chunks were added
+        int i = 0;
+        for (const std::string &s : v) {
+            ASSERT_EQUALS(true, addresses[i] == &s);
+            ASSERT_EQUALS(std::to_string(i), s);
+            ++i;
+        }
+        ASSERT_EQUALS(1000, i);
+        ASSERT_EQUALS("0", v.front());
+        ASSERT_EQUALS("999", v.back());
+    }
+
+    void iterators() const {
+        StableVector<int> v;
+        ASSERT_EQUALS(true, v.begin() == v.end());
+        for (int i = 0; i < 10; ++i)
+            v.emplace_back(i);
+
+        // forward, over the chunk boundaries
+        std::vector<int> forward;
+        for (StableVector<int>::const_iterator it = v.cbegin(); it != v.cend(); ++it)
+            forward.push_back(*it);
+        ASSERT_EQUALS(10U, forward.size());
+        for (int i = 0; i < 10; ++i)
+            ASSERT_EQUALS(i, forward[i]);
+
+        // backward
+        std::vector<int> backward;
+        for (StableVector<int>::reverse_iterator it = v.rbegin(); it != v.rend(); ++it)
+            backward.push_back(*it);
+        ASSERT_EQUALS(10U, backward.size());
+        for (int i = 0; i < 10; ++i)
+            ASSERT_EQUALS(9 - i, backward[i]);
+
+        // write through iterator, an iterator stays valid when elements are added
+        StableVector<int>::iterator it = v.begin();
+        ++it;
+        *it = 100;
+        for (int i = 0; i < 100; ++i)
+            v.push_back(i);
+        ASSERT_EQUALS(100, *it);
+        ASSERT_EQUALS(100, *++v.begin());
+        StableVector<int>::const_iterator cit = it;
+        ASSERT_EQUALS(0, *--cit);
+    }
+
+    struct Counted {
+        explicit Counted(int *count_) : count(count_) {
+            ++*count;
+        }
+        Counted(const Counted &other) : count(other.count) {
+            ++*count;
+        }
+        ~Counted() {
+            --*count;
+        }
+        int *count;
+    };
+
+    void removal() const {
+        int count = 0;
+        {
+            StableVector<Counted> v;
+            for (int i = 0; i < 20; ++i)
+                v.emplace_back(&count);
+            ASSERT_EQUALS(20, count);
+            const Counted *first = &v.front();
+
+            // elements are removed at the end, across chunk boundaries
+            for (int i = 0; i < 13; ++i)
+                v.pop_back();
+            ASSERT_EQUALS(7, count);
+            ASSERT_EQUALS(7U, v.size());
+            ASSERT_EQUALS(true, first == &v.front());
+            int n = 0;
+            for (StableVector<Counted>::const_iterator it = v.begin(); it != v.end(); ++it)
+                ++n;
+            ASSERT_EQUALS(7, n);
+
+            // the freed room is reused
+            v.emplace_back(&count);
+            ASSERT_EQUALS(8U, v.size());
+            ASSERT_EQUALS(true, first == &v.front());
+
+            v.clear();
+            ASSERT_EQUALS(0, count);
+            ASSERT_EQUALS(true, v.empty());
+            ASSERT_EQUALS(true, v.begin() == v.end());
+
+            v.emplace_back(&count);
+            ASSERT_EQUALS(1U, v.size());
+        }
+        // destructor
+        ASSERT_EQUALS(0, count);
+    }
+
+    void copyAndMove() const {
+        StableVector<std::string> v;
+        v.push_back("a");
+        v.push_back("b");
+        v.push_back("c");
+        const std::string *b = &*++v.begin();
+
+        const StableVector<std::string> copy(v);
+        ASSERT_EQUALS(3U, copy.size());
+        ASSERT_EQUALS("c", copy.back());
+        ASSERT_EQUALS(true, b != &*++copy.begin());
+
+        // moving keeps the elements where they are
+        StableVector<std::string> moved(std::move(v));
+        ASSERT_EQUALS(3U, moved.size());
+        ASSERT_EQUALS(true, b == &*++moved.begin());
+
+        StableVector<std::string> assigned;
+        assigned = copy;
+        ASSERT_EQUALS(3U, assigned.size());
+        ASSERT_EQUALS("a", assigned.front());
+    }
+};
+
+REGISTER_TEST(TestStableVector)
@@ -26,6 +26,7 @@
 #include "tokenlist.h"
 #include "utils.h"
 
+#include <algorithm>
 #include <climits>
 #include <cstddef>
 #include <list>
@@ -75,7 +76,7 @@ private:
     }
 
     static const Scope *findFunctionScopeByToken(const SymbolDatabase * db, const Token *tok) {
-        std::list<Scope>::const_iterator scope;
+        StableVector<Scope>::const_iterator scope;
 
         for (scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
             if (scope->type == Scope::eFunction) {
@@ -95,7 +96,7 @@ private:
                 currScope = currScope->nestedIn;
         }
         while (currScope) {
-            for (std::list<Function>::const_iterator i = currScope->functionList.begin(); i != currScope->functionList.end(); ++i) {
+            for (StableVector<Function>::const_iterator i = currScope->functionList.begin(); i != currScope->functionList.end(); ++i) {
                 if (i->tokenDef->str() == str)
                     return &*i;
             }
@@ -334,6 +335,7 @@ private:
         TEST_CASE(findFunction18);
         TEST_CASE(findFunction19);
         TEST_CASE(findFunction20); // #8280
+        TEST_CASE(findVariableAndRecord); // many members
 
         TEST_CASE(noexceptFunction1);
         TEST_CASE(noexceptFunction2);
@@ -385,6 +387,11 @@ private:
         TEST_CASE(using1);
         TEST_CASE(using2); // #8331 (segmentation fault)
         TEST_CASE(using3); // #8343 (segmentation fault)
+
+        TEST_CASE(controlFlowGraph);
+        TEST_CASE(controlFlowGraphTryGoto);
+        TEST_CASE(controlFlowGraphNoreturn);
+        TEST_CASE(defUseIndex);
     }
 
     void array() {
@@ -1434,8 +1441,8 @@ private:
 
         if (db) {
             bool seen_something = false;
-            for (std::list<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
-                for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+            for (StableVector<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
+                for (StableVector<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
                     ASSERT_EQUALS("Sub", func->token->str());
                     ASSERT_EQUALS(true, func->hasBody());
                     ASSERT_EQUALS(Function::eConstructor, func->type);
@@ -1708,10 +1715,10 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
         if (db && db->scopeList.size() == 1) {
-            std::list<Scope>::const_iterator it = db->scopeList.begin();
+            StableVector<Scope>::const_iterator it = db->scopeList.begin();
             ASSERT(it->varlist.size() == 1);
             if (it->varlist.size() == 1) {
-                std::list<Variable>::const_iterator var = it->varlist.begin();
+                StableVector<Variable>::const_iterator var = it->varlist.begin();
                 ASSERT(var->name() == "i");
                 ASSERT(var->typeStartToken()->str() == "int");
             }
@@ -1723,10 +1730,10 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
         if (db && db->scopeList.size() == 1) {
-            std::list<Scope>::const_iterator it = db->scopeList.begin();
+            StableVector<Scope>::const_iterator it = db->scopeList.begin();
             ASSERT(it->varlist.size() == 1);
             if (it->varlist.size() == 1) {
-                std::list<Variable>::const_iterator var = it->varlist.begin();
+                StableVector<Variable>::const_iterator var = it->varlist.begin();
                 ASSERT(var->name() == "array");
                 ASSERT(var->typeStartToken()->str() == "int");
             }
@@ -1738,10 +1745,10 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
         if (db && db->scopeList.size() == 1) {
-            std::list<Scope>::const_iterator it = db->scopeList.begin();
+            StableVector<Scope>::const_iterator it = db->scopeList.begin();
             ASSERT(it->varlist.size() == 1);
             if (it->varlist.size() == 1) {
-                std::list<Variable>::const_iterator var = it->varlist.begin();
+                StableVector<Variable>::const_iterator var = it->varlist.begin();
                 ASSERT(var->name() == "array");
                 ASSERT(var->typeStartToken()->str() == "int");
             }
@@ -2085,7 +2092,7 @@ private:
         if (db) {
             ASSERT_EQUALS(3, db->scopeList.size());
             if (db->scopeList.size() == 3) {
-                std::list<Scope>::const_iterator scope = db->scopeList.begin();
+                StableVector<Scope>::const_iterator scope = db->scopeList.begin();
                 ++scope;
                 ASSERT_EQUALS((unsigned int)Scope::eClass, (unsigned int)scope->type);
                 ASSERT_EQUALS(1, scope->functionList.size());
@@ -2109,7 +2116,7 @@ private:
         if (db) {
             ASSERT_EQUALS(3, db->scopeList.size());
             if (db->scopeList.size() == 3) {
-                std::list<Scope>::const_iterator scope = db->scopeList.begin();
+                StableVector<Scope>::const_iterator scope = db->scopeList.begin();
                 ++scope;
                 ASSERT_EQUALS((unsigned int)Scope::eClass, (unsigned int)scope->type);
                 ASSERT_EQUALS(1, scope->functionList.size());
@@ -2206,7 +2213,7 @@ private:
 
         // Locate the scope for the class..
         const Scope *scope = nullptr;
-        for (std::list<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
+        for (StableVector<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
             if (it->isClassOrStruct()) {
                 scope = &(*it);
                 break;
@@ -2240,7 +2247,7 @@ private:
 
         // Locate the scope for the class..
         const Scope *scope = nullptr;
-        for (std::list<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
+        for (StableVector<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
             if (it->isClassOrStruct()) {
                 scope = &(*it);
                 break;
@@ -2529,7 +2536,7 @@ private:
 
         // Find the scope for the Fred struct..
         const Scope *fredScope = nullptr;
-        for (std::list<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
+        for (StableVector<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
             if (scope->isClassOrStruct() && scope->className == "Fred")
                 fredScope = &(*scope);
         }
@@ -2543,7 +2550,7 @@ private:
         // Get linenumbers where the bodies for the constructor and destructor are..
         unsigned int constructor = 0;
         unsigned int destructor = 0;
-        for (std::list<Function>::const_iterator it = fredScope->functionList.begin(); it != fredScope->functionList.end(); ++it) {
+        for (StableVector<Function>::const_iterator it = fredScope->functionList.begin(); it != fredScope->functionList.end(); ++it) {
             if (it->type == Function::eConstructor)
                 constructor = it->token->linenr();  // line number for constructor body
             if (it->type == Function::eDestructor)
@@ -2636,7 +2643,7 @@ private:
         ASSERT(db && db->typeList.size() == 5);
         if (!db || db->typeList.size() < 5)
             return;
-        std::list<Type>::const_iterator i = db->typeList.begin();
+        StableVector<Type>::const_iterator i = db->typeList.begin();
         const Type* Foo = &(*i++);
         const Type* Bar = &(*i++);
         const Type* Sub = &(*i++);
@@ -2705,7 +2712,7 @@ private:
         ASSERT(db && db->typeList.size() == 3);
         if (!db || db->typeList.size() != 3)
             return;
-        std::list<Type>::const_iterator i = db->typeList.begin();
+        StableVector<Type>::const_iterator i = db->typeList.begin();
         const Type* Fred = &(*i++);
         const Type* Wilma = &(*i++);
         const Type* Barney = &(*i++);
@@ -2795,7 +2802,7 @@ private:
             ASSERT(db->getVariableFromVarId(i) != nullptr);
 
         ASSERT_EQUALS(4U, db->scopeList.size());
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        StableVector<Scope>::const_iterator scope = db->scopeList.begin();
         ASSERT_EQUALS(Scope::eGlobal, scope->type);
         ++scope;
         ASSERT_EQUALS(Scope::eStruct, scope->type);
@@ -2813,7 +2820,7 @@ private:
 
         ASSERT(db != nullptr);
         ASSERT_EQUALS(4U, db->scopeList.size());
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        StableVector<Scope>::const_iterator scope = db->scopeList.begin();
         ASSERT_EQUALS(Scope::eGlobal, scope->type);
         ++scope;
         ASSERT_EQUALS(Scope::eStruct, scope->type);
@@ -3021,7 +3028,7 @@ private:
         if (db) {
             ASSERT(db->scopeList.size() == 4U);
             if (db->scopeList.size() == 4U) {
-                std::list<Scope>::const_iterator it = db->scopeList.begin();
+                StableVector<Scope>::const_iterator it = db->scopeList.begin();
                 ASSERT(it->type == Scope::eGlobal);
                 ASSERT((++it)->type == Scope::eFunction);
                 ASSERT((++it)->type == Scope::eIf);
@@ -3045,7 +3052,7 @@ private:
         if (db) {
             ASSERT(db->typeList.size() == 3U);
             if (db->typeList.size() == 3U) {
-                std::list<Type>::const_iterator it = db->typeList.begin();
+                StableVector<Type>::const_iterator it = db->typeList.begin();
                 const Type * classB = &(*it);
                 const Type * classC = &(*(++it));
                 const Type * classA = &(*(++it));
@@ -4200,7 +4207,7 @@ private:
         ASSERT_EQUALS(3U, db->scopeList.size());
 
         // Assert that all enum values are known
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        StableVector<Scope>::const_iterator scope = db->scopeList.begin();
 
         // Offsets
         ++scope;
@@ -4289,7 +4296,7 @@ private:
         ASSERT_EQUALS(2U, db->scopeList.size());
 
         // Assert that all enum values are known
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        StableVector<Scope>::const_iterator scope = db->scopeList.begin();
 
         ++scope;
         ASSERT_EQUALS((unsigned int)Scope::eEnum, (unsigned int)scope->type);
@@ -4543,7 +4550,7 @@ private:
                       "};");
         ASSERT(db && db->scopeList.back().functionList.size() == 4);
         if (db && db->scopeList.back().functionList.size() == 4) {
-            std::list<Function>::const_iterator it = db->scopeList.back().functionList.begin();
+            StableVector<Function>::const_iterator it = db->scopeList.back().functionList.begin();
             ASSERT((it++)->isPure());
             ASSERT((it++)->isPure());
             ASSERT(!(it++)->isPure());
@@ -5339,6 +5346,43 @@ private:
         ASSERT_EQUALS(true, db && f && f->function() && f->function()->tokenDef->linenr() == 12);
     }
 
+    void findVariableAndRecord() {
+        std::ostringstream code;
+        code << "namespace N {\n"
+             << "    void S() {}\n"
+             << "    struct S { int x; };\n";
+        for (int i = 0; i < 100; ++i)
+            code << "    struct S" << i << " { int m" << i << "; int m" << i << "_2; };\n";
+        code << "}";
+        GET_SYMBOL_DB(code.str().c_str());
+        ASSERT(db != nullptr);
+        if (!db)
+            return;
+
+        const Scope *n = db->findScopeByName("N");
+        ASSERT(n != nullptr);
+        if (!n)
+            return;
+
+        // the function S is skipped
+        const Scope *s = n->findRecordInNestedList("S");
+        ASSERT(s && s->type == Scope::eStruct && s->classDef->linenr() == 3);
+        ASSERT(s && s->getVariable("x") && s->getVariable("x")->nameToken()->linenr() == 3);
+
+        for (int i = 0; i < 100; ++i) {
+            const std::string name = "S" + MathLib::toString(i);
+            s = n->findRecordInNestedList(name);
+            ASSERT_EQUALS(name, s ? s->className : "");
+            if (s) {
+                const std::string member = "m" + MathLib::toString(i);
+                ASSERT_EQUALS(member, s->getVariable(member) ? s->getVariable(member)->name() : "");
+                ASSERT_EQUALS(1U, s->getVariable(member + "_2") ? s->getVariable(member + "_2")->index() : 0U);
+                ASSERT(s->getVariable("x") == nullptr);
+            }
+        }
+        ASSERT(n->findRecordInNestedList("S100") == nullptr);
+    }
+
 #define FUNC(x) const Function *x = findFunctionByName(#x, &db->scopeList.front()); \
                 ASSERT_EQUALS(true, x != nullptr);                                  \
                 if (x) ASSERT_EQUALS(true, x->isNoExcept());
@@ -5716,7 +5760,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 3);
         if (db && db->scopeList.size() == 3) {
-            std::list<Scope>::const_iterator scope = db->scopeList.begin();
+            StableVector<Scope>::const_iterator scope = db->scopeList.begin();
             ASSERT_EQUALS(Scope::eGlobal, scope->type);
             ++scope;
             ASSERT_EQUALS(Scope::eFunction, scope->type);
@@ -5737,7 +5781,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 3);
         if (db && db->scopeList.size() == 3) {
-            std::list<Scope>::const_iterator scope = db->scopeList.begin();
+            StableVector<Scope>::const_iterator scope = db->scopeList.begin();
             ASSERT_EQUALS(Scope::eGlobal, scope->type);
             ++scope;
             ASSERT_EQUALS(Scope::eFunction, scope->type);
@@ -5769,7 +5813,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 3);
         if (db && db->scopeList.size() == 3) {
-            std::list<Scope>::const_iterator scope = db->scopeList.begin();
+            StableVector<Scope>::const_iterator scope = db->scopeList.begin();
             ASSERT_EQUALS(Scope::eGlobal, scope->type);
             ++scope;
             ASSERT_EQUALS(Scope::eClass, scope->type);
@@ -6852,6 +6896,201 @@ private:
         ASSERT(db != nullptr);
         ASSERT_EQUALS("", errout.str());
     }
+
+    void controlFlowGraph() {
+        GET_SYMBOL_DB("void f(int x) {\n"
+                      "    int a = 0;\n"
+                      "    if (x) {\n"
+                      "        a = 1;\n"
+                      "    } else {\n"
+                      "        return;\n"
+                      "    }\n"
+                      "    while (a < 10) {\n"
+                      "        if (a == 5)\n"
+                      "            break;\n"
+                      "        a++;\n"
+                      "    }\n"
+                      "    a = 2;\n"
+                      "    switch (x) {\n"
+                      "    case 1:\n"
+                      "        a = 3;\n"
+                      "    case 2:\n"
+                      "        a = 4;\n"
+                      "        break;\n"
+                      "    }\n"
+                      "    return;\n"
+                      "    a = 5;\n"
+                      "}");
+        ASSERT(db && db->functionScopes.size() == 1U);
+        if (!db || db->functionScopes.size() != 1U)
+            return;
+        const ControlFlowGraph *cfg = db->controlFlowGraph(db->functionScopes[0]);
+        ASSERT(cfg != nullptr);
+        if (!cfg)
+            return;
+        ASSERT_EQUALS(true, cfg == db->controlFlowGraph(db->functionScopes[0]));
+        ASSERT_EQUALS(true, nullptr == db->controlFlowGraph(&db->scopeList.front()));
+
+        const std::vector<ControlFlowGraph::BasicBlock> &blocks = cfg->blocks();
+        const Token *tok = tokenizer.tokens();
+        ASSERT_EQUALS(ControlFlowGraph::ENTRY, cfg->blockOf(Token::findsimplematch(tok, "a = 0")));
+        ASSERT_EQUALS(ControlFlowGraph::ENTRY, cfg->blockOf(Token::findsimplematch(tok, "if ( x )")));
+        ASSERT_EQUALS(2U, blocks[ControlFlowGraph::ENTRY].successors.size());
+
+        // return => exit
+        const unsigned int ret = cfg->blockOf(Token::findsimplematch(tok, "return"));
+        ASSERT_EQUALS(1U, blocks[ret].successors.size());
+        ASSERT_EQUALS(ControlFlowGraph::EXIT, blocks[ret].successors[0]);
+
+        // loop head is reached from before the loop and from the loop body
+        const unsigned int head = cfg->blockOf(Token::findsimplematch(tok, "while"));
+        ASSERT_EQUALS(2U, blocks[head].predecessors.size());
+        ASSERT_EQUALS(true, head == cfg->blockOf(Token::findsimplematch(tok, "a < 10")));
+
+        // after loop: from loop condition and from break
+        const unsigned int after = cfg->blockOf(Token::findsimplematch(tok, "a = 2"));
+        ASSERT_EQUALS(2U, blocks[after].predecessors.size());
+        ASSERT_EQUALS(true, cfg->isReachable(after));
+
+        // fall through from "case 1" to "case 2"
+        const unsigned int case1 = cfg->blockOf(Token::findsimplematch(tok, "a = 3"));
+        const unsigned int case2 = cfg->blockOf(Token::findsimplematch(tok, "a = 4"));
+        ASSERT_EQUALS(1U, blocks[case1].successors.size());
+        ASSERT_EQUALS(case2, blocks[case1].successors[0]);
+        ASSERT_EQUALS(2U, blocks[case2].predecessors.size());
+
+        // dead code
+        const unsigned int dead = cfg->blockOf(Token::findsimplematch(tok, "a = 5"));
+        ASSERT(dead != ControlFlowGraph::NONE);
+        ASSERT_EQUALS(false, cfg->isReachable(dead));
+        ASSERT_EQUALS(true, cfg->isReachable(ControlFlowGraph::EXIT));
+        ASSERT_EQUALS(ControlFlowGraph::NONE, cfg->blockOf(Token::findsimplematch(tok, "else")));
+    }
+
+    void controlFlowGraphTryGoto() {
+        GET_SYMBOL_DB("void g();\n"
+                      "void f() {\n"
+                      "    int a = 0;\n"
+                      "    try {\n"
+                      "        g();\n"
+                      "        throw 1;\n"
+                      "    } catch (int e) {\n"
+                      "        a = e;\n"
+                      "    }\n"
+                      "    do {\n"
+                      "        a++;\n"
+                      "        if (a > 10) goto done;\n"
+                      "    } while (a < 5);\n"
+                      "    a = 1;\n"
+                      "done:\n"
+                      "    a = 2;\n"
+                      "}");
+        ASSERT(db && db->functionScopes.size() == 1U);
+        if (!db || db->functionScopes.size() != 1U)
+            return;
+        const ControlFlowGraph *cfg = db->controlFlowGraph(db->functionScopes[0]);
+        const std::vector<ControlFlowGraph::BasicBlock> &blocks = cfg->blocks();
+        const Token *tok = tokenizer.tokens();
+
+        const unsigned int tryBlock = cfg->blockOf(Token::findsimplematch(tok, "g ( ) ; throw"));
+        const unsigned int catchBlock = cfg->blockOf(Token::findsimplematch(tok, "a = e"));
+        ASSERT_EQUALS(true, catchBlock == cfg->blockOf(Token::findsimplematch(tok, "catch")));
+        ASSERT_EQUALS(1U, blocks[tryBlock].successors.size());
+        ASSERT_EQUALS(catchBlock, blocks[tryBlock].successors[0]);
+        ASSERT_EQUALS(true, cfg->isReachable(catchBlock));
+
+        // do-while: condition loops back to body
+        const unsigned int body = cfg->blockOf(Token::findsimplematch(tok, "a ++"));
+        const unsigned int cond = cfg->blockOf(Token::findsimplematch(tok, "while"));
+        ASSERT_EQUALS(true, std::find(blocks[cond].successors.begin(), blocks[cond].successors.end(), body) != blocks[cond].successors.end());
+
+        // goto => label
+        const unsigned int gotoBlock = cfg->blockOf(Token::findsimplematch(tok, "goto"));
+        const unsigned int label = cfg->blockOf(Token::findsimplematch(tok, "a = 2"));
+        ASSERT_EQUALS(1U, blocks[gotoBlock].successors.size());
+        ASSERT_EQUALS(label, blocks[gotoBlock].successors[0]);
+        ASSERT_EQUALS(2U, blocks[label].predecessors.size());
+    }
+
+    void controlFlowGraphNoreturn() {
+        GET_SYMBOL_DB("namespace N { [[noreturn]] void fatal(int code); }\n"
+                      "void f(int x) {\n"
+                      "    if (x)\n"
+                      "        N::fatal(1);\n"
+                      "    x = 1;\n"
+                      "    N::fatal(2);\n"
+                      "    x = 2;\n"
+                      "}");
+        ASSERT(db && db->functionScopes.size() == 1U);
+        if (!db || db->functionScopes.size() != 1U)
+            return;
+        const ControlFlowGraph *cfg = db->controlFlowGraph(db->functionScopes[0]);
+        const std::vector<ControlFlowGraph::BasicBlock> &blocks = cfg->blocks();
+        const Token *tok = tokenizer.tokens();
+
+        // the noreturn call ends its block
+        const unsigned int call = cfg->blockOf(Token::findsimplematch(tok, "fatal ( 1 )"));
+        ASSERT_EQUALS(1U, blocks[call].successors.size());
+        ASSERT_EQUALS(ControlFlowGraph::EXIT, blocks[call].successors[0]);
+
+        const unsigned int after = cfg->blockOf(Token::findsimplematch(tok, "x = 1"));
+        ASSERT_EQUALS(1U, blocks[after].predecessors.size());
+        ASSERT_EQUALS(true, cfg->isReachable(after));
+
+        // the code after the qualified call is dead
+        const unsigned int dead = cfg->blockOf(Token::findsimplematch(tok, "x = 2"));
+        ASSERT(dead != ControlFlowGraph::NONE);
+        ASSERT_EQUALS(false, cfg->isReachable(dead));
+
+        // tokens outside the body are not in any block
+        ASSERT_EQUALS(ControlFlowGraph::NONE, cfg->blockOf(tok));
+        ASSERT_EQUALS(ControlFlowGraph::NONE, cfg->blockOf(nullptr));
+    }
+
+    void defUseIndex() {
+        GET_SYMBOL_DB("void g(int *p);\n"
+                      "void f() {\n"
+                      "    int x = 0;\n"
+                      "    int y = x;\n"
+                      "    x++;\n"
+                      "    g(&y);\n"
+                      "    return x + y;\n"
+                      "}");
+        ASSERT(db && db->defUseIndex());
+        if (!db || !db->defUseIndex())
+            return;
+        const DefUseIndex *defUse = db->defUseIndex();
+        const Token *x = Token::findsimplematch(tokenizer.tokens(), "x =");
+        const Token *y = Token::findsimplematch(tokenizer.tokens(), "y =");
+        ASSERT_EQUALS(2U, defUse->writes(x->varId()).size());
+        ASSERT_EQUALS(2U, defUse->reads(x->varId()).size());
+        ASSERT_EQUALS(2U, defUse->writes(y->varId()).size());
+
+        bool changed = true;
+        const Token *xinc = Token::findsimplematch(tokenizer.tokens(), "x ++");
+        ASSERT(defUse->isChanged(x->next(), xinc, x->varId(), false, &settings1, true, &changed));
+        ASSERT_EQUALS(false, changed);
+        ASSERT(defUse->isChanged(x->next(), nullptr, x->varId(), false, &settings1, true, &changed));
+        ASSERT_EQUALS(true, changed);
+        ASSERT(defUse->isChanged(xinc->next(), nullptr, y->varId(), false, &settings1, true, &changed));
+        ASSERT_EQUALS(true, changed);
+        ASSERT(defUse->isRead(y, nullptr, x->varId()));
+        ASSERT(defUse->isRead(xinc, nullptr, y->varId()));
+        ASSERT_EQUALS(false, defUse->isRead(x, y, y->varId()));
+
+        // global variable is changed by function call
+        const Token *call = Token::findsimplematch(tokenizer.tokens(), "g ( &");
+        ASSERT(defUse->isChanged(y->next(), xinc, x->varId(), true, &settings1, true, &changed));
+        ASSERT_EQUALS(false, changed);
+        ASSERT(defUse->isChanged(call, call->linkAt(1), x->varId(), true, &settings1, true, &changed));
+        ASSERT_EQUALS(true, changed);
+
+        // unknown varid => index can't be used
+        ASSERT_EQUALS(false, defUse->isChanged(call, call->linkAt(1), 1000U, false, &settings1, true, &changed));
+
+        // settings that were not used to create the index => index can't be used
+        ASSERT_EQUALS(false, defUse->isChanged(x->next(), nullptr, x->varId(), false, &settings2, true, &changed));
+    }
 };
 
 REGISTER_TEST(TestSymbolDatabase)
@@ -71,6 +71,7 @@ private:
         TEST_CASE(no_errors_equal_amount_files);
         TEST_CASE(one_error_less_files);
         TEST_CASE(one_error_several_files);
+        TEST_CASE(expensive_file);
     }
 
     void deadlock_with_many_errors() {
@@ -135,6 +136,33 @@ private:
               "  return 0;\n"
               "}");
     }
+
+    void expensive_file() {
+        output.str("");
+        if (!ThreadExecutor::isEnabled())
+            return;
+
+        std::map<std::string, std::size_t> filemap;
+        for (int i = 1; i <= 12; ++i) {
+            std::ostringstream oss;
+            oss << "file_" << i << ".cpp";
+            filemap[oss.str()] = 1;
+        }
+        filemap["file_z.cpp"] = 1;
+
+        std::ostringstream big;
+        for (int i = 0; i < 100; i++)
+            big << "int f" << i << "(int x) { return x + " << i << "; }\n";
+
+        settings.jobs = 1;
+        ThreadExecutor executor(filemap, settings, *this);
+        for (std::map<std::string, std::size_t>::const_iterator i = filemap.begin(); i != filemap.end(); ++i)
+            executor.addFileContent(i->first, i->first == "file_z.cpp" ? big.str() : "int f(int x) { return x; }");
+
+        ASSERT_EQUALS(0, executor.check());
+        ASSERT(output.str().find("Checking file_z.cpp may take long") != std::string::npos);
+        ASSERT(output.str().find("Checking file_1.cpp may take long") == std::string::npos);
+    }
 };
 
 REGISTER_TEST(TestThreadExecutor)
@@ -16,11 +16,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "redirect.h"
 #include "testsuite.h"
 #include "timer.h"
 
 #include <cmath>
 #include <ctime>
+#include <string>
 
 class TestTimer : public TestFixture {
 public:
@@ -31,6 +33,7 @@ private:
 
     void run() override {
         TEST_CASE(result);
+        TEST_CASE(counts);
     }
 
     void result() const {
@@ -41,6 +44,18 @@ private:
         t1.mClocks = CLOCKS_PER_SEC * 5 / 2;
         ASSERT(std::fabs(t1.seconds()-2.5) < 0.01);
     }
+
+    void counts() {
+        REDIRECT;
+        TimerResults results;
+        results.AddCount("tokens", 3);
+        results.AddCount("tokens", 4);
+        results.AddCount("bailouts", 0);
+        results.ShowResults(SHOWTIME_SUMMARY);
+
+        ASSERT(GET_REDIRECT_OUTPUT.find("tokens: 7\n") != std::string::npos);
+        ASSERT(GET_REDIRECT_OUTPUT.find("bailouts: 0\n") != std::string::npos);
+    }
 };
 
 REGISTER_TEST(TestTimer)
@@ -22,6 +22,7 @@
 #include "token.h"
 #include "tokenize.h"
 #include "tokenlist.h"
+#include "tokenpatterntable.h"
 
 #include <string>
 #include <vector>
@@ -105,6 +106,8 @@ private:
         TEST_CASE(findClosingBracket);
 
         TEST_CASE(expressionString);
+
+        TEST_CASE(patternTable);
     }
 
     void nextprevious() const {
@@ -940,6 +943,37 @@ private:
         const Token *const tok2 = Token::findsimplematch(var2.tokens(), "*");
         ASSERT_EQUALS("*((unsigned long long*)x)", tok2->expressionString());
     }
+
+    void patternTable() const {
+        TokenPatternTable table;
+        ASSERT_EQUALS(0U, table.add("stoi ("));
+        ASSERT_EQUALS(1U, table.add("%name% ( )"));
+        ASSERT_EQUALS(2U, table.add("lexical_cast < %name% > ("));
+        ASSERT_EQUALS(3U, table.add("stoi|stol ( %num% )"));
+        ASSERT_EQUALS(4U, table.add("!!stoi ("));
+        ASSERT_EQUALS(5U, table.add("[{}] ("));
+        ASSERT_EQUALS(6U, table.add("|x y ("));
+        ASSERT_EQUALS(7U, table.size());
+
+        givenACodeSampleToTokenize code("stoi ( 1 ) ; stol ( ) ; lexical_cast < int > ( s ) ; f ( 2 ) ; y ( ) ;", true);
+        const Token *stoi = code.tokens();
+        ASSERT_EQUALS(0U, table.findMatch(stoi));
+        ASSERT_EQUALS(3U, table.findMatch(stoi, 1));
+        ASSERT_EQUALS(TokenPatternTable::npos, table.findMatch(stoi, 4));
+
+        const Token *stol = Token::findsimplematch(stoi, "stol");
+        ASSERT_EQUALS(1U, table.findMatch(stol));
+        ASSERT_EQUALS(4U, table.findMatch(stol, 2));
+
+        const Token *cast = Token::findsimplematch(stoi, "lexical_cast");
+        ASSERT_EQUALS(2U, table.findMatch(cast));
+        ASSERT_EQUALS(TokenPatternTable::npos, table.findMatch(cast, 3));
+
+        ASSERT_EQUALS(4U, table.findMatch(Token::findsimplematch(stoi, "f")));
+        ASSERT_EQUALS(1U, table.findMatch(Token::findsimplematch(stoi, "y")));
+        ASSERT_EQUALS(4U, table.findMatch(Token::findsimplematch(stoi, "y"), 2));
+        ASSERT_EQUALS(TokenPatternTable::npos, table.findMatch(nullptr));
+    }
 };
 
 REGISTER_TEST(TestToken)
@@ -482,6 +482,8 @@ private:
 
         // --check-config
         TEST_CASE(checkConfiguration);
+
+        TEST_CASE(estimateCost);
     }
 
     std::string tokenizeAndStringify(const char code[], bool simplify = false, bool expand = true, Settings::PlatformType platform = Settings::Native, const char* filename = "test.cpp", bool cpp11 = true) {
@@ -8738,6 +8740,27 @@ private:
         checkConfig("void f() { DEBUG(x();y()); }");
         ASSERT_EQUALS("[test.cpp:1]: (information) Ensure that 'DEBUG' is defined either using -I, --include or -D.\n", errout.str());
     }
+
+    std::size_t estimateCost(const char code[]) {
+        Tokenizer tokenizer(&settings0, this);
+        std::istringstream istr(code);
+        tokenizer.tokenize(istr, "test.cpp");
+        return tokenizer.estimateCost();
+    }
+
+    void estimateCost() {
+        // 6 tokens and 1 function
+        ASSERT_EQUALS(56U, estimateCost("void f() { }"));
+        // 12 tokens and 2 functions
+        ASSERT_EQUALS(112U, estimateCost("void f() { }\n"
+                                         "void g() { }"));
+        // template instantiations are more expensive than their tokens
+        const std::size_t plain = estimateCost("int g(int x) { return x; }\n"
+                                               "int h() { return g(1); }");
+        const std::size_t instantiated = estimateCost("template<class T> T g(T x) { return x; }\n"
+                                                      "int h() { return g<int>(1); }");
+        ASSERT(instantiated >= plain + 200);
+    }
 };
 
 REGISTER_TEST(TestTokenizer)
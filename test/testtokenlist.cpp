@@ -36,6 +36,7 @@ private:
         TEST_CASE(testaddtoken1);
         TEST_CASE(testaddtoken2);
         TEST_CASE(inc);
+        TEST_CASE(size);
     }
 
     // inspired by #5895
@@ -73,6 +74,25 @@ private:
 
         ASSERT(Token::simpleMatch(tokenlist.front(), "a + + 1 ; 1 + + b ;"));
     }
+
+    void size() const {
+        TokenList tokenlist(&settings);
+        ASSERT_EQUALS(0U, tokenlist.size());
+        ASSERT_EQUALS(0U, tokenlist.memoryUsage());
+
+        std::istringstream istr("int a = 1;");
+        tokenlist.createTokens(istr, "a.cpp");
+        ASSERT_EQUALS(5U, tokenlist.size());
+        ASSERT(tokenlist.memoryUsage() >= 5 * sizeof(Token));
+
+        tokenlist.front()->insertToken("static", "", true);
+        ASSERT_EQUALS(6U, tokenlist.size());
+        tokenlist.front()->deleteNext();
+        ASSERT_EQUALS(5U, tokenlist.size());
+
+        tokenlist.deallocateTokens();
+        ASSERT_EQUALS(0U, tokenlist.size());
+    }
 };
 
 REGISTER_TEST(TestTokenList)
@@ -111,6 +111,12 @@ private:
         TEST_CASE(valueFlowTerminatingCond);
 
         TEST_CASE(valueFlowContainerSize);
+
+        TEST_CASE(valueFlowDeadline);
+        TEST_CASE(valueFlowMemoryLimit);
+        TEST_CASE(errorPathMemoryUsage);
+        TEST_CASE(valueFlowTokenBudget);
+        TEST_CASE(valueFlowDepthBudget);
     }
 
     bool testValueOfXKnown(const char code[], unsigned int linenr, int value) {
@@ -131,15 +137,15 @@ private:
         return false;
     }
 
-    bool testValueOfX(const char code[], unsigned int linenr, int value) {
+    bool testValueOfX(const char code[], unsigned int linenr, int value, const Settings *s = nullptr) {
         // Tokenize..
-        Tokenizer tokenizer(&settings, this);
+        Tokenizer tokenizer(s ? s : &settings, this);
         std::istringstream istr(code);
         tokenizer.tokenize(istr, "test.cpp");
 
         for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
             if (tok->str() == "x" && tok->linenr() == linenr) {
-                std::list<ValueFlow::Value>::const_iterator it;
+                ValueFlow::ValueList::const_iterator it;
                 for (it = tok->values().begin(); it != tok->values().end(); ++it) {
                     if (it->isIntValue() && it->intvalue == value)
                         return true;
@@ -158,7 +164,7 @@ private:
 
         for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
             if (tok->str() == "x" && tok->linenr() == linenr) {
-                std::list<ValueFlow::Value>::const_iterator it;
+                ValueFlow::ValueList::const_iterator it;
                 for (it = tok->values().begin(); it != tok->values().end(); ++it) {
                     if (it->isFloatValue() && it->floatValue >= value - diff && it->floatValue <= value + diff)
                         return true;
@@ -180,11 +186,11 @@ private:
                 continue;
 
             std::ostringstream ostr;
-            std::list<ValueFlow::Value>::const_iterator it;
+            ValueFlow::ValueList::const_iterator it;
             for (it = tok->values().begin(); it != tok->values().end(); ++it) {
-                for (ValueFlow::Value::ErrorPath::const_iterator ep = it->errorPath.begin(); ep != it->errorPath.end(); ++ep) {
-                    const Token *eptok = ep->first;
-                    const std::string &msg = ep->second;
+                for (const ValueFlow::Value::ErrorPathItem &ep : it->errorPath.toList()) {
+                    const Token *eptok = ep.first;
+                    const std::string &msg = ep.second;
                     ostr << eptok->linenr() << ',' << msg << '\n';
                 }
             }
@@ -202,7 +208,7 @@ private:
 
         for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
             if (tok->str() == "x" && tok->linenr() == linenr) {
-                std::list<ValueFlow::Value>::const_iterator it;
+                ValueFlow::ValueList::const_iterator it;
                 for (it = tok->values().begin(); it != tok->values().end(); ++it) {
                     if (it->valueType == type && Token::simpleMatch(it->tokvalue, value))
                         return true;
@@ -221,7 +227,7 @@ private:
 
         for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
             if (tok->str() == "x" && tok->linenr() == linenr) {
-                std::list<ValueFlow::Value>::const_iterator it;
+                ValueFlow::ValueList::const_iterator it;
                 for (it = tok->values().begin(); it != tok->values().end(); ++it) {
                     if (it->isMovedValue() && it->moveKind == moveKind)
                         return true;
@@ -240,7 +246,7 @@ private:
 
         for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
             if (tok->str() == "x" && tok->linenr() == linenr) {
-                std::list<ValueFlow::Value>::const_iterator it;
+                ValueFlow::ValueList::const_iterator it;
                 for (it = tok->values().begin(); it != tok->values().end(); ++it) {
                     if (it->isIntValue() && it->intvalue == value && it->condition)
                         return true;
@@ -271,17 +277,17 @@ private:
         settings.debugwarnings = false;
     }
 
-    std::list<ValueFlow::Value> tokenValues(const char code[], const char tokstr[]) {
+    ValueFlow::ValueList tokenValues(const char code[], const char tokstr[]) {
         Tokenizer tokenizer(&settings, this);
         std::istringstream istr(code);
         errout.str("");
         tokenizer.tokenize(istr, "test.cpp");
         const Token *tok = Token::findmatch(tokenizer.tokens(), tokstr);
-        return tok ? tok->values() : std::list<ValueFlow::Value>();
+        return tok ? tok->values() : ValueFlow::ValueList();
     }
 
     ValueFlow::Value valueOfTok(const char code[], const char tokstr[]) {
-        std::list<ValueFlow::Value> values = tokenValues(code, tokstr);
+        ValueFlow::ValueList values = tokenValues(code, tokstr);
         return values.size() == 1U && !values.front().isTokValue() ? values.front() : ValueFlow::Value();
     }
 
@@ -567,7 +573,7 @@ private:
                 "    if (x==2) {}\n"
                 "    if (x==4) {}\n"
                 "}";
-        std::list<ValueFlow::Value> values = tokenValues(code,"*");
+        ValueFlow::ValueList values = tokenValues(code,"*");
         ASSERT_EQUALS(2U, values.size());
         ASSERT_EQUALS(4, values.front().intvalue);
         ASSERT_EQUALS(16, values.back().intvalue);
@@ -732,7 +738,7 @@ private:
 
     void valueFlowSizeof() {
         const char *code;
-        std::list<ValueFlow::Value> values;
+        ValueFlow::ValueList values;
 
 #define CHECK(A, B)                              \
         code = "void f() {\n"                    \
@@ -938,6 +944,33 @@ private:
                "}\n";
         ASSERT_EQUALS("3,After for loop, x has value 50\n",
                       getErrorPathForX(code, 4U));
+
+        // copies share items, adding an item to a copy does not change the original
+        ValueFlow::Value v1;
+        v1.errorPath.emplace_back(nullptr, "a");
+        ValueFlow::Value v2(v1);
+        v2.errorPath.emplace_back(nullptr, "b");
+        v1.errorPath.emplace_back(nullptr, "c");
+        ASSERT_EQUALS(2U, v1.errorPath.size());
+        ASSERT_EQUALS(2U, v2.errorPath.size());
+        ASSERT_EQUALS("a", v1.errorPath.toList().front().second);
+        ASSERT_EQUALS("c", v1.errorPath.toList().back().second);
+        ASSERT_EQUALS("b", v2.errorPath.toList().back().second);
+        v2.errorPath.clear();
+        ASSERT(v2.errorPath.empty());
+        ASSERT_EQUALS(2U, v1.errorPath.size());
+
+        // append() shares the items when the path is empty
+        v2.errorPath.append(v1.errorPath);
+        ASSERT_EQUALS(2U, v2.errorPath.size());
+        v2.errorPath.emplace_back(nullptr, "d");
+        v2.errorPath.append(v1.errorPath);
+        ASSERT_EQUALS(5U, v2.errorPath.size());
+        ASSERT_EQUALS(2U, v1.errorPath.size());
+        std::string items;
+        for (const ValueFlow::Value::ErrorPathItem &item : v2.errorPath.toList())
+            items += item.second;
+        ASSERT_EQUALS("acdac", items);
     }
 
     void valueFlowBeforeCondition() {
@@ -2790,7 +2823,7 @@ private:
                "    a = 2;\n"
                "  add(a, a);\n"
                "}";
-        std::list<ValueFlow::Value> values = tokenValues(code, "( a , a )");
+        ValueFlow::ValueList values = tokenValues(code, "( a , a )");
         ASSERT_EQUALS(2, values.size());
         ASSERT_EQUALS(2, values.front().intvalue);
         ASSERT_EQUALS(4, values.back().intvalue);
@@ -2874,8 +2907,8 @@ private:
     }
 
     bool isNotKnownValues(const char code[], const char str[]) {
-        const std::list<ValueFlow::Value> values = tokenValues(code, str);
-        for (std::list<ValueFlow::Value>::const_iterator it = values.begin(); it != values.end(); ++it) {
+        const ValueFlow::ValueList values = tokenValues(code, str);
+        for (ValueFlow::ValueList::const_iterator it = values.begin(); it != values.end(); ++it) {
             if (it->isKnown())
                 return false;
         }
@@ -3248,7 +3281,7 @@ private:
 
     void valueFlowUninit() {
         const char* code;
-        std::list<ValueFlow::Value> values;
+        ValueFlow::ValueList values;
 
         code = "void f() {\n"
                "    int x;\n"
@@ -3454,7 +3487,7 @@ private:
         ASSERT_EQUALS(false, valueOfTok(code, "!=").intvalue == 1);
     }
 
-    static std::string isPossibleContainerSizeValue(const std::list<ValueFlow::Value> &values, MathLib::bigint i) {
+    static std::string isPossibleContainerSizeValue(const ValueFlow::ValueList &values, MathLib::bigint i) {
         if (values.size() != 1)
             return "values.size():" + std::to_string(values.size());
         if (!values.front().isContainerSizeValue())
@@ -3466,7 +3499,7 @@ private:
         return "";
     }
 
-    static std::string isKnownContainerSizeValue(const std::list<ValueFlow::Value> &values, MathLib::bigint i) {
+    static std::string isKnownContainerSizeValue(const ValueFlow::ValueList &values, MathLib::bigint i) {
         if (values.size() != 1)
             return "values.size():" + std::to_string(values.size());
         if (!values.front().isContainerSizeValue())
@@ -3709,6 +3742,121 @@ private:
                "}";
         ASSERT_EQUALS("", isKnownContainerSizeValue(tokenValues(code, "+"), 8));
     }
+
+    void valueFlowDeadline() {
+        const char code[] = "void f() {\n"
+                            "    int x = 3;\n"
+                            "    return x;\n"
+                            "}";
+
+        // without a deadline all values are found
+        {
+            Tokenizer tokenizer(&settings, this);
+            std::istringstream istr(code);
+            tokenizer.tokenize(istr, "test.cpp");
+            ASSERT_EQUALS(false, tokenizer.isValueFlowIncomplete());
+            ASSERT_EQUALS(false, tokenizer.isValueFlowBudgetExceeded());
+            ASSERT(Token::findsimplematch(tokenizer.tokens(), "return x")->next()->getValue(3));
+        }
+
+        // when the deadline is reached, only the first passes are executed
+        {
+            Tokenizer tokenizer(&settings, this);
+            tokenizer.setDeadline(1);
+            std::istringstream istr(code);
+            tokenizer.tokenize(istr, "test.cpp");
+            ASSERT_EQUALS(true, tokenizer.isValueFlowIncomplete());
+            ASSERT_EQUALS(true, tokenizer.isValueFlowBudgetExceeded());
+            ASSERT(Token::findsimplematch(tokenizer.tokens(), "3")->hasKnownIntValue());
+            ASSERT(!Token::findsimplematch(tokenizer.tokens(), "return x")->next()->getValue(3));
+        }
+    }
+
+    void valueFlowMemoryLimit() {
+        const char code[] = "void f() {\n"
+                            "    int x = 3;\n"
+                            "    return x;\n"
+                            "}";
+
+        Settings s(settings);
+        s.maxMemoryPerFile = 1;
+        Tokenizer tokenizer(&s, this);
+        std::istringstream istr(code);
+        tokenizer.tokenize(istr, "test.cpp");
+        ASSERT_EQUALS(true, tokenizer.isValueFlowIncomplete());
+        ASSERT_EQUALS(true, tokenizer.isValueFlowBudgetExceeded());
+        ASSERT(tokenizer.memoryUsage() > s.maxMemoryPerFile);
+        ASSERT(!Token::findsimplematch(tokenizer.tokens(), "return x")->next()->getValue(3));
+    }
+
+    void errorPathMemoryUsage() {
+        const std::size_t before = ValueFlow::SharedErrorPath::memoryUsage();
+        const std::string info(100, 'x');
+        {
+            ValueFlow::SharedErrorPath path;
+            path.emplace_back(nullptr, info);
+            path.emplace_back(nullptr, info);
+            ASSERT(ValueFlow::SharedErrorPath::memoryUsage() >= before + 2 * info.size());
+
+            // copies share the items
+            const std::size_t used = ValueFlow::SharedErrorPath::memoryUsage();
+            const ValueFlow::SharedErrorPath copy(path);
+            ASSERT_EQUALS(used, ValueFlow::SharedErrorPath::memoryUsage());
+        }
+        ASSERT_EQUALS(before, ValueFlow::SharedErrorPath::memoryUsage());
+    }
+
+    void valueFlowTokenBudget() {
+        const char code[] = "void f(int a) {\n"
+                            "    int x = 3;\n"
+                            "    a = 1;\n"
+                            "    a = 2;\n"
+                            "    a = 3;\n"
+                            "    return x;\n"
+                            "}";
+
+        Settings s(settings);
+        s.maxValueFlowTokens = 0;
+        ASSERT_EQUALS(true, testValueOfX(code, 6U, 3, &s));
+
+        s.maxValueFlowTokens = 8;
+        ASSERT_EQUALS(false, testValueOfX(code, 6U, 3, &s));
+
+        // the statistics belong to the token list
+        s.showtime = SHOWTIME_SUMMARY;
+        Tokenizer tokenizer(&s, this);
+        std::istringstream istr(code);
+        tokenizer.tokenize(istr, "test.cpp");
+        ASSERT(tokenizer.list.valueFlowStatistics().forwardTokenBailouts > 0);
+        ASSERT(tokenizer.list.valueFlowStatistics().forwardTokens > 0);
+
+        Tokenizer tokenizer2(&s, this);
+        std::istringstream istr2("void f() { int x = 3; return x; }");
+        tokenizer2.tokenize(istr2, "test.cpp");
+        ASSERT_EQUALS(0UL, tokenizer2.list.valueFlowStatistics().forwardTokenBailouts);
+    }
+
+    void valueFlowDepthBudget() {
+        const char code[] = "int f() {\n"
+                            "    int x = 3;\n"
+                            "    if (x == 3) {\n"
+                            "        if (x == 3) {\n"
+                            "            return x;\n"
+                            "        }\n"
+                            "    }\n"
+                            "    return 0;\n"
+                            "}";
+
+        Settings s(settings);
+        s.maxValueFlowDepth = 0;
+        ASSERT_EQUALS(true, testValueOfX(code, 5U, 3, &s));
+
+        s.maxValueFlowDepth = 2;
+        ASSERT_EQUALS(true, testValueOfX(code, 5U, 3, &s));
+
+        s.maxValueFlowDepth = 1;
+        ASSERT_EQUALS(false, testValueOfX(code, 5U, 3, &s));
+    }
 };
 
 REGISTER_TEST(TestValueFlow)
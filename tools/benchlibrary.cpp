@@ -0,0 +1,146 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Micro-benchmark for Library queries.
+ *
+ * Loads std.cfg, posix.cfg and windows.cfg and measures how many
+ * queries per second the Library answers, for lookups by name and for
+ * lookups through function call tokens. Half of the queried names are
+ * configured functions, the other half are not. The name lookups are
+ * also measured with a std::map that holds the same keys, for comparison.
+ *
+ * Usage: benchlibrary [iterations]
+ */
+
+#include "library.h"
+#include "token.h"
+#include "tokenlist.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char name[], std::size_t queries, double time, std::size_t hits)
+{
+    std::cout << name << ": " << static_cast<long long>(queries / time) << " queries/s"
+              << " (" << queries << " queries, " << hits << " hits, " << time << " s)" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const int iterations = (argc > 1) ? std::atoi(argv[1]) : 20;
+
+    Library library;
+    const char * const cfgs[] = { "std.cfg", "posix.cfg", "windows.cfg" };
+    for (std::size_t i = 0; i < sizeof(cfgs) / sizeof(cfgs[0]); ++i) {
+        if (library.load(argv[0], cfgs[i]).errorcode != Library::OK &&
+            library.load(argv[0], (std::string("cfg/") + cfgs[i]).c_str()).errorcode != Library::OK) {
+            std::cerr << "Failed to load " << cfgs[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<std::string> names;
+    std::map<std::string, bool> mapFunctions;
+    for (StringHashMap<Library::Function>::const_iterator it = library.functions.begin(); it != library.functions.end(); ++it) {
+        if (it->first.find("::") != std::string::npos)
+            continue;
+        names.push_back(it->first);
+        names.push_back(it->first + "_x");
+        mapFunctions[it->first] = it->second.use;
+    }
+    std::cout << library.functions.size() << " functions, " << names.size() << " names" << std::endl;
+
+    // lookups by name
+    std::size_t hits = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (std::size_t n = 0; n < names.size(); ++n) {
+            if (library.functions.find(names[n]) != library.functions.end())
+                ++hits;
+        }
+    }
+    report("functions.find", names.size() * iterations, seconds(start), hits);
+
+    hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (std::size_t n = 0; n < names.size(); ++n) {
+            if (mapFunctions.find(names[n]) != mapFunctions.end())
+                ++hits;
+        }
+    }
+    report("std::map find (baseline)", names.size() * iterations, seconds(start), hits);
+
+    hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (std::size_t n = 0; n < names.size(); ++n) {
+            const char *name = names[n].c_str();
+            if (library.allocId(name) || library.deallocId(name))
+                ++hits;
+            if (library.podtype(names[n]))
+                ++hits;
+        }
+    }
+    report("alloc/dealloc/podtype", 3 * names.size() * iterations, seconds(start), hits);
+
+    // lookups through function call tokens
+    std::ostringstream code;
+    for (std::size_t n = 0; n < names.size(); ++n)
+        code << names[n] << "(x);\n";
+    TokenList tokenList(nullptr);
+    std::istringstream istr(code.str());
+    tokenList.createTokens(istr, "test.cpp");
+    std::vector<const Token *> calls;
+    for (Token *tok = tokenList.front(); tok; tok = tok->next()) {
+        if (tok->isName() && tok->next() && tok->next()->str() == "(") {
+            tok->next()->astOperand1(tok);
+            calls.push_back(tok);
+        }
+    }
+
+    hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (std::size_t n = 0; n < calls.size(); ++n) {
+            const Token *ftok = calls[n];
+            if (library.isnoreturn(ftok))
+                ++hits;
+            if (library.getWarnInfo(ftok))
+                ++hits;
+            if (!library.returnValue(ftok).empty())
+                ++hits;
+            if (library.isUseRetVal(ftok))
+                ++hits;
+        }
+    }
+    report("call token queries", 4 * calls.size() * iterations, seconds(start), hits);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Micro-benchmark for the SymbolDatabase.
+ *
+ * Tokenizes a preprocessed source file, or a generated translation unit
+ * with many classes, members and functions, and measures how long it
+ * takes to create the SymbolDatabase and how many scopes, functions and
+ * variables per second a check can iterate over.
+ *
+ * Usage: benchsymboldatabase [iterations [file]]
+ */
+
+#include "errorlogger.h"
+#include "settings.h"
+#include "symboldatabase.h"
+#include "tokenize.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+class NullErrorLogger : public ErrorLogger {
+public:
+    void reportOut(const std::string &) override {}
+    void reportErr(const ErrorLogger::ErrorMessage &) override {}
+};
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::string generateCode()
+{
+    std::ostringstream code;
+    for (int c = 0; c < 400; ++c) {
+        code << "class C" << c << " {\n"
+             << "public:\n";
+        for (int m = 0; m < 20; ++m)
+            code << "    int f" << m << "(int a, const char *b, C" << c << " *p) const;\n";
+        code << "private:\n";
+        for (int m = 0; m < 20; ++m)
+            code << "    int m" << m << ";\n";
+        code << "};\n";
+        for (int m = 0; m < 20; ++m) {
+            code << "int C" << c << "::f" << m << "(int a, const char *b, C" << c << " *p) const {\n"
+                 << "    int x = a + m" << m << ";\n"
+                 << "    if (b && p) {\n"
+                 << "        int y = x * 2;\n"
+                 << "        for (int i = 0; i < y; ++i)\n"
+                 << "            x += p->m" << (19 - m) << ";\n"
+                 << "    }\n"
+                 << "    return x;\n"
+                 << "}\n";
+        }
+    }
+    return code.str();
+}
+
+int main(int argc, char *argv[])
+{
+    const int iterations = (argc > 1) ? std::atoi(argv[1]) : 5;
+
+    std::string code;
+    std::string filename = "bench.cpp";
+    if (argc > 2) {
+        filename = argv[2];
+        std::ifstream fin(filename);
+        if (!fin.is_open()) {
+            std::cerr << "Failed to open " << filename << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::ostringstream ostr;
+        ostr << fin.rdbuf();
+        code = ostr.str();
+    } else
+        code = generateCode();
+
+    Settings settings;
+    NullErrorLogger errorLogger;
+    Tokenizer tokenizer(&settings, &errorLogger);
+    std::istringstream istr(code);
+    try {
+        if (!tokenizer.tokenize(istr, filename.c_str())) {
+            std::cerr << "Failed to tokenize " << filename << std::endl;
+            return EXIT_FAILURE;
+        }
+    } catch (const InternalError &e) {
+        std::cerr << "Failed to tokenize " << filename << ": " << e.errorMessage << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // creation
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        tokenizer.deleteSymbolDatabase();
+        tokenizer.createSymbolDatabase();
+    }
+    const double createTime = seconds(start);
+    const SymbolDatabase *symbolDatabase = tokenizer.getSymbolDatabase();
+
+    std::size_t scopes = 0, functions = 0, variables = 0;
+    for (const Scope &scope : symbolDatabase->scopeList) {
+        ++scopes;
+        functions += scope.functionList.size();
+        variables += scope.varlist.size();
+        for (const Function &function : scope.functionList)
+            variables += function.argumentList.size();
+    }
+    std::cout << scopes << " scopes, " << functions << " functions, "
+              << variables << " variables" << std::endl;
+    std::cout << "create: " << (createTime / iterations) << " s" << std::endl;
+
+    // iteration, like the checks do it
+    const int loops = 100 * iterations;
+    std::size_t hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loops; ++i) {
+        for (const Scope &scope : symbolDatabase->scopeList) {
+            for (const Variable &var : scope.varlist) {
+                if (var.isPointer() || var.isArgument())
+                    ++hits;
+            }
+            for (const Function &function : scope.functionList) {
+                if (function.isConst())
+                    ++hits;
+                for (const Variable &arg : function.argumentList) {
+                    if (arg.isConst())
+                        ++hits;
+                }
+            }
+        }
+    }
+    const double iterateTime = seconds(start);
+    std::cout << "iterate: " << static_cast<long long>(loops * (scopes + functions + variables) / iterateTime) << " entities/s"
+              << " (" << hits << " hits, " << iterateTime << " s)" << std::endl;
+
+    return EXIT_SUCCESS;
+}
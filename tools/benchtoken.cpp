@@ -0,0 +1,184 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2018 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Micro-benchmark for walking and matching tokens.
+ *
+ * Tokenizes a preprocessed source file, or a generated translation unit
+ * with many functions, and measures how many tokens per second can be
+ * walked with next()/previous() and matched with Token::Match() and
+ * Token::simpleMatch(), like the checks do it.
+ *
+ * Usage: benchtoken [iterations [file]]
+ */
+
+#include "errorlogger.h"
+#include "settings.h"
+#include "token.h"
+#include "tokenize.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+class NullErrorLogger : public ErrorLogger {
+public:
+    void reportOut(const std::string &) override {}
+    void reportErr(const ErrorLogger::ErrorMessage &) override {}
+};
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::string generateCode()
+{
+    std::ostringstream code;
+    for (int f = 0; f < 4000; ++f) {
+        code << "struct S" << f << " { int a; char *p; };\n"
+             << "int f" << f << "(struct S" << f << " *s, int n) {\n"
+             << "    int x = 0;\n"
+             << "    unsigned int y = 12;\n"
+             << "    for (int i = 0; i < n; ++i) {\n"
+             << "        if (s->p && s->p[i] == 'a')\n"
+             << "            x += s->a * " << f << ";\n"
+             << "        else\n"
+             << "            y = y - 1;\n"
+             << "    }\n"
+             << "    while (x > 100)\n"
+             << "        x = x / 2;\n"
+             << "    return x + y;\n"
+             << "}\n";
+    }
+    return code.str();
+}
+
+static double report(const char name[], std::size_t tokens, int loops, double time, std::size_t hits)
+{
+    std::cout << name << ": " << static_cast<long long>(loops * tokens / time) << " tokens/s"
+              << " (" << hits << " hits, " << time << " s)" << std::endl;
+    return time;
+}
+
+int main(int argc, char *argv[])
+{
+    const int iterations = (argc > 1) ? std::atoi(argv[1]) : 5;
+
+    std::string code;
+    std::string filename = "bench.cpp";
+    if (argc > 2) {
+        filename = argv[2];
+        std::ifstream fin(filename);
+        if (!fin.is_open()) {
+            std::cerr << "Failed to open " << filename << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::ostringstream ostr;
+        ostr << fin.rdbuf();
+        code = ostr.str();
+    } else
+        code = generateCode();
+
+    Settings settings;
+    NullErrorLogger errorLogger;
+    Tokenizer tokenizer(&settings, &errorLogger);
+    std::istringstream istr(code);
+    try {
+        if (!tokenizer.tokenize(istr, filename.c_str())) {
+            std::cerr << "Failed to tokenize " << filename << std::endl;
+            return EXIT_FAILURE;
+        }
+    } catch (const InternalError &e) {
+        std::cerr << "Failed to tokenize " << filename << ": " << e.errorMessage << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::size_t tokens = 0;
+    for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next())
+        ++tokens;
+    std::cout << tokens << " tokens, sizeof(Token) " << sizeof(Token) << std::endl;
+
+    const int loops = 20 * iterations;
+    double total = 0.0;
+
+    // walk forward and backward, reading what Token::Match() reads
+    std::size_t hits = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loops; ++i) {
+        for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
+            if (tok->varId() || tok->isName())
+                ++hits;
+        }
+        for (const Token *tok = tokenizer.list.back(); tok; tok = tok->previous()) {
+            if (tok->str()[0] == '{' && tok->link())
+                ++hits;
+        }
+    }
+    total += report("walk", 2 * tokens, loops, seconds(start), hits);
+
+    // multi compare patterns
+    hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loops; ++i) {
+        for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
+            if (Token::Match(tok, "%var% =|+= %num%|%var% ;"))
+                ++hits;
+            if (Token::Match(tok, "if|while|for ( !!)"))
+                ++hits;
+            if (Token::Match(tok, "%name% . %name% [|("))
+                ++hits;
+            if (Token::Match(tok, "[;{}] %type% *| %var% [;=]"))
+                ++hits;
+        }
+    }
+    total += report("Match", tokens, loops, seconds(start), hits);
+
+    // simple patterns
+    hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loops; ++i) {
+        for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
+            if (Token::simpleMatch(tok, "return x"))
+                ++hits;
+            if (Token::simpleMatch(tok, ") {"))
+                ++hits;
+            if (Token::simpleMatch(tok, "else y ="))
+                ++hits;
+        }
+    }
+    total += report("simpleMatch", tokens, loops, seconds(start), hits);
+
+    // find the end of each scope, like the checks do it
+    hits = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < loops; ++i) {
+        for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
+            if (tok->str() == "{" && Token::findsimplematch(tok, "return", tok->link()))
+                ++hits;
+        }
+    }
+    total += report("findsimplematch", tokens, loops, seconds(start), hits);
+
+    std::cout << "total: " << total << " s" << std::endl;
+
+    return EXIT_SUCCESS;
+}